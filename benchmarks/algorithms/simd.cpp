@@ -0,0 +1,73 @@
+#include <suites.hpp>
+
+#include <libcaramel/algorithms/simd.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace caramel::bench
+{
+   namespace
+   {
+      constexpr i64_t element_count = 4096;
+
+      /**
+       * The needle is only present in the last element, so every search scans the whole range.
+       */
+      template <typename Any>
+      auto make_haystack() -> std::vector<Any>
+      {
+         std::vector<Any> values(static_cast<std::size_t>(element_count), Any{1});
+         values.back() = Any{2};
+
+         return values;
+      }
+
+      template <typename Any>
+      void register_element(suite& benchmarks, const std::string& type_name)
+      {
+         benchmarks.add("simd::find<" + type_name + ">", element_count, [](state& current) {
+            const auto values = make_haystack<Any>();
+            current.measure([&] { do_not_optimize(simd::find(values, Any{2})); });
+         });
+         benchmarks.add("std::find<" + type_name + ">", element_count, [](state& current) {
+            const auto values = make_haystack<Any>();
+            current.measure(
+               [&] { do_not_optimize(std::find(values.begin(), values.end(), Any{2})); });
+         });
+
+         benchmarks.add("simd::count<" + type_name + ">", element_count, [](state& current) {
+            const auto values = make_haystack<Any>();
+            current.measure([&] { do_not_optimize(simd::count(values, Any{1})); });
+         });
+         benchmarks.add("std::count<" + type_name + ">", element_count, [](state& current) {
+            const auto values = make_haystack<Any>();
+            current.measure(
+               [&] { do_not_optimize(std::count(values.begin(), values.end(), Any{1})); });
+         });
+
+         benchmarks.add("simd::compare<" + type_name + ">", element_count, [](state& current) {
+            const auto lhs = make_haystack<Any>();
+            const auto rhs = make_haystack<Any>();
+            current.measure([&] { do_not_optimize(simd::compare(lhs, rhs)); });
+         });
+         benchmarks.add("std::lexicographical_compare_three_way<" + type_name + ">", element_count,
+                        [](state& current) {
+                           const auto lhs = make_haystack<Any>();
+                           const auto rhs = make_haystack<Any>();
+                           current.measure([&] {
+                              do_not_optimize(std::lexicographical_compare_three_way(
+                                 lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+                           });
+                        });
+      }
+   } // namespace
+
+   void register_simd_benchmarks(suite& benchmarks)
+   {
+      register_element<std::uint8_t>(benchmarks, "u8");
+      register_element<i32_t>(benchmarks, "i32");
+      register_element<i64_t>(benchmarks, "i64");
+   }
+} // namespace caramel::bench
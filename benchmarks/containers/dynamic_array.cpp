@@ -0,0 +1,425 @@
+#include <suites.hpp>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/inline_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/static_allocator.hpp>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace caramel::bench
+{
+   namespace
+   {
+      constexpr i64_t append_count = 1024;
+      constexpr i64_t insert_count = 256;
+      constexpr i64_t small_count = 8;
+      constexpr i64_t nested_count = 1024;
+      constexpr i64_t nested_size = 16;
+      constexpr i64_t scratch_size = 64;
+
+      struct payload_64
+      {
+         std::array<u64_t, 8> words; // NOLINT
+      };
+
+      template <typename Any>
+      auto make_values(i64_t count) -> std::vector<Any>
+      {
+         std::vector<Any> values;
+         values.reserve(static_cast<std::size_t>(count));
+
+         for (i64_t i = 0; i < count; ++i)
+         {
+            if constexpr (std::is_same_v<Any, resource_string>)
+            {
+               values.emplace_back(32, static_cast<char>('a' + i % 26)); // NOLINT
+            }
+            else if constexpr (std::is_same_v<Any, payload_64>)
+            {
+               values.push_back(payload_64{{static_cast<u64_t>(i)}});
+            }
+            else
+            {
+               values.push_back(static_cast<Any>(i));
+            }
+         }
+
+         return values;
+      }
+
+      template <typename Container>
+      auto make_container(state& current) -> Container
+      {
+         return Container{typename Container::allocator_type{&current.resource()}};
+      }
+
+      template <typename Container, typename Any>
+      void append(Container& container, const Any& value)
+      {
+         if constexpr (requires { container.append(value); })
+         {
+            container.append(value);
+         }
+         else
+         {
+            container.push_back(value);
+         }
+      }
+
+      template <typename Container, typename Range>
+      void append_range(Container& container, const Range& values)
+      {
+         if constexpr (requires { container.append_range(values); })
+         {
+            container.append_range(values);
+         }
+         else
+         {
+            container.insert(container.end(), std::begin(values), std::end(values));
+         }
+      }
+
+      template <typename Container>
+      void erase_unordered(Container& container, typename Container::iterator pos)
+      {
+         if constexpr (requires { container.erase_unordered(pos); })
+         {
+            container.erase_unordered(pos);
+         }
+         else
+         {
+            *pos = std::move(container.back());
+            container.pop_back();
+         }
+      }
+
+      template <typename Container, typename Predicate>
+      void erase_if(Container& container, Predicate predicate)
+      {
+         if constexpr (requires { container.erase_if(predicate); })
+         {
+            container.erase_if(predicate);
+         }
+         else
+         {
+            std::erase_if(container, predicate);
+         }
+      }
+
+      template <typename Container, typename Any>
+      auto make_filled(state& current, const std::vector<Any>& values) -> Container
+      {
+         auto container = make_container<Container>(current);
+         container.reserve(static_cast<typename Container::size_type>(values.size()));
+         for (const auto& value : values)
+         {
+            append(container, value);
+         }
+
+         return container;
+      }
+
+      template <typename Container>
+      void register_operations(suite& benchmarks, const std::string& name)
+      {
+         using value_type = typename Container::value_type;
+
+         benchmarks.add(name + "/append", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+            auto container = make_container<Container>(current);
+            container.reserve(append_count);
+
+            current.measure([&] {
+               for (const auto& value : values)
+               {
+                  append(container, value);
+               }
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/grow", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+            auto container = make_container<Container>(current);
+
+            current.measure([&] {
+               for (const auto& value : values)
+               {
+                  append(container, value);
+               }
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/insert_front", insert_count, [](state& current) {
+            const auto values = make_values<value_type>(insert_count);
+            auto container = make_container<Container>(current);
+            container.reserve(insert_count);
+
+            current.measure([&] {
+               for (const auto& value : values)
+               {
+                  container.insert(container.begin(), value);
+               }
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/erase_front", insert_count, [](state& current) {
+            auto container = make_filled<Container>(current, make_values<value_type>(insert_count));
+
+            current.measure([&] {
+               while (!container.empty())
+               {
+                  container.erase(container.begin());
+               }
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/erase_unordered_front", insert_count, [](state& current) {
+            auto container = make_filled<Container>(current, make_values<value_type>(insert_count));
+
+            current.measure([&] {
+               while (!container.empty())
+               {
+                  erase_unordered(container, container.begin());
+               }
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/erase_if", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+            auto container = make_container<Container>(current);
+
+            i64_t index = 0;
+            current.measure([&] {
+               container.clear();
+               append_range(container, values);
+               erase_if(container, [&](const value_type&) { return index++ % 2 == 0; });
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/copy", append_count, [](state& current) {
+            const auto original =
+               make_filled<Container>(current, make_values<value_type>(append_count));
+
+            current.measure([&] {
+               Container copy{original};
+               do_not_optimize(copy);
+            });
+         });
+
+         benchmarks.add(name + "/copy_assign", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+            const auto original = make_filled<Container>(current, values);
+            auto copy = make_filled<Container>(current, values);
+
+            current.measure([&] {
+               copy = original;
+            });
+            do_not_optimize(copy);
+         });
+
+         benchmarks.add(name + "/swap_small", small_count, [](state& current) {
+            const auto values = make_values<value_type>(small_count);
+            auto lhs = make_filled<Container>(current, values);
+            auto rhs = make_filled<Container>(current, values);
+            rhs.pop_back();
+
+            current.measure([&] {
+               using std::swap;
+               swap(lhs, rhs);
+            });
+            do_not_optimize(lhs);
+            do_not_optimize(rhs);
+         });
+
+         benchmarks.add(name + "/insert_range", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+            auto container = make_container<Container>(current);
+            container.reserve(append_count);
+
+            current.measure([&] {
+               container.clear();
+               container.insert(container.end(), values.begin(), values.end());
+            });
+            do_not_optimize(container);
+         });
+
+         benchmarks.add(name + "/append_each", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+
+            current.measure([&] {
+               auto container = make_container<Container>(current);
+               for (const auto& value : values)
+               {
+                  append(container, value);
+               }
+               do_not_optimize(container);
+            });
+         });
+
+         benchmarks.add(name + "/append_range", append_count, [](state& current) {
+            const auto values = make_values<value_type>(append_count);
+
+            current.measure([&] {
+               auto container = make_container<Container>(current);
+               append_range(container, values);
+               do_not_optimize(container);
+            });
+         });
+
+         benchmarks.add(name + "/move", append_count, [](state& current) {
+            auto original = make_filled<Container>(current, make_values<value_type>(append_count));
+            std::optional<Container> moved;
+
+            current.measure([&] { moved.emplace(std::move(original)); });
+            do_not_optimize(moved);
+         });
+      }
+
+      template <typename Any>
+      void register_element(suite& benchmarks, const std::string& type_name)
+      {
+         register_operations<basic_dynamic_array<Any, 0>>(benchmarks,
+                                                          "basic_dynamic_array<" + type_name +
+                                                             ", 0>");
+         register_operations<basic_dynamic_array<Any, 16>>(benchmarks,
+                                                           "basic_dynamic_array<" + type_name +
+                                                              ", 16>");
+         register_operations<std::vector<Any, resource_allocator<Any>>>(
+            benchmarks, "std::vector<" + type_name + ">");
+      }
+
+      /**
+       * Tear down nested arrays allocated from an arena, either by destroying them or by winking
+       * them out. The arena itself is released outside of the measure.
+       */
+      template <bool WinkOut>
+      void teardown_nested(state& current)
+      {
+         using inner = dynamic_array<i32_t>;
+
+         monotonic_resource arena{&current.resource()};
+         std::optional<dynamic_array<inner>> outer{std::in_place,
+                                                   memory_allocator<inner>{&arena}};
+         for (i64_t i = 0; i < nested_count; ++i)
+         {
+            outer->append(in_place, nested_size, static_cast<i32_t>(i));
+         }
+
+         current.measure([&] {
+            if constexpr (WinkOut)
+            {
+               outer->wink_out();
+            }
+
+            outer.reset();
+         });
+      }
+
+      /**
+       * Binds static allocators to the arena of the running benchmark.
+       */
+      struct arena_binding
+      {
+         static auto resource() noexcept -> monotonic_resource& { return *p_arena; }
+
+         static inline monotonic_resource* p_arena = nullptr; // NOLINT
+      };
+
+      /**
+       * Append to an array in an arena, reaching it through a memory_allocator or binding it
+       * statically.
+       */
+      template <bool Static>
+      void append_to_arena(state& current)
+      {
+         using allocator = std::conditional_t<Static, static_allocator<i32_t, arena_binding>,
+                                              memory_allocator<i32_t>>;
+
+         monotonic_resource arena{&current.resource()};
+         arena_binding::p_arena = &arena;
+
+         std::optional<basic_dynamic_array<i32_t, 0, allocator>> values;
+         if constexpr (Static)
+         {
+            values.emplace();
+         }
+         else
+         {
+            values.emplace(allocator{&arena});
+         }
+
+         current.measure([&] {
+            for (i64_t i = 0; i < append_count; ++i)
+            {
+               values->append(static_cast<i32_t>(i));
+            }
+         });
+         do_not_optimize(*values);
+      }
+
+      /**
+       * Build three temporary arrays and combine them, as a function would with scratch space,
+       * drawing them either from the heap or from one inline_resource on the stack.
+       */
+      template <bool Inline>
+      void scratch_arrays(state& current)
+      {
+         i64_t total = 0;
+
+         current.measure([&] {
+            inline_resource<4096> scratch{&current.resource()};
+            memory_resource* p_resource = &current.resource();
+            if constexpr (Inline)
+            {
+               p_resource = &scratch;
+            }
+
+            dynamic_array<i32_t> first{memory_allocator<i32_t>{p_resource}};
+            dynamic_array<i32_t> second{memory_allocator<i32_t>{p_resource}};
+            dynamic_array<i32_t> third{memory_allocator<i32_t>{p_resource}};
+            for (i64_t i = 0; i < scratch_size; ++i)
+            {
+               first.append(static_cast<i32_t>(i));
+               second.append(static_cast<i32_t>(i * 2));
+               third.append(static_cast<i32_t>(i * 3));
+            }
+
+            for (i64_t i = 0; i < scratch_size; ++i)
+            {
+               total += first.lookup(i) + second.lookup(i) + third.lookup(i);
+            }
+         });
+         do_not_optimize(total);
+      }
+   } // namespace
+
+   void register_dynamic_array_benchmarks(suite& benchmarks)
+   {
+      register_element<i32_t>(benchmarks, "i32");
+      register_element<payload_64>(benchmarks, "payload_64");
+      register_element<resource_string>(benchmarks, "string");
+
+      benchmarks.add("dynamic_array<dynamic_array<i32>>/destroy", nested_count,
+                     teardown_nested<false>);
+      benchmarks.add("dynamic_array<dynamic_array<i32>>/wink_out", nested_count,
+                     teardown_nested<true>);
+
+      benchmarks.add("basic_dynamic_array<i32, 0>/arena_append", append_count,
+                     append_to_arena<false>);
+      benchmarks.add("basic_dynamic_array<i32, 0>/arena_append_static", append_count,
+                     append_to_arena<true>);
+
+      benchmarks.add("dynamic_array<i32>/scratch_heap", scratch_size * 3, scratch_arrays<false>);
+      benchmarks.add("dynamic_array<i32>/scratch_inline", scratch_size * 3, scratch_arrays<true>);
+   }
+} // namespace caramel::bench
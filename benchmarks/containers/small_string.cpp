@@ -0,0 +1,106 @@
+#include <suites.hpp>
+
+#include <libcaramel/containers/small_string.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace caramel::bench
+{
+   namespace
+   {
+      constexpr i64_t string_count = 256;
+
+      template <typename String>
+      auto make_string(state& current, std::string_view str) -> String
+      {
+         return String{str, typename String::allocator_type{&current.resource()}};
+      }
+
+      template <typename String>
+      void register_length(suite& benchmarks, const std::string& name, std::string_view source)
+      {
+         const std::string prefix = name + "/" + std::to_string(source.size()) + "B";
+
+         benchmarks.add(prefix + "/construct", string_count, [source](state& current) {
+            std::vector<String> strings;
+            strings.reserve(string_count);
+
+            current.measure([&] {
+               for (i64_t i = 0; i < string_count; ++i)
+               {
+                  strings.push_back(make_string<String>(current, source));
+               }
+            });
+            do_not_optimize(strings);
+         });
+
+         benchmarks.add(prefix + "/append", string_count, [source](state& current) {
+            std::vector<String> strings;
+            strings.reserve(string_count);
+            for (i64_t i = 0; i < string_count; ++i)
+            {
+               strings.push_back(make_string<String>(current, ""));
+            }
+
+            current.measure([&] {
+               for (String& str : strings)
+               {
+                  for (const char c : source)
+                  {
+                     str += c;
+                  }
+               }
+            });
+            do_not_optimize(strings);
+         });
+
+         benchmarks.add(prefix + "/copy", string_count, [source](state& current) {
+            const String original = make_string<String>(current, source);
+            std::vector<String> copies;
+            copies.reserve(string_count);
+
+            current.measure([&] {
+               for (i64_t i = 0; i < string_count; ++i)
+               {
+                  copies.push_back(original);
+               }
+            });
+            do_not_optimize(copies);
+         });
+
+         benchmarks.add(prefix + "/compare", string_count, [source](state& current) {
+            const String lhs = make_string<String>(current, source);
+            const String rhs = make_string<String>(current, source);
+            i64_t equal = 0;
+
+            current.measure([&] {
+               for (i64_t i = 0; i < string_count; ++i)
+               {
+                  do_not_optimize(lhs);
+                  equal += static_cast<i64_t>(lhs == rhs);
+               }
+            });
+            do_not_optimize(equal);
+         });
+      }
+   } // namespace
+
+   void register_small_string_benchmarks(suite& benchmarks)
+   {
+      static constexpr std::string_view source =
+         "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_";
+      static constexpr std::array lengths{8, 16, 24, 32, 48, 64};
+
+      for (const auto length : lengths)
+      {
+         const auto str = source.substr(0, static_cast<std::size_t>(length));
+
+         register_length<small_string<23>>(benchmarks, "small_string<23>", str);
+         register_length<small_string<64>>(benchmarks, "small_string<64>", str);
+         register_length<resource_string>(benchmarks, "std::string", str);
+      }
+   }
+} // namespace caramel::bench
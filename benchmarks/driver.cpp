@@ -0,0 +1,107 @@
+#include <suites.hpp>
+
+#include <libcaramel/util/cpu_dispatch.hpp>
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string_view>
+
+namespace
+{
+   void print_usage(std::ostream& os)
+   {
+      os << "usage: driver [--filter <substring>] [--warmup <count>] [--repetitions <count>]\n"
+            "              [--isa scalar|sse2|sse4.2|avx2] [--json <path>|-]\n";
+   }
+
+   auto parse_count(std::string_view str, caramel::i64_t& value) -> bool
+   {
+      const auto [ptr, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+      return error == std::errc{} && ptr == str.data() + str.size() && value >= 0;
+   }
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+   using namespace caramel;
+
+   bench::options opts;
+   std::string json_path;
+
+   const std::span args{argv + 1, static_cast<std::size_t>(argc - 1)}; // NOLINT
+   for (std::size_t i = 0; i < args.size(); ++i)
+   {
+      const std::string_view arg = args[i];
+      if (arg == "--help" || arg == "-h")
+      {
+         print_usage(std::cout);
+         return 0;
+      }
+
+      if (i + 1 == args.size())
+      {
+         print_usage(std::cerr);
+         return 1;
+      }
+
+      const std::string_view value = args[++i];
+      if (arg == "--filter")
+      {
+         opts.filter = value;
+      }
+      else if (arg == "--json")
+      {
+         json_path = value;
+      }
+      else if (const auto level = parse_isa_level(value); arg == "--isa" && level)
+      {
+         force_isa_level(*level);
+      }
+      else if (arg == "--warmup" && parse_count(value, opts.warmup))
+      {
+         continue;
+      }
+      else if (arg == "--repetitions" && parse_count(value, opts.repetitions) &&
+               opts.repetitions > 0)
+      {
+         continue;
+      }
+      else
+      {
+         print_usage(std::cerr);
+         return 1;
+      }
+   }
+
+   bench::suite benchmarks;
+   bench::register_dynamic_array_benchmarks(benchmarks);
+   bench::register_small_string_benchmarks(benchmarks);
+   bench::register_memory_resource_benchmarks(benchmarks);
+   bench::register_simd_benchmarks(benchmarks);
+
+   const auto results = benchmarks.run(opts);
+
+   if (json_path == "-")
+   {
+      bench::write_json(std::cout, results, opts);
+      return 0;
+   }
+
+   bench::write_table(std::cout, results);
+   if (!json_path.empty())
+   {
+      std::ofstream file{json_path};
+      if (!file)
+      {
+         std::cerr << "unable to open " << json_path << '\n';
+         return 1;
+      }
+
+      bench::write_json(file, results, opts);
+   }
+
+   return 0;
+}
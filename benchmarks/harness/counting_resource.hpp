@@ -0,0 +1,154 @@
+/**
+ * @file harness/counting_resource.hpp
+ * @brief Contains the counting_resource and resource_allocator used to measure allocations.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/pointers>
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+namespace caramel::bench
+{
+   /**
+    * @brief memory_resource forwarding to an upstream resource while counting every call.
+    */
+   class counting_resource : public memory_resource
+   {
+   public:
+      counting_resource() noexcept : mp_upstream{get_default_memory_resource()} {}
+      counting_resource(gsl::not_null<memory_resource*> p_upstream) noexcept :
+         mp_upstream{p_upstream.get()}
+      {}
+
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override
+      {
+         ++m_allocations;
+         m_bytes += bytes.value();
+
+         return mp_upstream->allocate(bytes, alignment);
+      }
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override
+      {
+         ++m_deallocations;
+
+         mp_upstream->deallocate(ptr, bytes, alignment);
+      }
+      auto is_equal(const memory_resource& other) const noexcept -> bool override
+      {
+         return this == &other;
+      }
+
+      [[nodiscard]] auto allocations() const noexcept -> i64_t { return m_allocations; }
+      [[nodiscard]] auto deallocations() const noexcept -> i64_t { return m_deallocations; }
+      [[nodiscard]] auto bytes_allocated() const noexcept -> i64_t { return m_bytes; }
+
+   private:
+      memory_resource* mp_upstream;
+
+      i64_t m_allocations{0};
+      i64_t m_deallocations{0};
+      i64_t m_bytes{0};
+   };
+
+   /**
+    * @brief Standard allocator drawing from a caramel::memory_resource, used so that the
+    * comparable std containers are measured through the same counting_resource.
+    */
+   template <typename Any>
+   class resource_allocator
+   {
+   public:
+      using value_type = Any;
+
+   public:
+      resource_allocator() noexcept : mp_resource{get_default_memory_resource()} {}
+      resource_allocator(memory_resource* p_resource) noexcept : mp_resource{p_resource} {}
+      template <typename Other>
+      resource_allocator(const resource_allocator<Other>& other) noexcept :
+         mp_resource{other.resource()}
+      {}
+
+      auto allocate(std::size_t count) -> Any*
+      {
+         void* ptr = mp_resource->allocate(count_t{static_cast<i64_t>(count * sizeof(Any))},
+                                           align_t{alignof(Any)});
+         if (!ptr)
+         {
+            throw std::bad_alloc{};
+         }
+
+         return static_cast<Any*>(ptr);
+      }
+      void deallocate(Any* ptr, std::size_t count) noexcept
+      {
+         mp_resource->deallocate(gsl::make_not_null(static_cast<void*>(ptr)),
+                                 count_t{static_cast<i64_t>(count * sizeof(Any))},
+                                 align_t{alignof(Any)});
+      }
+
+      [[nodiscard]] auto resource() const noexcept -> memory_resource* { return mp_resource; }
+
+      template <typename Other>
+      auto operator==(const resource_allocator<Other>& other) const noexcept -> bool
+      {
+         return *mp_resource == *other.resource();
+      }
+
+   private:
+      memory_resource* mp_resource;
+   };
+
+   /**
+    * @brief std::string whose allocations go through a caramel::memory_resource.
+    */
+   using resource_string =
+      std::basic_string<char, std::char_traits<char>, resource_allocator<char>>;
+
+   /**
+    * @brief std::pmr::memory_resource forwarding to a caramel::memory_resource, used as the
+    * upstream of the std::pmr resources so they are measured the same way.
+    */
+   class pmr_adaptor : public std::pmr::memory_resource
+   {
+   public:
+      pmr_adaptor(gsl::not_null<caramel::memory_resource*> p_resource) noexcept :
+         mp_resource{p_resource.get()}
+      {}
+
+   private:
+      auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+      {
+         void* ptr = mp_resource->allocate(count_t{static_cast<i64_t>(bytes)},
+                                           align_t{static_cast<i64_t>(alignment)});
+         if (!ptr)
+         {
+            throw std::bad_alloc{};
+         }
+
+         return ptr;
+      }
+      void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+      {
+         mp_resource->deallocate(gsl::make_not_null(ptr), count_t{static_cast<i64_t>(bytes)},
+                                 align_t{static_cast<i64_t>(alignment)});
+      }
+      [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+         -> bool override
+      {
+         return this == &other;
+      }
+
+   private:
+      caramel::memory_resource* mp_resource;
+   };
+} // namespace caramel::bench
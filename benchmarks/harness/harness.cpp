@@ -0,0 +1,289 @@
+#include <harness/harness.hpp>
+
+#include <libcaramel/util/cpu_dispatch.hpp>
+#include <libcaramel/version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+namespace caramel::bench
+{
+   namespace
+   {
+      /**
+       * Nearest rank percentile of sorted samples.
+       */
+      auto percentile(std::span<const double> sorted, double rank) -> double
+      {
+         const auto count = static_cast<double>(sorted.size());
+         const auto index = static_cast<std::size_t>(std::ceil(rank * count)) - 1;
+
+         return sorted[std::min(index, sorted.size() - 1)];
+      }
+
+      auto median(std::span<const double> sorted) -> double
+      {
+         const std::size_t half = sorted.size() / 2;
+         if (sorted.size() % 2 == 0)
+         {
+            return (sorted[half - 1] + sorted[half]) / 2.0;
+         }
+
+         return sorted[half];
+      }
+
+      void write_json_string(std::ostream& os, std::string_view str)
+      {
+         os << '"';
+         for (const char c : str)
+         {
+            switch (c)
+            {
+               case '"':
+                  os << "\\\"";
+                  break;
+               case '\\':
+                  os << "\\\\";
+                  break;
+               case '\n':
+                  os << "\\n";
+                  break;
+               default:
+                  if (static_cast<unsigned char>(c) < 0x20) // NOLINT
+                  {
+                     std::array<char, 8> buffer{}; // NOLINT
+                     std::snprintf(buffer.data(), buffer.size(), "\\u%04x", c);
+                     os << buffer.data();
+                  }
+                  else
+                  {
+                     os << c;
+                  }
+            }
+         }
+         os << '"';
+      }
+
+      void write_json_number(std::ostream& os, std::optional<double> value)
+      {
+         if (value && std::isfinite(*value))
+         {
+            os << *value;
+         }
+         else
+         {
+            os << "null";
+         }
+      }
+
+      void write_optional(std::ostream& os, std::optional<double> value)
+      {
+         os << std::setw(12); // NOLINT
+         if (value)
+         {
+            os << *value;
+         }
+         else
+         {
+            os << "-";
+         }
+      }
+   } // namespace
+
+   auto read_cycle_counter() noexcept -> std::optional<u64_t>
+   {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      return std::nullopt;
+#endif
+   }
+
+   void suite::add(std::string name, i64_t elements, body_type body)
+   {
+      m_entries.push_back(entry{std::move(name), elements, std::move(body)});
+   }
+
+   auto suite::run(const options& opts) const -> std::vector<result>
+   {
+      std::vector<result> results;
+
+      perf_counters counters;
+
+      memory_resource* p_previous_default = get_default_memory_resource();
+      for (const entry& bench : m_entries)
+      {
+         if (bench.name.find(opts.filter) == std::string::npos)
+         {
+            continue;
+         }
+
+         counting_resource resource{gsl::make_not_null(p_previous_default)};
+         set_default_memory_resource(gsl::make_not_null(&resource));
+
+         for (i64_t i = 0; i < opts.warmup; ++i)
+         {
+            state warmup{resource, counters};
+            bench.body(warmup);
+         }
+
+         std::vector<double> nanoseconds;
+         std::vector<double> cycles;
+         i64_t allocations = 0;
+         i64_t bytes = 0;
+         perf_report events;
+         for (i64_t i = 0; i < opts.repetitions; ++i)
+         {
+            state current{resource, counters};
+            bench.body(current);
+
+            nanoseconds.push_back(current.nanoseconds());
+            if (current.cycles())
+            {
+               cycles.push_back(*current.cycles());
+            }
+            allocations += current.allocations();
+            bytes += current.bytes();
+            events.add(current.events(), bench.elements);
+         }
+
+         set_default_memory_resource(gsl::make_not_null(p_previous_default));
+
+         std::sort(nanoseconds.begin(), nanoseconds.end());
+         std::sort(cycles.begin(), cycles.end());
+
+         const auto elements = static_cast<double>(std::max<i64_t>(bench.elements, 1));
+         const auto repetitions = static_cast<double>(std::max<i64_t>(opts.repetitions, 1));
+         const double median_ns = nanoseconds.empty() ? 0.0 : median(nanoseconds);
+
+         std::array<std::optional<double>, perf_event_count> events_per_element{};
+         for (std::size_t i = 0; i < perf_event_count; ++i)
+         {
+            events_per_element[i] = events.per_operation(static_cast<perf_event>(i)); // NOLINT
+         }
+
+         results.push_back(result{
+            .name = bench.name,
+            .elements = bench.elements,
+            .repetitions = opts.repetitions,
+            .min_ns = nanoseconds.empty() ? 0.0 : nanoseconds.front(),
+            .median_ns = median_ns,
+            .p99_ns = nanoseconds.empty() ? 0.0 : percentile(nanoseconds, 0.99), // NOLINT
+            .ns_per_element = median_ns / elements,
+            .cycles_per_element = cycles.empty()
+               ? std::nullopt
+               : std::optional<double>{median(cycles) / elements},
+            .allocations_per_op = static_cast<double>(allocations) / repetitions,
+            .bytes_per_op = static_cast<double>(bytes) / repetitions,
+            .events_per_element = events_per_element});
+      }
+
+      return results;
+   }
+
+   void write_table(std::ostream& os, std::span<const result> results)
+   {
+      std::size_t name_width = 4; // NOLINT
+      for (const result& res : results)
+      {
+         name_width = std::max(name_width, res.name.size());
+      }
+
+      const auto flags = os.flags();
+      os << std::left << std::setw(static_cast<int>(name_width)) << "name" << std::right
+         << std::setw(14) << "median ns" << std::setw(14) << "p99 ns" << std::setw(12) // NOLINT
+         << "ns/elem" << std::setw(12) << "cyc/elem" << std::setw(12) << "allocs/op" // NOLINT
+         << std::setw(12) << "ins/elem" << std::setw(12) << "llc/elem" << std::setw(12) // NOLINT
+         << "brm/elem" << '\n';
+
+      os << std::fixed << std::setprecision(2);
+      for (const result& res : results)
+      {
+         os << std::left << std::setw(static_cast<int>(name_width)) << res.name << std::right
+            << std::setw(14) << res.median_ns << std::setw(14) << res.p99_ns // NOLINT
+            << std::setw(12) << res.ns_per_element;                          // NOLINT
+         write_optional(os, res.cycles_per_element);
+         os << std::setw(12) << res.allocations_per_op; // NOLINT
+
+         for (const auto event :
+              {perf_event::instructions, perf_event::llc_misses, perf_event::branch_misses})
+         {
+            write_optional(os, res.events_per_element[static_cast<std::size_t>(event)]); // NOLINT
+         }
+         os << '\n';
+      }
+      os.flags(flags);
+   }
+
+   void write_json(std::ostream& os, std::span<const result> results, const options& opts)
+   {
+      const auto flags = os.flags();
+      const auto precision = os.precision();
+      os << std::setprecision(6); // NOLINT
+
+      os << "{\n";
+      os << "  \"library\": \"libcaramel\",\n";
+      os << "  \"version\": ";
+      write_json_string(os, LIBCARAMEL_VERSION_STR);
+      os << ",\n";
+#if defined(__VERSION__)
+      os << "  \"compiler\": ";
+      write_json_string(os, __VERSION__);
+      os << ",\n";
+#endif
+      os << "  \"isa\": ";
+      write_json_string(os, to_string(active_isa_level()));
+      os << ",\n";
+      os << "  \"warmup\": " << opts.warmup << ",\n";
+      os << "  \"repetitions\": " << opts.repetitions << ",\n";
+      os << "  \"benchmarks\": [";
+
+      bool first = true;
+      for (const result& res : results)
+      {
+         os << (first ? "\n" : ",\n");
+         first = false;
+
+         os << "    {\"name\": ";
+         write_json_string(os, res.name);
+         os << ", \"elements\": " << res.elements;
+         os << ", \"repetitions\": " << res.repetitions;
+         os << ", \"min_ns\": ";
+         write_json_number(os, res.min_ns);
+         os << ", \"median_ns\": ";
+         write_json_number(os, res.median_ns);
+         os << ", \"p99_ns\": ";
+         write_json_number(os, res.p99_ns);
+         os << ", \"ns_per_element\": ";
+         write_json_number(os, res.ns_per_element);
+         os << ", \"cycles_per_element\": ";
+         write_json_number(os, res.cycles_per_element);
+         os << ", \"allocations_per_op\": ";
+         write_json_number(os, res.allocations_per_op);
+         os << ", \"bytes_per_op\": ";
+         write_json_number(os, res.bytes_per_op);
+         os << ", \"events_per_element\": {";
+         for (std::size_t i = 0; i < perf_event_count; ++i)
+         {
+            os << (i == 0 ? "" : ", ");
+            write_json_string(os, to_string(static_cast<perf_event>(i)));
+            os << ": ";
+            write_json_number(os, res.events_per_element[i]); // NOLINT
+         }
+         os << "}}";
+      }
+
+      os << "\n  ]\n}\n";
+
+      os.precision(precision);
+      os.flags(flags);
+   }
+} // namespace caramel::bench
@@ -0,0 +1,188 @@
+/**
+ * @file harness/harness.hpp
+ * @brief Contains the benchmark harness: registration, measurement and reporting.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <harness/counting_resource.hpp>
+
+#include <libcaramel/util/perf_counters.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace caramel::bench
+{
+   /**
+    * @brief Prevent the compiler from optimizing away the computation of value.
+    */
+   template <typename Any>
+   inline void do_not_optimize(const Any& value)
+   {
+      asm volatile("" : : "r,m"(value) : "memory"); // NOLINT
+   }
+   /**
+    * @brief Prevent the compiler from reordering memory accesses across this point.
+    */
+   inline void clobber_memory()
+   {
+      asm volatile("" : : : "memory"); // NOLINT
+   }
+
+   /**
+    * @brief Read the CPU timestamp counter, if the target has one.
+    */
+   auto read_cycle_counter() noexcept -> std::optional<u64_t>;
+
+   /**
+    * @brief Handle given to a benchmark body for one repetition.
+    *
+    * @details Everything done outside of measure() is setup and is neither timed nor counted.
+    * measure() must be called exactly once per repetition.
+    */
+   class state
+   {
+   public:
+      state(counting_resource& resource, perf_counters& counters) noexcept :
+         m_resource{resource}, m_counters{counters}
+      {}
+
+      /**
+       * @brief Time the execution of body and count the allocations and hardware events it
+       * performs.
+       */
+      template <std::invocable Fun>
+      void measure(Fun&& body)
+      {
+         const i64_t allocations = m_resource.allocations();
+         const i64_t bytes = m_resource.bytes_allocated();
+         const auto start_cycles = read_cycle_counter();
+         const auto start = std::chrono::steady_clock::now();
+         m_counters.start();
+
+         std::invoke(std::forward<Fun>(body));
+         clobber_memory();
+
+         m_events = m_counters.stop();
+         const auto stop = std::chrono::steady_clock::now();
+         const auto stop_cycles = read_cycle_counter();
+
+         m_nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+         if (start_cycles && stop_cycles)
+         {
+            m_cycles = static_cast<double>(*stop_cycles - *start_cycles);
+         }
+         m_allocations = m_resource.allocations() - allocations;
+         m_bytes = m_resource.bytes_allocated() - bytes;
+      }
+
+      /**
+       * @brief The counting resource every allocation of the benchmark should go through. It is
+       * also installed as the default memory_resource while the benchmark runs.
+       */
+      [[nodiscard]] auto resource() noexcept -> counting_resource& { return m_resource; }
+
+      [[nodiscard]] auto nanoseconds() const noexcept -> double { return m_nanoseconds; }
+      [[nodiscard]] auto cycles() const noexcept -> std::optional<double> { return m_cycles; }
+      [[nodiscard]] auto allocations() const noexcept -> i64_t { return m_allocations; }
+      [[nodiscard]] auto bytes() const noexcept -> i64_t { return m_bytes; }
+      [[nodiscard]] auto events() const noexcept -> const perf_counts& { return m_events; }
+
+   private:
+      counting_resource& m_resource;
+      perf_counters& m_counters;
+
+      double m_nanoseconds{0.0};
+      std::optional<double> m_cycles{std::nullopt};
+      i64_t m_allocations{0};
+      i64_t m_bytes{0};
+      perf_counts m_events{};
+   };
+
+   /**
+    * @brief Statistics gathered over every repetition of one benchmark.
+    *
+    * @details An operation is one call to the benchmark body, which processes `elements` elements.
+    */
+   struct result
+   {
+      std::string name;
+      i64_t elements;
+      i64_t repetitions;
+
+      double min_ns;
+      double median_ns;
+      double p99_ns;
+      double ns_per_element;
+      std::optional<double> cycles_per_element;
+
+      double allocations_per_op;
+      double bytes_per_op;
+
+      /**
+       * @brief Average of every hardware event per element, empty for unavailable events.
+       */
+      std::array<std::optional<double>, perf_event_count> events_per_element;
+   };
+
+   struct options
+   {
+      i64_t warmup{3};
+      i64_t repetitions{31};
+      std::string filter;
+   };
+
+   /**
+    * @brief Collection of registered benchmarks.
+    */
+   class suite
+   {
+   public:
+      using body_type = std::function<void(state&)>;
+
+   public:
+      /**
+       * @brief Register a benchmark.
+       *
+       * @param[in] name Unique name, `<container>/<operation>` by convention.
+       * @param[in] elements The number of elements one run of body processes.
+       * @param[in] body The benchmark, calling state::measure exactly once.
+       */
+      void add(std::string name, i64_t elements, body_type body);
+
+      /**
+       * @brief Run every benchmark whose name contains the filter.
+       */
+      [[nodiscard]] auto run(const options& opts) const -> std::vector<result>;
+
+   private:
+      struct entry
+      {
+         std::string name;
+         i64_t elements;
+         body_type body;
+      };
+
+      std::vector<entry> m_entries;
+   };
+
+   /**
+    * @brief Write the results as an aligned, human readable table.
+    */
+   void write_table(std::ostream& os, std::span<const result> results);
+   /**
+    * @brief Write the results as a JSON document suitable for tracking across releases.
+    */
+   void write_json(std::ostream& os, std::span<const result> results, const options& opts);
+} // namespace caramel::bench
@@ -0,0 +1,193 @@
+#include <suites.hpp>
+
+#include <libcaramel/memory/checked_resource.hpp>
+#include <libcaramel/memory/fixed_block_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/numa_resource.hpp>
+
+#include <array>
+#include <memory_resource>
+#include <vector>
+
+namespace caramel::bench
+{
+   namespace
+   {
+      constexpr i64_t block_count = 1024;
+      constexpr i64_t block_size = 64;
+      constexpr i64_t block_alignment = 16;
+
+      /**
+       * Deterministic allocation sizes between 8 and 512 bytes.
+       */
+      auto mixed_size(i64_t i) -> i64_t
+      {
+         static constexpr std::array<i64_t, 8> sizes{8, 24, 64, 16, 512, 32, 128, 256};
+
+         return sizes[static_cast<std::size_t>(i) % sizes.size()];
+      }
+
+      auto allocate(caramel::memory_resource& resource, i64_t bytes, i64_t alignment) -> void*
+      {
+         return resource.allocate(count_t{bytes}, align_t{alignment});
+      }
+      void deallocate(caramel::memory_resource& resource, void* ptr, i64_t bytes, i64_t alignment)
+      {
+         resource.deallocate(gsl::make_not_null(ptr), count_t{bytes}, align_t{alignment});
+      }
+      auto allocate(std::pmr::memory_resource& resource, i64_t bytes, i64_t alignment) -> void*
+      {
+         return resource.allocate(static_cast<std::size_t>(bytes),
+                                  static_cast<std::size_t>(alignment));
+      }
+      void deallocate(std::pmr::memory_resource& resource, void* ptr, i64_t bytes,
+                      i64_t alignment)
+      {
+         resource.deallocate(ptr, static_cast<std::size_t>(bytes),
+                             static_cast<std::size_t>(alignment));
+      }
+
+      /**
+       * The resource under test draws from the counting resource of the state, so the reported
+       * allocations are the requests that reach the system allocator.
+       */
+      struct global_fixture
+      {
+         global_fixture(state& current) : upstream{current.resource()} {}
+
+         auto resource() -> caramel::memory_resource& { return upstream; }
+
+         caramel::memory_resource& upstream;
+      };
+
+      struct monotonic_fixture
+      {
+         monotonic_fixture(state& current) : arena{&current.resource()} {}
+
+         auto resource() -> caramel::memory_resource& { return arena; }
+
+         monotonic_resource arena;
+      };
+
+      /**
+       * Pages come straight from the OS, so no allocations are reported.
+       */
+      struct numa_monotonic_fixture
+      {
+         numa_monotonic_fixture(state& /* current */) : arena{&upstream} {}
+
+         auto resource() -> caramel::memory_resource& { return arena; }
+
+         numa_resource upstream;
+         monotonic_resource arena;
+      };
+
+      /**
+       * Blocks fit the fixed size requests, larger mixed ones go upstream.
+       */
+      struct fixed_block_fixture
+      {
+         fixed_block_fixture(state& current) :
+            pool{count_t{block_size}, align_t{block_alignment}, &current.resource()}
+         {}
+
+         auto resource() -> caramel::memory_resource& { return pool; }
+
+         fixed_block_resource pool;
+      };
+
+      struct checked_fixture
+      {
+         checked_fixture(state& current) : checked{&current.resource()} {}
+
+         auto resource() -> caramel::memory_resource& { return checked; }
+
+         checked_resource checked;
+      };
+
+      struct pmr_monotonic_fixture
+      {
+         pmr_monotonic_fixture(state& current) : upstream{&current.resource()}, arena{&upstream} {}
+
+         auto resource() -> std::pmr::memory_resource& { return arena; }
+
+         pmr_adaptor upstream;
+         std::pmr::monotonic_buffer_resource arena;
+      };
+
+      struct pmr_pool_fixture
+      {
+         pmr_pool_fixture(state& current) : upstream{&current.resource()}, pool{&upstream} {}
+
+         auto resource() -> std::pmr::memory_resource& { return pool; }
+
+         pmr_adaptor upstream;
+         std::pmr::unsynchronized_pool_resource pool;
+      };
+
+      template <typename Fixture>
+      void register_resource(suite& benchmarks, const std::string& name)
+      {
+         benchmarks.add(name + "/fixed_64", block_count, [](state& current) {
+            Fixture fixture{current};
+            std::vector<void*> blocks(static_cast<std::size_t>(block_count));
+
+            current.measure([&] {
+               for (auto& p_block : blocks)
+               {
+                  p_block = allocate(fixture.resource(), block_size, block_alignment);
+               }
+               for (auto it = blocks.rbegin(); it != blocks.rend(); ++it)
+               {
+                  deallocate(fixture.resource(), *it, block_size, block_alignment);
+               }
+            });
+            do_not_optimize(blocks);
+         });
+
+         benchmarks.add(name + "/mixed", block_count, [](state& current) {
+            Fixture fixture{current};
+            std::vector<void*> blocks(static_cast<std::size_t>(block_count));
+
+            current.measure([&] {
+               for (i64_t i = 0; i < block_count; ++i)
+               {
+                  blocks[static_cast<std::size_t>(i)] =
+                     allocate(fixture.resource(), mixed_size(i), block_alignment);
+               }
+               for (i64_t i = 0; i < block_count; ++i)
+               {
+                  deallocate(fixture.resource(), blocks[static_cast<std::size_t>(i)],
+                             mixed_size(i), block_alignment);
+               }
+            });
+            do_not_optimize(blocks);
+         });
+
+         benchmarks.add(name + "/churn", block_count, [](state& current) {
+            Fixture fixture{current};
+
+            current.measure([&] {
+               for (i64_t i = 0; i < block_count; ++i)
+               {
+                  void* p_block = allocate(fixture.resource(), block_size, block_alignment);
+                  do_not_optimize(p_block);
+                  deallocate(fixture.resource(), p_block, block_size, block_alignment);
+               }
+            });
+         });
+      }
+   } // namespace
+
+   void register_memory_resource_benchmarks(suite& benchmarks)
+   {
+      register_resource<global_fixture>(benchmarks, "global_resource");
+      register_resource<monotonic_fixture>(benchmarks, "monotonic_resource");
+      register_resource<numa_monotonic_fixture>(benchmarks,
+                                                "monotonic_resource over numa_resource");
+      register_resource<fixed_block_fixture>(benchmarks, "fixed_block_resource");
+      register_resource<checked_fixture>(benchmarks, "checked_resource");
+      register_resource<pmr_monotonic_fixture>(benchmarks, "std::pmr::monotonic_buffer_resource");
+      register_resource<pmr_pool_fixture>(benchmarks, "std::pmr::unsynchronized_pool_resource");
+   }
+} // namespace caramel::bench
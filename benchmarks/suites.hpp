@@ -0,0 +1,17 @@
+/**
+ * @file suites.hpp
+ * @brief Registration functions of every benchmark suite.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <harness/harness.hpp>
+
+namespace caramel::bench
+{
+   void register_dynamic_array_benchmarks(suite& benchmarks);
+   void register_small_string_benchmarks(suite& benchmarks);
+   void register_memory_resource_benchmarks(suite& benchmarks);
+   void register_simd_benchmarks(suite& benchmarks);
+} // namespace caramel::bench
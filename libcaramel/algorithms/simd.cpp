@@ -0,0 +1,375 @@
+#include <libcaramel/algorithms/simd.hpp>
+#include <libcaramel/util/cpu_dispatch.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <bit>
+
+#if defined(LIBCARAMEL_X86_KERNELS)
+#   include <immintrin.h>
+#endif
+
+namespace caramel::simd::detail
+{
+   namespace
+   {
+      template <typename Word>
+      auto find_scalar(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         for (i64_t i = 0; i < count; ++i)
+         {
+            if (p_words[i] == value) // NOLINT
+            {
+               return i;
+            }
+         }
+
+         return count;
+      }
+
+      template <typename Word>
+      auto count_scalar(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         i64_t total = 0;
+         for (i64_t i = 0; i < count; ++i)
+         {
+            total += static_cast<i64_t>(p_words[i] == value); // NOLINT
+         }
+
+         return total;
+      }
+
+      auto mismatch_scalar(const std::byte* p_lhs, const std::byte* p_rhs, i64_t count) noexcept
+         -> i64_t
+      {
+         for (i64_t i = 0; i < count; ++i)
+         {
+            if (p_lhs[i] != p_rhs[i]) // NOLINT
+            {
+               return i;
+            }
+         }
+
+         return count;
+      }
+
+#if defined(LIBCARAMEL_X86_KERNELS)
+      /**
+       * SSE2 is part of x86-64, so these kernels are the baseline. The loops compare a vector of
+       * words at a time and turn the comparison into a bit per byte with movemask: the position
+       * of the first set bit gives the first match, the number of set bits the match count.
+       */
+      template <typename Word>
+      auto broadcast_sse2(Word value) noexcept -> __m128i
+      {
+         if constexpr (sizeof(Word) == 1)
+         {
+            return _mm_set1_epi8(static_cast<char>(value));
+         }
+         else if constexpr (sizeof(Word) == 2)
+         {
+            return _mm_set1_epi16(static_cast<short>(value));
+         }
+         else if constexpr (sizeof(Word) == 4)
+         {
+            return _mm_set1_epi32(static_cast<int>(value));
+         }
+         else
+         {
+            return _mm_set1_epi64x(static_cast<long long>(value));
+         }
+      }
+
+      template <typename Word>
+      auto equal_mask_sse2(__m128i lhs, __m128i rhs) noexcept -> u32_t
+      {
+         __m128i equal;
+         if constexpr (sizeof(Word) == 1)
+         {
+            equal = _mm_cmpeq_epi8(lhs, rhs);
+         }
+         else if constexpr (sizeof(Word) == 2)
+         {
+            equal = _mm_cmpeq_epi16(lhs, rhs);
+         }
+         else if constexpr (sizeof(Word) == 4)
+         {
+            equal = _mm_cmpeq_epi32(lhs, rhs);
+         }
+         else
+         {
+            // SSE2 has no 64 bit comparison: both halves of a word must be equal.
+            const __m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+            equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+         }
+
+         return static_cast<u32_t>(_mm_movemask_epi8(equal));
+      }
+
+      template <typename Word>
+      auto find_sse2(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         constexpr i64_t lanes = sizeof(__m128i) / sizeof(Word);
+
+         const __m128i needle = broadcast_sse2(value);
+
+         i64_t i = 0;
+         for (; i + lanes <= count; i += lanes)
+         {
+            const __m128i words =
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_words + i)); // NOLINT
+            if (const u32_t mask = equal_mask_sse2<Word>(words, needle); mask != 0)
+            {
+               return i + std::countr_zero(mask) / static_cast<i64_t>(sizeof(Word));
+            }
+         }
+
+         return i + find_scalar(p_words + i, count - i, value); // NOLINT
+      }
+
+      template <typename Word>
+      auto count_sse2(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         constexpr i64_t lanes = sizeof(__m128i) / sizeof(Word);
+
+         const __m128i needle = broadcast_sse2(value);
+
+         i64_t total = 0;
+         i64_t i = 0;
+         for (; i + lanes <= count; i += lanes)
+         {
+            const __m128i words =
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_words + i)); // NOLINT
+            total += std::popcount(equal_mask_sse2<Word>(words, needle));
+         }
+
+         return total / static_cast<i64_t>(sizeof(Word)) +
+            count_scalar(p_words + i, count - i, value); // NOLINT
+      }
+
+      auto mismatch_sse2(const std::byte* p_lhs, const std::byte* p_rhs, i64_t count) noexcept
+         -> i64_t
+      {
+         constexpr u32_t all_equal = 0xffff;
+
+         i64_t i = 0;
+         for (; i + 16 <= count; i += 16)
+         {
+            const __m128i lhs =
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_lhs + i)); // NOLINT
+            const __m128i rhs =
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_rhs + i)); // NOLINT
+            if (const u32_t mask = equal_mask_sse2<std::uint8_t>(lhs, rhs); mask != all_equal)
+            {
+               return i + std::countr_one(mask);
+            }
+         }
+
+         return i + mismatch_scalar(p_lhs + i, p_rhs + i, count - i); // NOLINT
+      }
+
+      template <typename Word>
+      __attribute__((target("avx2"))) auto broadcast_avx2(Word value) noexcept -> __m256i
+      {
+         if constexpr (sizeof(Word) == 1)
+         {
+            return _mm256_set1_epi8(static_cast<char>(value));
+         }
+         else if constexpr (sizeof(Word) == 2)
+         {
+            return _mm256_set1_epi16(static_cast<short>(value));
+         }
+         else if constexpr (sizeof(Word) == 4)
+         {
+            return _mm256_set1_epi32(static_cast<int>(value));
+         }
+         else
+         {
+            return _mm256_set1_epi64x(static_cast<long long>(value));
+         }
+      }
+
+      template <typename Word>
+      __attribute__((target("avx2"))) auto equal_mask_avx2(__m256i lhs, __m256i rhs) noexcept
+         -> u32_t
+      {
+         __m256i equal;
+         if constexpr (sizeof(Word) == 1)
+         {
+            equal = _mm256_cmpeq_epi8(lhs, rhs);
+         }
+         else if constexpr (sizeof(Word) == 2)
+         {
+            equal = _mm256_cmpeq_epi16(lhs, rhs);
+         }
+         else if constexpr (sizeof(Word) == 4)
+         {
+            equal = _mm256_cmpeq_epi32(lhs, rhs);
+         }
+         else
+         {
+            equal = _mm256_cmpeq_epi64(lhs, rhs);
+         }
+
+         return static_cast<u32_t>(_mm256_movemask_epi8(equal));
+      }
+
+      template <typename Word>
+      __attribute__((target("avx2"))) auto find_avx2(const Word* p_words, i64_t count,
+                                                     Word value) noexcept -> i64_t
+      {
+         constexpr i64_t lanes = sizeof(__m256i) / sizeof(Word);
+
+         const __m256i needle = broadcast_avx2(value);
+
+         i64_t i = 0;
+         for (; i + lanes <= count; i += lanes)
+         {
+            const __m256i words =
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_words + i)); // NOLINT
+            if (const u32_t mask = equal_mask_avx2<Word>(words, needle); mask != 0)
+            {
+               return i + std::countr_zero(mask) / static_cast<i64_t>(sizeof(Word));
+            }
+         }
+
+         return i + find_scalar(p_words + i, count - i, value); // NOLINT
+      }
+
+      template <typename Word>
+      __attribute__((target("avx2,popcnt"))) auto count_avx2(const Word* p_words, i64_t count,
+                                                              Word value) noexcept -> i64_t
+      {
+         constexpr i64_t lanes = sizeof(__m256i) / sizeof(Word);
+
+         const __m256i needle = broadcast_avx2(value);
+
+         i64_t total = 0;
+         i64_t i = 0;
+         for (; i + lanes <= count; i += lanes)
+         {
+            const __m256i words =
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_words + i)); // NOLINT
+            total += __builtin_popcount(equal_mask_avx2<Word>(words, needle));
+         }
+
+         return total / static_cast<i64_t>(sizeof(Word)) +
+            count_scalar(p_words + i, count - i, value); // NOLINT
+      }
+
+      __attribute__((target("avx2"))) auto mismatch_avx2(const std::byte* p_lhs,
+                                                         const std::byte* p_rhs,
+                                                         i64_t count) noexcept -> i64_t
+      {
+         constexpr u32_t all_equal = 0xffffffff;
+
+         i64_t i = 0;
+         for (; i + 32 <= count; i += 32)
+         {
+            const __m256i lhs =
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_lhs + i)); // NOLINT
+            const __m256i rhs =
+               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_rhs + i)); // NOLINT
+            if (const u32_t mask = equal_mask_avx2<std::uint8_t>(lhs, rhs); mask != all_equal)
+            {
+               return i + std::countr_one(mask);
+            }
+         }
+
+         return i + mismatch_sse2(p_lhs + i, p_rhs + i, count - i); // NOLINT
+      }
+#endif
+
+      template <typename Word>
+      using find_kernel = auto (*)(const Word*, i64_t, Word) noexcept -> i64_t;
+      template <typename Word>
+      using count_kernel = auto (*)(const Word*, i64_t, Word) noexcept -> i64_t;
+      using mismatch_kernel = auto (*)(const std::byte*, const std::byte*, i64_t) noexcept
+         -> i64_t;
+
+      template <typename Word>
+      auto find_with_kernel(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         static const dispatched<find_kernel<Word>> kernel{
+            {isa_level::scalar, find_scalar<Word>},
+#if defined(LIBCARAMEL_X86_KERNELS)
+            {isa_level::sse2, find_sse2<Word>},
+            {isa_level::avx2, find_avx2<Word>},
+#endif
+         };
+
+         return kernel(p_words, count, value);
+      }
+
+      template <typename Word>
+      auto count_with_kernel(const Word* p_words, i64_t count, Word value) noexcept -> i64_t
+      {
+         static const dispatched<count_kernel<Word>> kernel{
+            {isa_level::scalar, count_scalar<Word>},
+#if defined(LIBCARAMEL_X86_KERNELS)
+            {isa_level::sse2, count_sse2<Word>},
+            {isa_level::avx2, count_avx2<Word>},
+#endif
+         };
+
+         return kernel(p_words, count, value);
+      }
+   } // namespace
+
+   auto mismatch_bytes(const std::byte* p_lhs, const std::byte* p_rhs, i64_t count) noexcept
+      -> i64_t
+   {
+      Expects(count >= 0);
+
+      static const dispatched<mismatch_kernel> kernel{
+         {isa_level::scalar, mismatch_scalar},
+#if defined(LIBCARAMEL_X86_KERNELS)
+         {isa_level::sse2, mismatch_sse2},
+         {isa_level::avx2, mismatch_avx2},
+#endif
+      };
+
+      return kernel(p_lhs, p_rhs, count);
+   }
+
+   auto find_words(const std::uint8_t* p_words, i64_t count, std::uint8_t value) noexcept -> i64_t
+   {
+      return find_with_kernel(p_words, count, value);
+   }
+   auto find_words(const std::uint16_t* p_words, i64_t count, std::uint16_t value) noexcept
+      -> i64_t
+   {
+      return find_with_kernel(p_words, count, value);
+   }
+   auto find_words(const std::uint32_t* p_words, i64_t count, std::uint32_t value) noexcept
+      -> i64_t
+   {
+      return find_with_kernel(p_words, count, value);
+   }
+   auto find_words(const std::uint64_t* p_words, i64_t count, std::uint64_t value) noexcept
+      -> i64_t
+   {
+      return find_with_kernel(p_words, count, value);
+   }
+
+   auto count_words(const std::uint8_t* p_words, i64_t count, std::uint8_t value) noexcept
+      -> i64_t
+   {
+      return count_with_kernel(p_words, count, value);
+   }
+   auto count_words(const std::uint16_t* p_words, i64_t count, std::uint16_t value) noexcept
+      -> i64_t
+   {
+      return count_with_kernel(p_words, count, value);
+   }
+   auto count_words(const std::uint32_t* p_words, i64_t count, std::uint32_t value) noexcept
+      -> i64_t
+   {
+      return count_with_kernel(p_words, count, value);
+   }
+   auto count_words(const std::uint64_t* p_words, i64_t count, std::uint64_t value) noexcept
+      -> i64_t
+   {
+      return count_with_kernel(p_words, count, value);
+   }
+} // namespace caramel::simd::detail
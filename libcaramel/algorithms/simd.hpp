@@ -0,0 +1,255 @@
+/**
+ * @file algorithms/simd.hpp
+ * @brief Contains vectorized search and comparison algorithms over contiguous ranges.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/util/types.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace caramel::simd
+{
+   /**
+    * @brief Element types handled by the vectorized kernels: integers and byte-like types, whose
+    * values are equal exactly when their bytes are.
+    *
+    * @details Floating point types are not part of it, as NaN and signed zeros make value and
+    * byte equality differ. The algorithms still accept them, through a scalar loop.
+    */
+   template <typename Any>
+   concept vectorizable = (std::integral<Any> || std::same_as<Any, std::byte>)&&(
+      sizeof(Any) == 1 || sizeof(Any) == 2 || sizeof(Any) == 4 || sizeof(Any) == 8);
+
+   namespace detail
+   {
+      /**
+       * @brief Get the index of the first byte differing between two buffers, or count.
+       */
+      auto mismatch_bytes(const std::byte* p_lhs, const std::byte* p_rhs, i64_t count) noexcept
+         -> i64_t;
+
+      /**
+       * @brief Get the index of the first word equal to value, or count.
+       */
+      auto find_words(const std::uint8_t* p_words, i64_t count, std::uint8_t value) noexcept
+         -> i64_t;
+      auto find_words(const std::uint16_t* p_words, i64_t count, std::uint16_t value) noexcept
+         -> i64_t;
+      auto find_words(const std::uint32_t* p_words, i64_t count, std::uint32_t value) noexcept
+         -> i64_t;
+      auto find_words(const std::uint64_t* p_words, i64_t count, std::uint64_t value) noexcept
+         -> i64_t;
+
+      /**
+       * @brief Get the number of words equal to value.
+       */
+      auto count_words(const std::uint8_t* p_words, i64_t count, std::uint8_t value) noexcept
+         -> i64_t;
+      auto count_words(const std::uint16_t* p_words, i64_t count, std::uint16_t value) noexcept
+         -> i64_t;
+      auto count_words(const std::uint32_t* p_words, i64_t count, std::uint32_t value) noexcept
+         -> i64_t;
+      auto count_words(const std::uint64_t* p_words, i64_t count, std::uint64_t value) noexcept
+         -> i64_t;
+
+      template <std::size_t Bytes>
+      struct word;
+
+      template <>
+      struct word<1>
+      {
+         using type = std::uint8_t;
+      };
+      template <>
+      struct word<2>
+      {
+         using type = std::uint16_t;
+      };
+      template <>
+      struct word<4>
+      {
+         using type = std::uint32_t;
+      };
+      template <>
+      struct word<8>
+      {
+         using type = std::uint64_t;
+      };
+
+      template <typename Any>
+      using word_t = typename word<sizeof(Any)>::type;
+
+      template <typename Any>
+      auto as_words(const Any* p_values) noexcept -> const word_t<Any>*
+      {
+         return reinterpret_cast<const word_t<Any>*>(p_values); // NOLINT
+      }
+      template <typename Any>
+      auto as_bytes(const Any* p_values) noexcept -> const std::byte*
+      {
+         return reinterpret_cast<const std::byte*>(p_values); // NOLINT
+      }
+
+      template <typename Range>
+      constexpr auto size_of(const Range& range) -> i64_t
+      {
+         return static_cast<i64_t>(std::ranges::size(range));
+      }
+   } // namespace detail
+
+   /**
+    * @brief Find the first element equal to value.
+    *
+    * @param[in] values The range to search.
+    * @param[in] value The value to search for.
+    *
+    * @return The index of the first element equal to value, or the size of the range if there is
+    * none.
+    */
+   template <std::ranges::contiguous_range Range>
+   constexpr auto find(const Range& values, const std::ranges::range_value_t<Range>& value)
+      -> i64_t
+   {
+      using value_type = std::ranges::range_value_t<Range>;
+
+      if constexpr (vectorizable<value_type>)
+      {
+         if (!std::is_constant_evaluated())
+         {
+            return detail::find_words(detail::as_words(std::ranges::data(values)),
+                                      detail::size_of(values),
+                                      std::bit_cast<detail::word_t<value_type>>(value));
+         }
+      }
+
+      return std::ranges::find(values, value) - std::ranges::begin(values);
+   }
+
+   /**
+    * @brief Count the elements equal to value.
+    */
+   template <std::ranges::contiguous_range Range>
+   constexpr auto count(const Range& values, const std::ranges::range_value_t<Range>& value)
+      -> i64_t
+   {
+      using value_type = std::ranges::range_value_t<Range>;
+
+      if constexpr (vectorizable<value_type>)
+      {
+         if (!std::is_constant_evaluated())
+         {
+            return detail::count_words(detail::as_words(std::ranges::data(values)),
+                                       detail::size_of(values),
+                                       std::bit_cast<detail::word_t<value_type>>(value));
+         }
+      }
+
+      return static_cast<i64_t>(std::ranges::count(values, value));
+   }
+
+   /**
+    * @brief Check if an element is equal to value.
+    */
+   template <std::ranges::contiguous_range Range>
+   constexpr auto contains(const Range& values, const std::ranges::range_value_t<Range>& value)
+      -> bool
+   {
+      return find(values, value) != detail::size_of(values);
+   }
+
+   /**
+    * @brief Check if two ranges have the same size and equal elements.
+    */
+   template <std::ranges::contiguous_range First, std::ranges::contiguous_range Second>
+      requires std::same_as<std::ranges::range_value_t<First>,
+                            std::ranges::range_value_t<Second>>
+   constexpr auto equal(const First& lhs, const Second& rhs) -> bool
+   {
+      using value_type = std::ranges::range_value_t<First>;
+
+      if (detail::size_of(lhs) != detail::size_of(rhs))
+      {
+         return false;
+      }
+
+      if constexpr (vectorizable<value_type>)
+      {
+         if (!std::is_constant_evaluated())
+         {
+            // Equality needs no position: memcmp is as vectorized as mismatch_bytes and stops at
+            // the first differing word.
+            const auto bytes = std::ranges::size(lhs) * sizeof(value_type);
+
+            return bytes == 0 ||
+               std::memcmp(std::ranges::data(lhs), std::ranges::data(rhs), bytes) == 0;
+         }
+      }
+
+      return std::ranges::equal(lhs, rhs);
+   }
+
+   /**
+    * @brief Compare two ranges lexicographically.
+    *
+    * @return The ordering of the first pair of elements that differ or, if one range is a prefix
+    * of the other, the ordering of their sizes.
+    */
+   template <std::ranges::contiguous_range First, std::ranges::contiguous_range Second>
+      requires std::same_as<std::ranges::range_value_t<First>,
+                            std::ranges::range_value_t<Second>> &&
+         std::three_way_comparable<std::ranges::range_value_t<First>>
+   constexpr auto compare(const First& lhs, const Second& rhs)
+      -> std::compare_three_way_result_t<std::ranges::range_value_t<First>>
+   {
+      using value_type = std::ranges::range_value_t<First>;
+
+      if constexpr (vectorizable<value_type>)
+      {
+         if (!std::is_constant_evaluated())
+         {
+            const auto* p_lhs = std::ranges::data(lhs);
+            const auto* p_rhs = std::ranges::data(rhs);
+            const i64_t common = std::min(detail::size_of(lhs), detail::size_of(rhs));
+
+            // The order of unsigned bytes is the order of memcmp.
+            if constexpr (sizeof(value_type) == 1 && !std::is_signed_v<value_type>)
+            {
+               const int order =
+                  common == 0 ? 0 : std::memcmp(p_lhs, p_rhs, static_cast<std::size_t>(common));
+               if (order != 0)
+               {
+                  return order <=> 0;
+               }
+
+               return detail::size_of(lhs) <=> detail::size_of(rhs);
+            }
+
+            const i64_t index = detail::mismatch_bytes(
+                                   detail::as_bytes(p_lhs), detail::as_bytes(p_rhs),
+                                   common * static_cast<i64_t>(sizeof(value_type))) /
+               static_cast<i64_t>(sizeof(value_type));
+            if (index < common)
+            {
+               return p_lhs[index] <=> p_rhs[index]; // NOLINT
+            }
+
+            return detail::size_of(lhs) <=> detail::size_of(rhs);
+         }
+      }
+
+      return std::lexicographical_compare_three_way(std::ranges::begin(lhs), std::ranges::end(lhs),
+                                                    std::ranges::begin(rhs), std::ranges::end(rhs));
+   }
+} // namespace caramel::simd
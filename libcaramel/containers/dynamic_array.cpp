@@ -0,0 +1,36 @@
+#include <libcaramel/containers/dynamic_array.hpp>
+
+#include <cstring>
+#include <new>
+
+namespace caramel::detail
+{
+   auto grow_trivial_storage(memory_resource* p_resource, void* p_data, bool is_static,
+                             i64_t size, i64_t capacity, i64_t min_capacity, i64_t element_size,
+                             i64_t element_alignment) -> grown_storage
+   {
+      Expects(size <= capacity);
+
+      const i64_t new_capacity = grown_capacity(min_capacity);
+
+      void* p_new_data =
+         p_resource->allocate(count_t{new_capacity * element_size}, align_t{element_alignment});
+      if (p_new_data == nullptr)
+      {
+         throw std::bad_alloc{};
+      }
+
+      if (size != 0)
+      {
+         std::memcpy(p_new_data, p_data, static_cast<std::size_t>(size * element_size));
+      }
+
+      if (!is_static && p_data != nullptr)
+      {
+         p_resource->deallocate(gsl::make_not_null(p_data), count_t{capacity * element_size},
+                                align_t{element_alignment});
+      }
+
+      return {.p_data = p_new_data, .capacity = new_capacity};
+   }
+} // namespace caramel::detail
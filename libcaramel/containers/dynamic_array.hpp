@@ -6,23 +6,33 @@
 
 #pragma once
 
+#include <libcaramel/algorithms/simd.hpp>
 #include <libcaramel/iterators/random_iterator.hpp>
 #include <libcaramel/memory/memory_allocator.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
 #include <libcaramel/util/types.hpp>
 
 #include <gsl/gsl_assert>
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <type_traits>
 
 namespace caramel::detail
 {
    template <typename First, typename Second>
-   auto synth_three_way(const First& lhs, const Second& rhs)
+   constexpr auto synth_three_way(const First& lhs, const Second& rhs)
    {
       if constexpr (std::three_way_comparable_with<First, Second>)
       {
@@ -43,6 +53,89 @@ namespace caramel::detail
          return std::strong_ordering::greater;
       }
    }
+
+   /**
+    * @brief Turn contiguous iterators into pointers so that standard algorithms on trivially
+    * copyable elements reduce to memmove.
+    */
+   template <typename Iter>
+   constexpr auto unwrap_iterator(Iter it) noexcept
+   {
+      if constexpr (std::contiguous_iterator<Iter>)
+      {
+         return std::to_address(it);
+      }
+      else
+      {
+         return it;
+      }
+   }
+
+   /**
+    * @brief Get the capacity a dynamic array grows to in order to hold min_capacity elements: the
+    * next power of two.
+    */
+   constexpr auto grown_capacity(i64_t min_capacity) noexcept -> i64_t
+   {
+      constexpr auto max_digits = std::numeric_limits<i64_t>::digits;
+      constexpr auto max_capacity = i64_t{1} << (max_digits - 1);
+
+      if (min_capacity > max_capacity)
+      {
+         return max_capacity;
+      }
+
+      --min_capacity;
+
+      for (i64_t i = 1; i < max_digits; i *= 2)
+      {
+         min_capacity |= min_capacity >> i;
+      }
+
+      return ++min_capacity;
+   }
+
+   /**
+    * @brief The storage of a dynamic array after it grew.
+    */
+   struct grown_storage
+   {
+      void* p_data;
+      i64_t capacity;
+   };
+
+   /**
+    * @brief Grow the storage of a dynamic array of trivially copyable elements allocated from
+    * p_resource. The elements are moved with a single memcpy and the old storage is released,
+    * unless it is the static buffer.
+    *
+    * @details Compiled once in the library, this is the growth path of every dynamic array of
+    * trivially copyable elements using a memory_allocator, whatever their type.
+    *
+    * @throws std::bad_alloc If p_resource failed to allocate the new storage.
+    */
+   auto grow_trivial_storage(memory_resource* p_resource, void* p_data, bool is_static,
+                             i64_t size, i64_t capacity, i64_t min_capacity, i64_t element_size,
+                             i64_t element_alignment) -> grown_storage;
+
+   /**
+    * @brief Layout of the start of a basic_dynamic_array: its static buffer directly follows the
+    * Size independent base.
+    */
+   template <typename Base, typename Any>
+   struct dynamic_array_layout
+   {
+      alignas(Base) std::byte base[sizeof(Base)]; // NOLINT
+      alignas(Any) std::byte first[sizeof(Any)];  // NOLINT
+   };
+
+   /**
+    * @brief Ranges whose elements can be copied into an array of Any with a single memcpy.
+    */
+   template <typename Range, typename Any>
+   concept memcpy_range = std::ranges::contiguous_range<Range> &&
+      std::ranges::sized_range<Range> && std::same_as<std::ranges::range_value_t<Range>, Any> &&
+      std::is_trivially_copyable_v<Any>;
 } // namespace caramel::detail
 
 namespace caramel
@@ -55,18 +148,44 @@ namespace caramel
    inline constexpr in_place_t in_place;
 
    /**
-    * @author wmbat wmbat@protonmail.com
-    * @date Sunday, 13th of december 2020
-    * @brief A resizable array with a small statically allocated storage buffer
-    * @copyright MIT License
+    * @brief Opt-in for element types that are not trivially destructible but only own memory
+    * allocated from the resource of the container holding them, such as nested dynamic arrays.
+    * Such elements can be abandoned along with the container, see basic_dynamic_array::wink_out().
+    *
+    * @details Only types that take the allocator of the container on construction and keep it
+    * through assignment and swap, see std::uses_allocator, may opt in: otherwise an element
+    * assigned from outside the container could own memory of another resource.
+    */
+   template <typename Any>
+   inline constexpr bool enable_wink_out = false;
+
+   /**
+    * @brief Element types that can be abandoned without running their destructor once the
+    * monotonic_resource they were allocated from is released.
+    */
+   template <typename Any>
+   concept winkable = std::is_trivially_destructible_v<Any> || enable_wink_out<Any>;
+
+   /**
+    * @brief The part of a basic_dynamic_array that does not depend on the size of its static
+    * buffer.
+    *
+    * @details Every basic_dynamic_array of the same element type and allocator shares the code of
+    * this class, so that instantiating many buffer sizes does not duplicate the growth, insertion
+    * and erasure logic. Like LLVM's SmallVectorImpl, it can also be used to take an array of any
+    * buffer size by reference. The static buffer is found right after this class, where
+    * basic_dynamic_array places it.
+    *
+    * Elements whose allocator_type the allocator of the array converts to, such as nested
+    * dynamic arrays and small strings, are constructed with it, so that a whole nested structure
+    * allocates from the same memory_resource.
     *
     * @tparam Any The type of the elements
-    * @tparam Size The size of the staticly allocated small buffer.
     * @tparam Allocator The allocator that is used to acquire/release and construct/destroy the
     * elements in that memory.
     */
-   template <typename Any, i64_t Size, typename Allocator = memory_allocator<Any>>
-   class basic_dynamic_array
+   template <typename Any, typename Allocator = memory_allocator<Any>>
+   class dynamic_array_base
    {
    public:
       using value_type = Any;
@@ -83,246 +202,6 @@ namespace caramel
       using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
    public:
-      /**
-       * @brief Default constructor.
-       */
-      constexpr basic_dynamic_array() noexcept = default;
-      /**
-       * @brief Default construct the container with a given allocator
-       *
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      constexpr basic_dynamic_array(const allocator_type& allocator) : m_allocator{allocator} {}
-      /**
-       * @brief Construct the container with count copies of elements with value value
-       *
-       * @pre `count >= 0`, otherwise UB
-       *
-       * @param[in] count The size of the container.
-       * @param[in] The value to initialize elements from.
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      constexpr basic_dynamic_array(size_type count, const_reference value,
-                                    const allocator_type& allocator = allocator_type{}) :
-         m_allocator{allocator}
-      {
-         Expects(count >= 0);
-
-         assign(count, value);
-      }
-      /**
-       * @brief Construct the container with the contents of the initializer list init.
-       *
-       * @param[in] init Initializer list to initialize the elements of the container with.
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      constexpr basic_dynamic_array(std::initializer_list<Any> init,
-                                    const allocator_type& allocator = allocator_type{}) :
-         m_allocator{allocator}
-      {
-         assign(init);
-      }
-      /**
-       * @brief Construct the container with the contents of the range [first, last)
-       *
-       * @param[in] first The first element of the range to copy from.
-       * @param[in] last One past the last element of the range to copy from.
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      template <std::input_iterator InputIt>
-      constexpr basic_dynamic_array(InputIt first, InputIt last,
-                                    const allocator_type& allocator = allocator_type{}) :
-         m_allocator{allocator}
-      {
-         assign(first, last);
-      }
-      /**
-       * @brief Construct the container using the contents of other.
-       *
-       * @param[in] other Another container to be used as source to initialize the elements of the
-       * container with.
-       */
-      constexpr basic_dynamic_array(const basic_dynamic_array& other)
-      {
-         if (this != &other)
-         {
-            *this = other;
-         }
-      }
-      /**
-       * @brief Construct the container using the contents of other. using allocator as the
-       * allocator.
-       *
-       * @param[in] other Another container to be used as source to initialize the elements of the
-       * container with.
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      constexpr basic_dynamic_array(const basic_dynamic_array& other,
-                                    const allocator_type& allocator)
-      {
-         if (this != &other)
-         {
-            clear();
-
-            if (!is_static())
-            {
-               m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
-            }
-
-            reset_to_static();
-
-            m_allocator = allocator;
-
-            const size_type new_count = std::distance(std::begin(other), std::end(other));
-            if (new_count > capacity())
-            {
-               grow(new_count);
-            }
-
-            m_size = new_count;
-
-            std::uninitialized_copy(std::begin(other), std::end(other), begin());
-         }
-      }
-      /**
-       * @brief Construct the container with the contents of the other using move semantic. After
-       * move, other is guarenteed to be empty().
-       *
-       * @param[in] other another container to be used as source to initialize the elements of the
-       * container with.
-       */
-      constexpr basic_dynamic_array(basic_dynamic_array&& other) noexcept
-      {
-         if (!other.empty())
-         {
-            *this = std::move(other);
-         }
-      }
-      /**
-       * @brief Construct the container with the contents of the other using move semantic. Using
-       * alloc as the allocator for the new container.
-       *
-       * @param[in] other another container to be used as source to initialize the elements of the
-       * container with.
-       * @param[in] allocator The allocator to use for all memory allocations of this container.
-       */
-      constexpr basic_dynamic_array(basic_dynamic_array&& other, const allocator_type& alloc)
-      {
-         clear();
-
-         if (!is_static())
-         {
-            m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
-         }
-
-         reset_to_static();
-
-         m_allocator = alloc;
-
-         using mi = std::move_iterator<iterator>;
-         assign(mi{other.begin()}, mi{other.end()});
-
-         other.reset_to_static();
-      }
-      /**
-       * @brief Destructor
-       */
-      constexpr ~basic_dynamic_array() noexcept
-      {
-         clear();
-
-         if (!is_static() && mp_begin)
-         {
-            m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
-         }
-
-         reset_to_static();
-      }
-
-      /**
-       * @brief Replaces the contents with an copy of the contents of rhs.
-       *
-       * @param[in] rhs other container to use as a data source.
-       */
-      constexpr auto operator=(const basic_dynamic_array& rhs) -> basic_dynamic_array&
-      {
-         if (this != &rhs)
-         {
-            if (m_allocator != rhs.m_allocator)
-            {
-               clear();
-
-               if (!is_static())
-               {
-                  m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
-               }
-
-               reset_to_static();
-            }
-
-            m_allocator = rhs.m_allocator;
-
-            assign(rhs.begin(), rhs.end());
-         }
-
-         return *this;
-      }
-
-      /**
-       * @brief Replaces the contents with those of other using move semantics.
-       *
-       * @param[in] rhs other container to use as a data source.
-       */
-      constexpr auto operator=(basic_dynamic_array&& rhs) noexcept -> basic_dynamic_array&
-      {
-         if (m_allocator != rhs.allocator())
-         {
-            using move_it = std::move_iterator<iterator>;
-            assign(move_it{rhs.begin()}, move_it{rhs.end()});
-
-            rhs.reset_to_static();
-         }
-         else
-         {
-            if (!rhs.is_static())
-            {
-               if (!is_static())
-               {
-                  clear();
-
-                  m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
-
-                  reset_to_static();
-               }
-
-               m_size = rhs.size();
-               m_capacity = rhs.capacity();
-               mp_begin = rhs.mp_begin;
-            }
-            else
-            {
-               using move_it = std::move_iterator<iterator>;
-               assign(move_it{rhs.begin()}, move_it{rhs.end()});
-            }
-
-            rhs.reset_to_static();
-         }
-
-         return *this;
-      }
-
-      /**
-       * @brief Replaces the contents with those identified by initializer list init_list
-       *
-       * @param init_list Initializer list to use as data source.
-       */
-      constexpr auto operator=(std::initializer_list<Any> init_list) -> basic_dynamic_array&
-      {
-         assign(init_list);
-
-         return *this;
-      }
-
       /**
        * @brief Returns the allocator associated with the container.
        *
@@ -370,14 +249,14 @@ namespace caramel
        * @return A pointer to the first element in the container. If no elements are in the
        * container, the pointer will be null.
        */
-      constexpr auto data() noexcept -> pointer { return pointer{&(*begin())}; }
+      constexpr auto data() noexcept -> pointer { return mp_begin; }
       /**
        * @brief Access the data stored by the container.
        *
        * @return A const_pointer to the first element in the container. If no elements are in the
        * container, the pointer will be null.
        */
-      constexpr auto data() const noexcept -> const_pointer { return const_pointer{&(*cbegin())}; }
+      constexpr auto data() const noexcept -> const_pointer { return mp_begin; }
 
       /**
        * @brief Returns an iterator to the first element of the basic_dynamic_array.
@@ -567,6 +446,16 @@ namespace caramel
             return end() - 1;
          }
 
+         if constexpr (propagates_allocator)
+         {
+            const size_type index = pos - cbegin();
+            const size_type old_size = size();
+
+            append(std::make_obj_using_allocator<value_type>(m_allocator, value));
+
+            return rotate_appended(index, old_size);
+         }
+
          iterator new_pos;
          if (size() >= capacity())
          {
@@ -579,8 +468,9 @@ namespace caramel
             new_pos = begin() + (pos - cbegin());
          }
 
-         std::construct_at(offset(size()), std::move(*(end() - 1)));
-         std::move_backward(new_pos, end() - 1, end());
+         construct(offset(size()), std::move(*(end() - 1)));
+         std::move_backward(detail::unwrap_iterator(new_pos), detail::unwrap_iterator(end() - 1),
+                            detail::unwrap_iterator(end()));
 
          ++m_size;
 
@@ -619,6 +509,16 @@ namespace caramel
             return end() - 1;
          }
 
+         if constexpr (propagates_allocator)
+         {
+            const size_type index = pos - cbegin();
+            const size_type old_size = size();
+
+            append(std::make_obj_using_allocator<value_type>(m_allocator, std::move(value)));
+
+            return rotate_appended(index, old_size);
+         }
+
          iterator new_pos;
          if (size() >= capacity())
          {
@@ -633,7 +533,8 @@ namespace caramel
 
          construct(offset(size()), std::move(*(end() - 1)));
 
-         std::move_backward(new_pos, end() - 1, end());
+         std::move_backward(detail::unwrap_iterator(new_pos), detail::unwrap_iterator(end() - 1),
+                            detail::unwrap_iterator(end()));
 
          ++m_size;
 
@@ -672,6 +573,16 @@ namespace caramel
             return end() - 1;
          }
 
+         if constexpr (propagates_allocator)
+         {
+            const size_type index = pos - cbegin();
+            const size_type old_size = size();
+
+            append(in_place, std::forward<Args>(args)...);
+
+            return rotate_appended(index, old_size);
+         }
+
          iterator new_pos;
          if (size() >= capacity())
          {
@@ -684,9 +595,10 @@ namespace caramel
             new_pos = begin() + (pos - cbegin());
          }
 
-         new (&(*end())) value_type(std::move(*(end() - 1)));
+         construct(offset(size()), std::move(*(end() - 1)));
 
-         std::move_backward(new_pos, end() - 1, end());
+         std::move_backward(detail::unwrap_iterator(new_pos), detail::unwrap_iterator(end() - 1),
+                            detail::unwrap_iterator(end()));
 
          ++m_size;
 
@@ -721,24 +633,38 @@ namespace caramel
                grow(size() + count);
             }
 
-            std::uninitialized_fill_n(end(), count, value);
+            construct_fill(offset(size()), count, value);
 
             m_size += count;
 
             return begin() + start_index;
          }
 
+         if constexpr (propagates_allocator)
+         {
+            const auto copy = std::make_obj_using_allocator<value_type>(m_allocator, value);
+            const size_type old_size = size();
+
+            reserve(size() + count);
+            construct_fill(offset(size()), count, copy);
+            m_size += count;
+
+            return rotate_appended(start_index, old_size);
+         }
+
          reserve(size() + count);
 
          iterator updated_pos = begin() + start_index;
 
          if (iterator old_end = end(); end() - updated_pos >= count)
          {
-            std::uninitialized_move(end() - count, end(), end());
+            construct_move(offset(size() - count), offset(size()), offset(size()));
 
             m_size += count;
 
-            std::move_backward(updated_pos, old_end - count, old_end);
+            std::move_backward(detail::unwrap_iterator(updated_pos),
+                               detail::unwrap_iterator(old_end - count),
+                               detail::unwrap_iterator(old_end));
             std::fill_n(updated_pos, count, value);
          }
          else
@@ -746,9 +672,10 @@ namespace caramel
             size_type move_count = old_end - updated_pos;
             m_size += count;
 
-            std::uninitialized_move(updated_pos, old_end, end() - move_count);
+            construct_move(detail::unwrap_iterator(updated_pos), detail::unwrap_iterator(old_end),
+                           detail::unwrap_iterator(end() - move_count));
             std::fill_n(updated_pos, move_count, value);
-            std::uninitialized_fill_n(old_end, count - move_count, value);
+            construct_fill(detail::unwrap_iterator(old_end), count - move_count, value);
          }
 
          return updated_pos;
@@ -769,76 +696,114 @@ namespace caramel
        */
       template <std::input_iterator InputIt>
       constexpr auto insert(const_iterator pos, InputIt first, InputIt last) -> iterator
+      {
+         return insert_range(pos, std::ranges::subrange{first, last});
+      }
+
+      /**
+       * @brief Insert elements from an initializer_list before the position pos.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] init_list Initializer list to insert the values from.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      constexpr auto insert(const_iterator pos, std::initializer_list<value_type> init_list)
+         -> iterator
+      {
+         return insert(pos, init_list.begin(), init_list.end());
+      }
+      /**
+       * @brief Insert the elements of a range before pos, growing the storage at most once.
+       *
+       * @details Forward ranges are counted first so that the storage is grown once and the
+       * elements after pos are shifted once. Single pass input ranges, sized or not, are appended
+       * and then rotated into place. Contiguous ranges of trivially copyable elements are copied
+       * with memcpy.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] range The range to insert the values from.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr auto insert_range(const_iterator pos, Range&& range) -> iterator
       {
          Expects(pos >= cbegin());
          Expects(pos <= cend());
 
-         size_type start_index = pos - cbegin();
-         difference_type count = std::distance(first, last);
+         const size_type start_index = pos - cbegin();
 
          if (pos == cend())
          {
-            if (size() + count >= capacity())
-            {
-               grow(size() + count);
-            }
-
-            std::uninitialized_copy(first, last, end());
-
-            m_size += count;
+            append_range(std::forward<Range>(range));
 
             return begin() + start_index;
          }
 
-         reserve(size() + count);
-
-         iterator updated_pos = begin() + start_index;
-         if (iterator old_end = end(); end() - updated_pos >= count)
+         // Only forward ranges can be walked twice, to be split between assigned and constructed
+         // elements. Elements given the allocator of the array are appended then rotated, as
+         // assigning them would give them the allocator of the values of the range.
+         if constexpr (std::ranges::forward_range<Range> && !propagates_allocator)
          {
-            std::uninitialized_move(end() - count, end(), end());
+            const auto count = static_cast<size_type>(std::ranges::distance(range));
 
-            m_size += count;
+            reserve(size() + count);
 
-            std::move_backward(updated_pos, old_end - count, old_end);
-            std::copy(first, last, updated_pos);
-         }
-         else
-         {
-            size_type move_count = old_end - updated_pos;
-            m_size += count;
+            const iterator updated_pos = begin() + start_index;
+            const iterator old_end = end();
+            const size_type move_count = old_end - updated_pos;
+
+            if (move_count >= count)
+            {
+               construct_move(detail::unwrap_iterator(old_end - count),
+                              detail::unwrap_iterator(old_end), detail::unwrap_iterator(old_end));
 
-            std::uninitialized_move(updated_pos, old_end, end() - move_count);
+               m_size += count;
 
-            for (auto it = updated_pos; count > 0; --count)
+               std::move_backward(detail::unwrap_iterator(updated_pos),
+                                  detail::unwrap_iterator(old_end - count),
+                                  detail::unwrap_iterator(old_end));
+               std::ranges::copy(range, detail::unwrap_iterator(updated_pos));
+            }
+            else
             {
-               *it = *first;
+               construct_move(detail::unwrap_iterator(updated_pos),
+                              detail::unwrap_iterator(old_end),
+                              detail::unwrap_iterator(old_end + (count - move_count)));
+
+               m_size += count;
 
-               ++it;
-               ++first;
+               auto first = std::ranges::begin(range);
+               auto middle = std::ranges::next(first, move_count);
+               std::ranges::copy(first, middle, detail::unwrap_iterator(updated_pos));
+               construct_each(middle, std::ranges::end(range), offset(start_index + move_count));
             }
 
-            std::uninitialized_copy(first, last, old_end);
+            return updated_pos;
          }
+         else
+         {
+            const size_type old_size = size();
 
-         return updated_pos;
-      }
+            append_range(std::forward<Range>(range));
 
-      /**
-       * @brief Insert elements from an initializer_list before the position pos.
-       *
-       * @pre pos >= begin()
-       * @pre pos <= end()
-       *
-       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
-       * iterator.
-       * @param[in] init_list Initializer list to insert the values from.
-       *
-       * @return Iterator pointing to the first element inserted.
-       */
-      constexpr auto insert(const_iterator pos, std::initializer_list<value_type> init_list)
-         -> iterator
-      {
-         return insert(pos, init_list.begin(), init_list.end());
+            std::rotate(detail::unwrap_iterator(begin() + start_index),
+                        detail::unwrap_iterator(begin() + old_size),
+                        detail::unwrap_iterator(end()));
+
+            return begin() + start_index;
+         }
       }
 
       /**
@@ -861,7 +826,8 @@ namespace caramel
 
          auto it = begin() + (pos - cbegin());
 
-         std::move(it + 1, end(), it);
+         std::move(detail::unwrap_iterator(it + 1), detail::unwrap_iterator(end()),
+                   detail::unwrap_iterator(it));
 
          pop_back();
 
@@ -872,7 +838,7 @@ namespace caramel
        *
        * @pre first >= begin()
        * @pre last <= end()
-       * @pre first >= last
+       * @pre first <= last
        *
        * @param[in] first The first element of the range to copy from.
        * @param[in] last One past the last element of the range to copy from.
@@ -885,7 +851,7 @@ namespace caramel
       {
          Expects(first >= cbegin());
          Expects(last <= cend());
-         Expects(first >= last);
+         Expects(first <= last);
 
          if (first == last)
          {
@@ -896,7 +862,8 @@ namespace caramel
 
          iterator it_f = begin() + (first - cbegin());
          iterator it_l = begin() + (last - cbegin());
-         iterator it = std::move(it_l, end(), it_f);
+         iterator it{std::move(detail::unwrap_iterator(it_l), detail::unwrap_iterator(end()),
+                               detail::unwrap_iterator(it_f))};
 
          std::destroy(it, end());
 
@@ -904,6 +871,90 @@ namespace caramel
 
          return it_f;
       }
+      /**
+       * @brief Erases the specified element in constant time by moving the last element in its
+       * place. The order of the remaining elements is not preserved.
+       *
+       * @pre pos >= begin()
+       * @pre pos < end()
+       *
+       * @param[in] pos Iterator to the element to remove.
+       *
+       * @return Iterator to the element that took the place of the removed one, or end() if the
+       * last element was removed.
+       */
+      constexpr auto erase_unordered(const_iterator pos) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos < cend());
+
+         const size_type index = pos - cbegin();
+
+         --m_size;
+         if (index != m_size)
+         {
+            *offset(index) = std::move(*offset(m_size));
+         }
+
+         std::destroy_at(offset(m_size));
+
+         return begin() + index;
+      }
+      /**
+       * @brief Erases every element for which predicate returns true, in a single pass that keeps
+       * the order of the remaining elements.
+       *
+       * @param[in] predicate The predicate that selects the elements to remove.
+       *
+       * @return The number of elements removed.
+       */
+      template <std::predicate<const_reference> Predicate>
+      constexpr auto erase_if(Predicate predicate) -> size_type
+      {
+         auto* p_new_end = std::remove_if(detail::unwrap_iterator(begin()),
+                                          detail::unwrap_iterator(end()), std::ref(predicate));
+
+         const size_type removed = std::to_address(end()) - p_new_end;
+
+         std::destroy(p_new_end, std::to_address(end()));
+         m_size -= removed;
+
+         return removed;
+      }
+      /**
+       * @brief Erases the elements at the given indices, in a single pass that keeps the order of
+       * the remaining elements.
+       *
+       * @pre indices is sorted in strictly increasing order.
+       * @pre every index is in [0, size()).
+       *
+       * @param[in] indices The indices of the elements to remove.
+       */
+      constexpr void erase_indices(std::span<const size_type> indices)
+      {
+         if (indices.empty())
+         {
+            return;
+         }
+
+         Expects(indices.front() >= 0);
+         Expects(indices.back() < size());
+
+         // Every run of kept elements between two erased ones is moved once, towards the front.
+         auto* p_out = offset(indices.front());
+         for (std::size_t i = 0; i < indices.size(); ++i)
+         {
+            const size_type run_first = indices[i] + 1;
+            const size_type run_last = i + 1 < indices.size() ? indices[i + 1] : size();
+
+            Expects(run_first <= run_last);
+
+            p_out = std::move(offset(run_first), offset(run_last), p_out);
+         }
+
+         std::destroy(p_out, offset(size()));
+         m_size -= static_cast<size_type>(indices.size());
+      }
 
       /**
        * @brief Appends the given element value to the end of the container. The new element is
@@ -918,7 +969,7 @@ namespace caramel
             grow();
          }
 
-         construct(mp_begin + size(), value);
+         construct(offset(size()), value);
 
          ++m_size;
       }
@@ -935,7 +986,7 @@ namespace caramel
             grow();
          }
 
-         construct(mp_begin + size(), std::move(value));
+         construct(offset(size()), std::move(value));
 
          ++m_size;
       }
@@ -955,12 +1006,45 @@ namespace caramel
             grow();
          }
 
-         std::construct_at(offset(size()), std::forward<Args>(args)...);
+         construct(offset(size()), std::forward<Args>(args)...);
 
          ++m_size;
 
          return *(end() - 1);
       }
+      /**
+       * @brief Append the elements of a range to the end of the container, growing the storage at
+       * most once.
+       *
+       * @details Sized and forward ranges reserve their exact count before any element is
+       * constructed, single pass input ranges are appended one element at a time. Contiguous
+       * ranges of trivially copyable elements are copied with memcpy.
+       *
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] range The range to append the values from.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr void append_range(Range&& range)
+      {
+         if constexpr (std::ranges::forward_range<Range> || std::ranges::sized_range<Range>)
+         {
+            const auto count = static_cast<size_type>(std::ranges::distance(range));
+
+            reserve(size() + count);
+            construct_range(range, offset(size()), count);
+
+            m_size += count;
+         }
+         else
+         {
+            for (auto&& value : range)
+            {
+               append(in_place, std::forward<decltype(value)>(value));
+            }
+         }
+      }
 
       /**
        * @brief Removes the last element in the container.
@@ -971,8 +1055,8 @@ namespace caramel
       {
          Expects(size() != 0);
 
-         std::destroy_at(offset(size()));
          --m_size;
+         std::destroy_at(offset(size()));
       };
 
       /**
@@ -998,7 +1082,7 @@ namespace caramel
 
             for (size_type i = size(); i < count; ++i)
             {
-               construct(offset(i), value_type{});
+               construct(offset(i));
             }
 
             m_size = count;
@@ -1026,13 +1110,35 @@ namespace caramel
                grow(count);
             }
 
-            std::uninitialized_fill(end(), begin() + count, value);
+            construct_fill(offset(size()), count - size(), value);
 
             m_size = count;
          }
       }
 
-   private:
+   protected:
+      constexpr dynamic_array_base(size_type static_capacity,
+                                   const allocator_type& allocator) noexcept :
+         m_allocator{allocator},
+         m_capacity{static_capacity}
+      {}
+      dynamic_array_base(const dynamic_array_base&) = delete;
+      dynamic_array_base(dynamic_array_base&&) = delete;
+      /**
+       * @brief Release the storage. The elements have already been destroyed by the derived
+       * class.
+       */
+      constexpr ~dynamic_array_base() noexcept
+      {
+         if (!is_static() && mp_begin)
+         {
+            m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
+         }
+      }
+
+      auto operator=(const dynamic_array_base&) -> dynamic_array_base& = delete;
+      auto operator=(dynamic_array_base&&) -> dynamic_array_base& = delete;
+
       [[nodiscard]] constexpr auto is_static() const noexcept -> bool
       {
          return mp_begin == get_first_element();
@@ -1040,128 +1146,713 @@ namespace caramel
 
       constexpr auto get_first_element() const -> pointer
       {
-         return const_cast<pointer>(reinterpret_cast<const_pointer>(&m_static_storage)); // NOLINT
+         using layout = detail::dynamic_array_layout<dynamic_array_base, value_type>;
+
+         const auto* p_this = reinterpret_cast<const std::byte*>(this); // NOLINT
+         return const_cast<pointer>(
+            reinterpret_cast<const_pointer>(p_this + offsetof(layout, first))); // NOLINT
       }
 
       constexpr void grow(size_type min_size = 0)
       {
-         const auto new_capacity = compute_new_capacity(std::max(m_capacity + 1, min_size));
-         auto* new_elements = m_allocator.allocate(count_t{new_capacity});
+         const size_type min_capacity = std::max(m_capacity + 1, min_size);
 
-         if constexpr (std::is_move_constructible_v<value_type>)
+         if constexpr (std::is_trivially_copyable_v<value_type> &&
+                       std::same_as<allocator_type, memory_allocator<value_type>>)
          {
-            std::uninitialized_move(begin(), end(), iterator{new_elements});
+            const detail::grown_storage storage = detail::grow_trivial_storage(
+               m_allocator.resource(), mp_begin, is_static(), m_size, m_capacity, min_capacity,
+               sizeof(value_type), alignof(value_type));
+
+            mp_begin = static_cast<pointer>(storage.p_data);
+            m_capacity = storage.capacity;
          }
          else
          {
-            std::uninitialized_copy(begin(), end(), iterator{new_elements});
+            const auto new_capacity = detail::grown_capacity(min_capacity);
+            auto* new_elements = m_allocator.allocate(count_t{new_capacity});
+
+            if constexpr (std::is_move_constructible_v<value_type>)
+            {
+               construct_move(mp_begin, mp_begin + m_size, new_elements);
+            }
+            else
+            {
+               construct_each(mp_begin, mp_begin + m_size, new_elements);
+            }
+
+            std::destroy(begin(), end());
+
+            if (!is_static())
+            {
+               if (mp_begin)
+               {
+                  m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
+               }
+            }
+
+            mp_begin = new_elements;
+            m_capacity = new_capacity;
          }
+      }
 
-         std::destroy(begin(), end());
+      constexpr void reset_to_static(size_type static_capacity)
+      {
+         mp_begin = get_first_element();
+         m_size = 0;
+         m_capacity = static_capacity;
+      }
+
+      /**
+       * @brief Destroy the elements and go back to the static buffer, releasing the storage.
+       */
+      constexpr void release(size_type static_capacity)
+      {
+         clear();
+
+         if (!is_static() && mp_begin)
+         {
+            m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
+         }
+
+         reset_to_static(static_capacity);
+      }
+
+      /**
+       * @brief Copy the elements of rhs, keeping the allocator of the array and reusing the
+       * storage and the elements already held.
+       *
+       * @details Elements common to both arrays are copy assigned, so that they keep their own
+       * allocator, and the storage only grows when rhs does not fit in it.
+       */
+      constexpr void copy_assign(const dynamic_array_base& rhs)
+      {
+         if (this == &rhs)
+         {
+            return;
+         }
 
-         if (!is_static())
+         if constexpr (std::is_copy_assignable_v<value_type>)
          {
-            if (mp_begin)
+            if (rhs.size() <= capacity())
             {
-               m_allocator.deallocate(gsl::make_not_null(mp_begin), count_t{capacity()});
+               const size_type common = std::min(size(), rhs.size());
+
+               std::copy(rhs.offset(0), rhs.offset(common), offset(0));
+               if (rhs.size() > size())
+               {
+                  auto tail = std::span{rhs.offset(common), rhs.offset(rhs.size())};
+                  construct_range(tail, offset(common), rhs.size() - common);
+               }
+               else
+               {
+                  std::destroy(offset(rhs.size()), offset(size()));
+               }
+
+               m_size = rhs.size();
+
+               return;
             }
          }
 
-         mp_begin = new_elements;
-         m_capacity = new_capacity;
+         clear();
+         append_range(std::span{rhs.offset(0), rhs.offset(rhs.size())});
       }
 
-      constexpr void reset_to_static()
+      /**
+       * @brief Take the elements of rhs, leaving it empty, while keeping the allocator of the
+       * array.
+       *
+       * @details When the allocators are equal, the heap storage of rhs is stolen and elements in
+       * its static buffer are moved into ours, which is as large, so it never allocates.
+       * Otherwise the elements are moved one by one into storage of our allocator and the storage
+       * of rhs is released.
+       */
+      constexpr void move_assign(dynamic_array_base& rhs, size_type static_capacity) noexcept(
+         allocator_always_equal && std::is_nothrow_move_constructible_v<value_type>)
       {
-         mp_begin = get_first_element();
-         m_size = 0;
-         m_capacity = Size;
+         if (this == &rhs)
+         {
+            return;
+         }
+
+         if (m_allocator == rhs.m_allocator && !rhs.is_static())
+         {
+            release(static_capacity);
+
+            mp_begin = rhs.mp_begin;
+            m_size = rhs.size();
+            m_capacity = rhs.capacity();
+
+            rhs.reset_to_static(static_capacity);
+
+            return;
+         }
+
+         assign_each(std::make_move_iterator(rhs.offset(0)), rhs.size());
+
+         rhs.release(static_capacity);
+      }
+
+      /**
+       * @brief Replace the elements with the count values starting at first, a random access
+       * iterator possibly wrapped in a std::move_iterator, reusing the storage and the elements
+       * already held.
+       *
+       * @details Elements common to both are assigned, so that they keep their own allocator,
+       * and the others are constructed with the allocator of the array.
+       */
+      template <std::input_iterator Iter>
+      constexpr void assign_each(Iter first, size_type count)
+      {
+         if (count > capacity())
+         {
+            clear();
+            grow(count);
+         }
+
+         const size_type common = std::min(size(), count);
+
+         std::copy(first, first + common, offset(0));
+         if (count > size())
+         {
+            construct_each(first + common, first + count, offset(common));
+         }
+         else
+         {
+            std::destroy(offset(count), offset(size()));
+         }
+
+         m_size = count;
+      }
+
+      /**
+       * @brief Exchange the elements and storage of two arrays with equal allocators and static
+       * buffers of the same capacity, without allocating. Each array keeps its allocator.
+       *
+       * @details Heap storage is exchanged by pointer. Elements held in a static buffer are moved
+       * into the static buffer of the other array, which is free if it uses the heap and large
+       * enough otherwise.
+       */
+      constexpr void swap_with(dynamic_array_base& rhs, size_type static_capacity) noexcept(
+         std::is_nothrow_move_constructible_v<value_type> &&
+         std::is_nothrow_swappable_v<value_type>)
+      {
+         Expects(m_allocator == rhs.m_allocator);
+
+         if (this == &rhs)
+         {
+            return;
+         }
+
+         if (!is_static() && !rhs.is_static())
+         {
+            std::swap(mp_begin, rhs.mp_begin);
+            std::swap(m_capacity, rhs.m_capacity);
+         }
+         else if (is_static() && rhs.is_static())
+         {
+            dynamic_array_base& smaller = size() < rhs.size() ? *this : rhs;
+            dynamic_array_base& larger = size() < rhs.size() ? rhs : *this;
+            const size_type common = smaller.size();
+
+            std::swap_ranges(smaller.offset(0), smaller.offset(common), larger.offset(0));
+            larger.construct_move(larger.offset(common), larger.offset(larger.size()),
+                                  smaller.offset(common));
+            std::destroy(larger.offset(common), larger.offset(larger.size()));
+         }
+         else
+         {
+            dynamic_array_base& heap_array = is_static() ? rhs : *this;
+            dynamic_array_base& inline_array = is_static() ? *this : rhs;
+
+            inline_array.construct_move(inline_array.offset(0),
+                                        inline_array.offset(inline_array.size()),
+                                        heap_array.get_first_element());
+            std::destroy(inline_array.begin(), inline_array.end());
+
+            inline_array.mp_begin = heap_array.mp_begin;
+            inline_array.m_capacity = heap_array.capacity();
+            heap_array.mp_begin = heap_array.get_first_element();
+            heap_array.m_capacity = static_capacity;
+         }
+
+         std::swap(m_size, rhs.m_size);
+      }
+
+      constexpr void assign(size_type count, const_reference value)
+      {
+         clear();
+
+         if (count > m_capacity)
+         {
+            grow(count);
+         }
+
+         m_size = count;
+
+         construct_fill(offset(0), count, value);
+      }
+
+      template <std::input_iterator InputIt>
+      constexpr void assign(InputIt first, InputIt last)
+      {
+         clear();
+         append_range(std::ranges::subrange{first, last});
+      }
+
+      constexpr void assign(std::initializer_list<value_type> initializer_list)
+      {
+         assign(initializer_list.begin(), initializer_list.end());
+      }
+
+      /**
+       * @brief Construct the count elements of range in the uninitialized storage at p_first.
+       */
+      template <typename Range>
+      constexpr void construct_range(Range& range, pointer p_first, size_type count)
+      {
+         if constexpr (detail::memcpy_range<Range, value_type>)
+         {
+            if (!std::is_constant_evaluated())
+            {
+               if (count != 0)
+               {
+                  std::memcpy(p_first, std::ranges::data(range),
+                              static_cast<std::size_t>(count) * sizeof(value_type));
+               }
+
+               return;
+            }
+         }
+
+         construct_each(std::ranges::begin(range), std::ranges::end(range), p_first);
+      }
+
+      /**
+       * @brief Construct an element at p_element from args. Elements using an allocator the one of
+       * the array converts to are given it, so that nested containers allocate from the same
+       * resource as the array, see std::uses_allocator.
+       */
+      template <typename... Args>
+      constexpr void construct(pointer p_element, Args&&... args)
+      {
+         if constexpr (propagates_allocator)
+         {
+            std::uninitialized_construct_using_allocator(p_element, m_allocator,
+                                                         std::forward<Args>(args)...);
+         }
+         else
+         {
+            std::construct_at(p_element, std::forward<Args>(args)...);
+         }
+      }
+
+      /**
+       * @brief Construct elements at p_first from the values of [first, last), like
+       * std::uninitialized_copy.
+       *
+       * @return One past the last constructed element.
+       */
+      template <std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+      constexpr auto construct_each(InputIt first, Sentinel last, pointer p_first) -> pointer
+      {
+         if constexpr (propagates_allocator)
+         {
+            pointer p_current = p_first;
+            try
+            {
+               for (; first != last; ++first, ++p_current)
+               {
+                  construct(p_current, *first);
+               }
+            }
+            catch (...)
+            {
+               std::destroy(p_first, p_current);
+               throw;
+            }
+
+            return p_current;
+         }
+         else
+         {
+            return std::ranges::uninitialized_copy(first, last, p_first, std::unreachable_sentinel)
+               .out;
+         }
+      }
+
+      /**
+       * @brief Construct elements at p_first by moving [first, last), like std::uninitialized_move.
+       */
+      template <std::input_iterator InputIt>
+      constexpr auto construct_move(InputIt first, InputIt last, pointer p_first) -> pointer
+      {
+         if constexpr (propagates_allocator)
+         {
+            return construct_each(std::make_move_iterator(first), std::make_move_iterator(last),
+                                  p_first);
+         }
+         else
+         {
+            return std::uninitialized_move(first, last, p_first);
+         }
+      }
+
+      /**
+       * @brief Construct count copies of value at p_first, like std::uninitialized_fill_n.
+       */
+      constexpr void construct_fill(pointer p_first, size_type count, const_reference value)
+      {
+         if constexpr (propagates_allocator)
+         {
+            size_type constructed = 0;
+            try
+            {
+               for (; constructed < count; ++constructed)
+               {
+                  construct(p_first + constructed, value);
+               }
+            }
+            catch (...)
+            {
+               std::destroy(p_first, p_first + constructed);
+               throw;
+            }
+         }
+         else
+         {
+            std::uninitialized_fill_n(p_first, count, value);
+         }
+      }
+
+      /**
+       * @brief Move the elements appended after old_size before the element at index.
+       *
+       * @details Used to insert elements given the allocator of the array: they are constructed
+       * at the end, where assigning them would give them the allocator of the inserted values.
+       *
+       * @return Iterator to the first moved element.
+       */
+      constexpr auto rotate_appended(size_type index, size_type old_size) -> iterator
+      {
+         std::rotate(offset(index), offset(old_size), offset(size()));
+
+         return begin() + index;
+      }
+
+      constexpr auto offset(size_type i) noexcept -> pointer { return mp_begin + i; }
+      constexpr auto offset(size_type i) const noexcept -> const_pointer { return mp_begin + i; }
+
+   protected:
+      /**
+       * @brief Whether the elements are constructed with the allocator of the array.
+       */
+      static constexpr bool propagates_allocator =
+         std::uses_allocator_v<value_type, allocator_type>;
+      /**
+       * @brief Whether all allocators of the array compare equal, as stateless ones do, so that
+       * moves and swaps never fall back to moving the elements one by one into new storage.
+       */
+      static constexpr bool allocator_always_equal = std::is_empty_v<allocator_type>;
+
+      // The allocator comes first so that the class has no tail padding the static buffer of
+      // basic_dynamic_array could be placed in, see get_first_element().
+      [[no_unique_address]] allocator_type m_allocator;
+
+      pointer mp_begin{get_first_element()};
+
+      size_type m_size{0u};
+      size_type m_capacity{0u};
+   };
+
+   /**
+    * @author wmbat wmbat@protonmail.com
+    * @date Sunday, 13th of december 2020
+    * @brief A resizable array with a small statically allocated storage buffer
+    * @copyright MIT License
+    *
+    * @tparam Any The type of the elements
+    * @tparam Size The size of the staticly allocated small buffer.
+    * @tparam Allocator The allocator that is used to acquire/release and construct/destroy the
+    * elements in that memory.
+    */
+   template <typename Any, i64_t Size, typename Allocator = memory_allocator<Any>>
+   class basic_dynamic_array : public dynamic_array_base<Any, Allocator>
+   {
+      using base = dynamic_array_base<Any, Allocator>;
+
+   public:
+      using typename base::value_type;
+      using typename base::size_type;
+      using typename base::difference_type;
+      using typename base::allocator_type;
+      using typename base::reference;
+      using typename base::const_reference;
+      using typename base::pointer;
+      using typename base::const_pointer;
+      using typename base::iterator;
+      using typename base::const_iterator;
+      using typename base::reverse_iterator;
+      using typename base::const_reverse_iterator;
+
+   public:
+      /**
+       * @brief Default constructor.
+       */
+      constexpr basic_dynamic_array() noexcept : base{Size, allocator_type{}} {}
+      /**
+       * @brief Default construct the container with a given allocator
+       *
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr basic_dynamic_array(const allocator_type& allocator) : base{Size, allocator} {}
+      /**
+       * @brief Construct the container with count copies of elements with value value
+       *
+       * @pre `count >= 0`, otherwise UB
+       *
+       * @param[in] count The size of the container.
+       * @param[in] The value to initialize elements from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr basic_dynamic_array(size_type count, const_reference value,
+                                    const allocator_type& allocator = allocator_type{}) :
+         base{Size, allocator}
+      {
+         Expects(count >= 0);
+
+         this->assign(count, value);
+      }
+      /**
+       * @brief Construct the container with the contents of the initializer list init.
+       *
+       * @param[in] init Initializer list to initialize the elements of the container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr basic_dynamic_array(std::initializer_list<Any> init,
+                                    const allocator_type& allocator = allocator_type{}) :
+         base{Size, allocator}
+      {
+         this->assign(init);
+      }
+      /**
+       * @brief Construct the container with the contents of the range [first, last)
+       *
+       * @param[in] first The first element of the range to copy from.
+       * @param[in] last One past the last element of the range to copy from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      template <std::input_iterator InputIt>
+      constexpr basic_dynamic_array(InputIt first, InputIt last,
+                                    const allocator_type& allocator = allocator_type{}) :
+         base{Size, allocator}
+      {
+         this->assign(first, last);
+      }
+      /**
+       * @brief Construct the container using the contents of other.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      constexpr basic_dynamic_array(const basic_dynamic_array& other) :
+         base{Size, other.allocator()}
+      {
+         this->assign(other.begin(), other.end());
+      }
+      /**
+       * @brief Construct the container using the contents of other. using allocator as the
+       * allocator.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr basic_dynamic_array(const basic_dynamic_array& other,
+                                    const allocator_type& allocator) :
+         base{Size, allocator}
+      {
+         this->assign(other.begin(), other.end());
+      }
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. After
+       * move, other is guarenteed to be empty().
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      constexpr basic_dynamic_array(basic_dynamic_array&& other) noexcept(
+         Size == 0 || std::is_nothrow_move_constructible_v<Any>) :
+         base{Size, other.allocator()}
+      {
+         this->move_assign(other, Size);
+      }
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. Using
+       * alloc as the allocator for the new container.
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr basic_dynamic_array(basic_dynamic_array&& other, const allocator_type& alloc) :
+         base{Size, alloc}
+      {
+         this->move_assign(other, Size);
       }
-
-      constexpr void assign(size_type count, const_reference value)
+      /**
+       * @brief Destructor
+       */
+      constexpr ~basic_dynamic_array() noexcept
       {
-         clear();
-
-         if (count > m_capacity)
-         {
-            grow(count);
-         }
+         using layout = detail::dynamic_array_layout<base, Any>;
 
-         m_size = count;
+         static_assert(static_storage_offset() == offsetof(layout, first),
+                       "get_first_element() would not find the static buffer");
 
-         std::uninitialized_fill(begin(), end(), value);
+         this->clear();
       }
 
-      template <std::input_iterator InputIt>
-      constexpr void assign(InputIt first, InputIt last)
+      /**
+       * @brief Replaces the contents with an copy of the contents of rhs.
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      constexpr auto operator=(const basic_dynamic_array& rhs) -> basic_dynamic_array&
       {
-         clear();
+         this->copy_assign(rhs);
 
-         const auto new_count = static_cast<size_type>(std::distance(first, last));
-         if (new_count > capacity())
-         {
-            grow(new_count);
-         }
+         return *this;
+      }
 
-         m_size = new_count;
+      /**
+       * @brief Replaces the contents with those of other using move semantics, keeping the
+       * allocator of the container. The heap storage of rhs is reused when the allocators are
+       * equal, otherwise its elements are moved one by one into new storage, which may throw.
+       * After move, rhs is guarenteed to be empty().
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      constexpr auto operator=(basic_dynamic_array&& rhs) noexcept(
+         base::allocator_always_equal && (Size == 0 || std::is_nothrow_move_constructible_v<Any>))
+         -> basic_dynamic_array&
+      {
+         this->move_assign(rhs, Size);
 
-         std::uninitialized_copy(first, last, begin());
+         return *this;
       }
 
-      constexpr void assign(std::initializer_list<value_type> initializer_list)
+      /**
+       * @brief Replaces the contents with those identified by initializer list init_list
+       *
+       * @param init_list Initializer list to use as data source.
+       */
+      constexpr auto operator=(std::initializer_list<Any> init_list) -> basic_dynamic_array&
       {
-         assign(initializer_list.begin(), initializer_list.end());
-      }
+         this->assign(init_list);
 
-      constexpr auto offset(size_type i) noexcept -> pointer { return mp_begin + i; }
-      constexpr auto offset(size_type i) const noexcept -> const_pointer { return mp_begin + i; }
+         return *this;
+      }
 
-      static constexpr auto compute_new_capacity(size_type min_capacity) -> size_type
+      /**
+       * @brief Exchange the contents of the container with those of other, each keeping its
+       * allocator. Nothing is allocated when the allocators are equal, otherwise the elements are
+       * moved one by one into new storage, which may throw.
+       *
+       * @param[in] other The container to exchange the contents with.
+       */
+      constexpr void swap(basic_dynamic_array& other) noexcept(
+         base::allocator_always_equal &&
+         (Size == 0 ||
+          (std::is_nothrow_move_constructible_v<Any> && std::is_nothrow_swappable_v<Any>)))
       {
-         constexpr auto max_digits = std::numeric_limits<size_type>::digits;
-         constexpr auto max_capacity = size_type{1} << (max_digits - 1);
-
-         if (min_capacity > max_capacity)
+         if (this->allocator() == other.allocator())
          {
-            return max_capacity;
+            this->swap_with(other, Size);
          }
-
-         --min_capacity;
-
-         for (size_type i = 1; i < max_digits; i *= 2)
+         else
          {
-            min_capacity |= min_capacity >> i;
-         }
+            basic_dynamic_array temp{std::move(other), this->allocator()};
 
-         return ++min_capacity;
+            other = std::move(*this);
+            *this = std::move(temp);
+         }
       }
 
-   private:
-      pointer mp_begin{nullptr};
+      /**
+       * @brief Abandon the elements and their storage without destroying nor deallocating them,
+       * leaving the container empty, so that tearing it down takes constant time.
+       *
+       * @details The memory is reclaimed when the monotonic_resource it was allocated from is
+       * released. Elements owning memory of another resource would leak it, hence only winkable
+       * elements are accepted.
+       *
+       * @pre The allocator of the container uses a monotonic_resource.
+       */
+      void wink_out() noexcept
+         requires winkable<Any> && std::same_as<Allocator, memory_allocator<Any>>
+      {
+         Expects(dynamic_cast<monotonic_resource*>(this->allocator().resource()) != nullptr);
 
-      alignas(alignof(Any)) std::array<std::byte, sizeof(Any) * Size> m_static_storage;
+         base::reset_to_static(Size);
+      }
 
-      size_type m_size{0u};
-      size_type m_capacity{0u};
+   private:
+      static constexpr auto static_storage_offset() noexcept -> std::size_t
+      {
+         // The class is not standard layout, but has no virtual base, so offsetof is supported.
+#if defined(__GNUC__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+         return offsetof(basic_dynamic_array, m_static_storage);
+#if defined(__GNUC__)
+#   pragma GCC diagnostic pop
+#endif
+      }
 
-      allocator_type m_allocator;
+   private:
+      // Reached through dynamic_array_base::get_first_element().
+      [[maybe_unused]] alignas(alignof(Any)) std::array<std::byte, sizeof(Any) * Size>
+         m_static_storage;
    };
 
    template <std::equality_comparable Any, i64_t SizeOne, i64_t SizeTwo, typename allocator>
    constexpr auto operator==(const basic_dynamic_array<Any, SizeOne, allocator>& lhs,
                              const basic_dynamic_array<Any, SizeTwo, allocator>& rhs) -> bool
    {
-      return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+      return simd::equal(lhs, rhs);
    }
 
    template <typename Any, i64_t SizeOne, i64_t SizeTwo, typename allocator>
    constexpr auto operator<=>(const basic_dynamic_array<Any, SizeOne, allocator>& lhs,
                               const basic_dynamic_array<Any, SizeTwo, allocator>& rhs)
    {
-      return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs), std::begin(rhs),
-                                                    std::end(rhs), detail::synth_three_way);
+      if constexpr (simd::vectorizable<Any>)
+      {
+         return simd::compare(lhs, rhs);
+      }
+      else
+      {
+         return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs),
+                                                       std::begin(rhs), std::end(rhs),
+                                                       detail::synth_three_way);
+      }
+   }
+
+   template <typename Any, i64_t Size, typename Allocator>
+   constexpr void swap(basic_dynamic_array<Any, Size, Allocator>& lhs,
+                       basic_dynamic_array<Any, Size, Allocator>& rhs) noexcept(
+      noexcept(lhs.swap(rhs)))
+   {
+      lhs.swap(rhs);
    }
 
+   template <typename Any, i64_t Size>
+   inline constexpr bool enable_wink_out<basic_dynamic_array<Any, Size, memory_allocator<Any>>> =
+      winkable<Any>;
+
    template <typename Iter, i64_t Size = 0,
              typename Allocator = memory_allocator<typename std::iterator_traits<Iter>::value_type>>
    basic_dynamic_array(Iter, Iter)
@@ -1191,8 +1882,8 @@ namespace caramel
       using allocator_type = typename underlying_type::allocator_type;
       using reference = value_type&;
       using const_reference = const value_type&;
-      using pointer = typename std::allocator_traits<allocator_type>::pointer;
-      using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+      using pointer = typename allocator_type::pointer;
+      using const_pointer = typename allocator_type::const_pointer;
       using iterator = typename underlying_type::iterator;
       using const_iterator = typename underlying_type::const_iterator;
       using reverse_iterator = std::reverse_iterator<iterator>;
@@ -1203,29 +1894,67 @@ namespace caramel
        * @brief Default constructor.
        */
       constexpr small_dynamic_array() noexcept(noexcept(underlying_type{})) = default;
+      /**
+       * @brief Default construct the container with a given allocator
+       *
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr small_dynamic_array(const allocator_type& allocator) : m_underlying(allocator) {}
       /**
        * @brief Construct the container with count copies of elements with value value
        *
        * @param[in] count The size of the container.
        * @param[in] The value to initialize elements from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
-      constexpr small_dynamic_array(size_type count, const_reference value) :
-         m_underlying{count, value}
+      constexpr small_dynamic_array(size_type count, const_reference value,
+                                    const allocator_type& allocator = allocator_type{}) :
+         m_underlying(count, value, allocator)
       {}
       /**
        * @brief Construct the container with the contents of the initializer list init.
        *
        * @param[in] init Initializer list to initialize the elements of the container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
-      constexpr small_dynamic_array(std::initializer_list<Any> init) : m_underlying{init} {}
+      constexpr small_dynamic_array(std::initializer_list<Any> init,
+                                    const allocator_type& allocator = allocator_type{}) :
+         m_underlying(init, allocator)
+      {}
       /**
        * @brief Construct the container with the contents of the range [first, last)
        *
        * @param[in] first The first element of the range to copy from.
        * @param[in] last One past the last element of the range to copy from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
       template <std::input_iterator InputIt>
-      constexpr small_dynamic_array(InputIt first, InputIt last) : m_underlying{first, last}
+      constexpr small_dynamic_array(InputIt first, InputIt last,
+                                    const allocator_type& allocator = allocator_type{}) :
+         m_underlying(first, last, allocator)
+      {}
+      /**
+       * @brief Construct the container using the contents of other, using allocator as the
+       * allocator.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr small_dynamic_array(const small_dynamic_array& other,
+                                    const allocator_type& allocator) :
+         m_underlying(other.m_underlying, allocator)
+      {}
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. Using
+       * allocator as the allocator for the new container.
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr small_dynamic_array(small_dynamic_array&& other, const allocator_type& allocator) :
+         m_underlying(std::move(other.m_underlying), allocator)
       {}
 
       /**
@@ -1544,7 +2273,26 @@ namespace caramel
       constexpr auto insert(const_iterator pos, std::initializer_list<value_type> init_list)
          -> iterator
       {
-         return m_underlying(pos, init_list);
+         return m_underlying.insert(pos, init_list);
+      }
+      /**
+       * @brief Insert the elements of a range before pos, growing the storage at most once.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] range The range to insert the values from.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr auto insert_range(const_iterator pos, Range&& range) -> iterator
+      {
+         return m_underlying.insert_range(pos, std::forward<Range>(range));
       }
 
       /**
@@ -1561,7 +2309,7 @@ namespace caramel
        *
        * @pre first >= begin()
        * @pre last <= end()
-       * @pre first >= last
+       * @pre first <= last
        *
        * @param[in] first The first element of the range to copy from.
        * @param[in] last One past the last element of the range to copy from.
@@ -1574,6 +2322,48 @@ namespace caramel
       {
          return m_underlying.erase(first, last);
       }
+      /**
+       * @brief Erases the specified element in constant time by moving the last element in its
+       * place. The order of the remaining elements is not preserved.
+       *
+       * @pre pos >= begin()
+       * @pre pos < end()
+       *
+       * @param[in] pos Iterator to the element to remove.
+       *
+       * @return Iterator to the element that took the place of the removed one, or end() if the
+       * last element was removed.
+       */
+      constexpr auto erase_unordered(const_iterator pos) -> iterator
+      {
+         return m_underlying.erase_unordered(pos);
+      }
+      /**
+       * @brief Erases every element for which predicate returns true, in a single pass that keeps
+       * the order of the remaining elements.
+       *
+       * @param[in] predicate The predicate that selects the elements to remove.
+       *
+       * @return The number of elements removed.
+       */
+      template <std::predicate<const_reference> Predicate>
+      constexpr auto erase_if(Predicate predicate) -> size_type
+      {
+         return m_underlying.erase_if(std::move(predicate));
+      }
+      /**
+       * @brief Erases the elements at the given indices, in a single pass that keeps the order of
+       * the remaining elements.
+       *
+       * @pre indices is sorted in strictly increasing order.
+       * @pre every index is in [0, size()).
+       *
+       * @param[in] indices The indices of the elements to remove.
+       */
+      constexpr void erase_indices(std::span<const size_type> indices)
+      {
+         m_underlying.erase_indices(indices);
+      }
 
       /**
        * @brief Appends the given element value to the end of the container. The new element is
@@ -1602,6 +2392,20 @@ namespace caramel
       {
          return m_underlying.append(in_place, std::forward<Args>(args)...);
       }
+      /**
+       * @brief Append the elements of a range to the end of the container, growing the storage at
+       * most once.
+       *
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] range The range to append the values from.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr void append_range(Range&& range)
+      {
+         m_underlying.append_range(std::forward<Range>(range));
+      }
 
       /**
        * @brief Removes the last element in the container.
@@ -1631,6 +2435,30 @@ namespace caramel
          m_underlying.resize(count, value);
       }
 
+      /**
+       * @brief Exchange the contents of the container with those of other, each keeping its
+       * allocator. Nothing is allocated when the allocators are equal.
+       *
+       * @param[in] other The container to exchange the contents with.
+       */
+      constexpr void swap(small_dynamic_array& other) noexcept(
+         noexcept(m_underlying.swap(other.m_underlying)))
+      {
+         m_underlying.swap(other.m_underlying);
+      }
+
+      /**
+       * @brief Abandon the elements and their storage without destroying nor deallocating them,
+       * leaving the container empty, so that tearing it down takes constant time.
+       *
+       * @pre The allocator of the container uses a monotonic_resource.
+       */
+      void wink_out() noexcept
+         requires winkable<Any>
+      {
+         m_underlying.wink_out();
+      }
+
    private:
       underlying_type m_underlying;
    };
@@ -1639,17 +2467,35 @@ namespace caramel
    constexpr auto operator==(const small_dynamic_array<Any, SizeOne>& lhs,
                              const small_dynamic_array<Any, SizeTwo>& rhs) -> bool
    {
-      return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+      return simd::equal(lhs, rhs);
    }
 
    template <typename Any, i64_t SizeOne, i64_t SizeTwo>
    constexpr auto operator<=>(const small_dynamic_array<Any, SizeOne>& lhs,
                               const small_dynamic_array<Any, SizeTwo>& rhs)
    {
-      return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs), std::begin(rhs),
-                                                    std::end(rhs), detail::synth_three_way);
+      if constexpr (simd::vectorizable<Any>)
+      {
+         return simd::compare(lhs, rhs);
+      }
+      else
+      {
+         return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs),
+                                                       std::begin(rhs), std::end(rhs),
+                                                       detail::synth_three_way);
+      }
+   }
+
+   template <typename Any, i64_t Size>
+   constexpr void swap(small_dynamic_array<Any, Size>& lhs,
+                       small_dynamic_array<Any, Size>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+   {
+      lhs.swap(rhs);
    }
 
+   template <typename Any, i64_t Size>
+   inline constexpr bool enable_wink_out<small_dynamic_array<Any, Size>> = winkable<Any>;
+
    template <typename Iter, i64_t Size = 0>
    small_dynamic_array(Iter, Iter)
       -> small_dynamic_array<typename std::iterator_traits<Iter>::value_type, Size>;
@@ -1689,28 +2535,66 @@ namespace caramel
        * @brief Default constructor.
        */
       constexpr dynamic_array() noexcept(noexcept(underlying_type{})) = default;
+      /**
+       * @brief Default construct the container with a given allocator
+       *
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr dynamic_array(const allocator_type& allocator) : m_underlying(allocator) {}
       /**
        * @brief Construct the container with count copies of elements with value value
        *
        * @param[in] count The size of the container.
        * @param[in] The value to initialize elements from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
-      constexpr dynamic_array(size_type count, const_reference value) : m_underlying{count, value}
+      constexpr dynamic_array(size_type count, const_reference value,
+                              const allocator_type& allocator = allocator_type{}) :
+         m_underlying(count, value, allocator)
       {}
       /**
        * @brief Construct the container with the contents of the initializer list init.
        *
        * @param[in] init Initializer list to initialize the elements of the container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
-      constexpr dynamic_array(std::initializer_list<Any> init) : m_underlying{init} {}
+      constexpr dynamic_array(std::initializer_list<Any> init,
+                              const allocator_type& allocator = allocator_type{}) :
+         m_underlying(init, allocator)
+      {}
       /**
        * @brief Construct the container with the contents of the range [first, last)
        *
        * @param[in] first The first element of the range to copy from.
        * @param[in] last One past the last element of the range to copy from.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
        */
       template <std::input_iterator InputIt>
-      constexpr dynamic_array(InputIt first, InputIt last) : m_underlying{first, last}
+      constexpr dynamic_array(InputIt first, InputIt last,
+                              const allocator_type& allocator = allocator_type{}) :
+         m_underlying(first, last, allocator)
+      {}
+      /**
+       * @brief Construct the container using the contents of other, using allocator as the
+       * allocator.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr dynamic_array(const dynamic_array& other, const allocator_type& allocator) :
+         m_underlying(other.m_underlying, allocator)
+      {}
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. Using
+       * allocator as the allocator for the new container.
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      constexpr dynamic_array(dynamic_array&& other, const allocator_type& allocator) :
+         m_underlying(std::move(other.m_underlying), allocator)
       {}
 
       /**
@@ -2029,7 +2913,26 @@ namespace caramel
       constexpr auto insert(const_iterator pos, std::initializer_list<value_type> init_list)
          -> iterator
       {
-         return m_underlying(pos, init_list);
+         return m_underlying.insert(pos, init_list);
+      }
+      /**
+       * @brief Insert the elements of a range before pos, growing the storage at most once.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] range The range to insert the values from.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr auto insert_range(const_iterator pos, Range&& range) -> iterator
+      {
+         return m_underlying.insert_range(pos, std::forward<Range>(range));
       }
 
       /**
@@ -2046,7 +2949,7 @@ namespace caramel
        *
        * @pre first >= begin()
        * @pre last <= end()
-       * @pre first >= last
+       * @pre first <= last
        *
        * @param[in] first The first element of the range to copy from.
        * @param[in] last One past the last element of the range to copy from.
@@ -2059,6 +2962,48 @@ namespace caramel
       {
          return m_underlying.erase(first, last);
       }
+      /**
+       * @brief Erases the specified element in constant time by moving the last element in its
+       * place. The order of the remaining elements is not preserved.
+       *
+       * @pre pos >= begin()
+       * @pre pos < end()
+       *
+       * @param[in] pos Iterator to the element to remove.
+       *
+       * @return Iterator to the element that took the place of the removed one, or end() if the
+       * last element was removed.
+       */
+      constexpr auto erase_unordered(const_iterator pos) -> iterator
+      {
+         return m_underlying.erase_unordered(pos);
+      }
+      /**
+       * @brief Erases every element for which predicate returns true, in a single pass that keeps
+       * the order of the remaining elements.
+       *
+       * @param[in] predicate The predicate that selects the elements to remove.
+       *
+       * @return The number of elements removed.
+       */
+      template <std::predicate<const_reference> Predicate>
+      constexpr auto erase_if(Predicate predicate) -> size_type
+      {
+         return m_underlying.erase_if(std::move(predicate));
+      }
+      /**
+       * @brief Erases the elements at the given indices, in a single pass that keeps the order of
+       * the remaining elements.
+       *
+       * @pre indices is sorted in strictly increasing order.
+       * @pre every index is in [0, size()).
+       *
+       * @param[in] indices The indices of the elements to remove.
+       */
+      constexpr void erase_indices(std::span<const size_type> indices)
+      {
+         m_underlying.erase_indices(indices);
+      }
 
       /**
        * @brief Appends the given element value to the end of the container. The new element is
@@ -2087,6 +3032,20 @@ namespace caramel
       {
          return m_underlying.append(in_place, std::forward<Args>(args)...);
       }
+      /**
+       * @brief Append the elements of a range to the end of the container, growing the storage at
+       * most once.
+       *
+       * @pre range does not refer to elements of the container.
+       *
+       * @param[in] range The range to append the values from.
+       */
+      template <std::ranges::input_range Range>
+         requires std::constructible_from<value_type, std::ranges::range_reference_t<Range>>
+      constexpr void append_range(Range&& range)
+      {
+         m_underlying.append_range(std::forward<Range>(range));
+      }
 
       /**
        * @brief Removes the last element in the container.
@@ -2116,6 +3075,30 @@ namespace caramel
          m_underlying.resize(count, value);
       }
 
+      /**
+       * @brief Exchange the contents of the container with those of other, each keeping its
+       * allocator. Nothing is allocated when the allocators are equal.
+       *
+       * @param[in] other The container to exchange the contents with.
+       */
+      constexpr void swap(dynamic_array& other) noexcept(
+         noexcept(m_underlying.swap(other.m_underlying)))
+      {
+         m_underlying.swap(other.m_underlying);
+      }
+
+      /**
+       * @brief Abandon the elements and their storage without destroying nor deallocating them,
+       * leaving the container empty, so that tearing it down takes constant time.
+       *
+       * @pre The allocator of the container uses a monotonic_resource.
+       */
+      void wink_out() noexcept
+         requires winkable<Any>
+      {
+         m_underlying.wink_out();
+      }
+
    private:
       underlying_type m_underlying;
    };
@@ -2123,16 +3106,34 @@ namespace caramel
    template <std::equality_comparable Any>
    constexpr auto operator==(const dynamic_array<Any>& lhs, const dynamic_array<Any>& rhs) -> bool
    {
-      return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+      return simd::equal(lhs, rhs);
    }
 
    template <typename Any>
    constexpr auto operator<=>(const dynamic_array<Any>& lhs, const dynamic_array<Any>& rhs)
    {
-      return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs), std::begin(rhs),
-                                                    std::end(rhs), detail::synth_three_way);
+      if constexpr (simd::vectorizable<Any>)
+      {
+         return simd::compare(lhs, rhs);
+      }
+      else
+      {
+         return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs),
+                                                       std::begin(rhs), std::end(rhs),
+                                                       detail::synth_three_way);
+      }
+   }
+
+   template <typename Any>
+   constexpr void swap(dynamic_array<Any>& lhs, dynamic_array<Any>& rhs) noexcept(
+      noexcept(lhs.swap(rhs)))
+   {
+      lhs.swap(rhs);
    }
 
+   template <typename Any>
+   inline constexpr bool enable_wink_out<dynamic_array<Any>> = winkable<Any>;
+
    template <typename Iter>
    dynamic_array(Iter, Iter) -> dynamic_array<typename std::iterator_traits<Iter>::value_type>;
 } // namespace caramel
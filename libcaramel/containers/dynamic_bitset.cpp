@@ -0,0 +1,191 @@
+#include <libcaramel/containers/dynamic_bitset.hpp>
+#include <libcaramel/util/cpu_dispatch.hpp>
+
+#if defined(LIBCARAMEL_X86_KERNELS)
+#   include <immintrin.h>
+#endif
+
+namespace caramel
+{
+   namespace detail
+   {
+      namespace
+      {
+         auto popcount_words_scalar(const u64_t* p_words, i64_t count) noexcept -> i64_t
+         {
+            i64_t total = 0;
+            for (i64_t i = 0; i < count; ++i)
+            {
+               total += std::popcount(p_words[i]); // NOLINT
+            }
+
+            return total;
+         }
+
+#if defined(LIBCARAMEL_X86_KERNELS)
+         __attribute__((target("popcnt"))) auto popcount_words_popcnt(const u64_t* p_words,
+                                                                      i64_t count) noexcept
+            -> i64_t
+         {
+            // Independent accumulators hide the latency of the popcnt instruction.
+            i64_t totals[4] = {0, 0, 0, 0}; // NOLINT
+
+            i64_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+               totals[0] += __builtin_popcountll(p_words[i]);     // NOLINT
+               totals[1] += __builtin_popcountll(p_words[i + 1]); // NOLINT
+               totals[2] += __builtin_popcountll(p_words[i + 2]); // NOLINT
+               totals[3] += __builtin_popcountll(p_words[i + 3]); // NOLINT
+            }
+
+            for (; i < count; ++i)
+            {
+               totals[0] += __builtin_popcountll(p_words[i]); // NOLINT
+            }
+
+            return totals[0] + totals[1] + totals[2] + totals[3];
+         }
+
+         /**
+          * Nibble lookup popcount (W. Mula): every byte is split in two nibbles whose bit counts
+          * are looked up with a byte shuffle, the byte counts are then summed with sad_epu8.
+          */
+         __attribute__((target("avx2"))) auto popcount_words_avx2(const u64_t* p_words,
+                                                                  i64_t count) noexcept -> i64_t
+         {
+            const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+            __m256i totals = _mm256_setzero_si256();
+
+            i64_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+               const __m256i words =
+                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_words + i)); // NOLINT
+               const __m256i low = _mm256_and_si256(words, low_mask);
+               const __m256i high = _mm256_and_si256(_mm256_srli_epi16(words, 4), low_mask);
+               const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                                     _mm256_shuffle_epi8(lookup, high));
+
+               totals = _mm256_add_epi64(totals, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+            }
+
+            i64_t total = _mm256_extract_epi64(totals, 0) + _mm256_extract_epi64(totals, 1) +
+               _mm256_extract_epi64(totals, 2) + _mm256_extract_epi64(totals, 3);
+
+            for (; i < count; ++i)
+            {
+               total += __builtin_popcountll(p_words[i]); // NOLINT
+            }
+
+            return total;
+         }
+#endif
+
+         using popcount_kernel = auto (*)(const u64_t*, i64_t) noexcept -> i64_t;
+
+         /**
+          * @brief Position of the nth set bit of word, nth starting from 0.
+          */
+         auto select_in_word(u64_t word, i64_t nth) noexcept -> i64_t
+         {
+            for (; nth > 0; --nth)
+            {
+               word &= word - 1;
+            }
+
+            return std::countr_zero(word);
+         }
+      } // namespace
+
+      auto popcount_words(const u64_t* p_words, i64_t count) noexcept -> i64_t
+      {
+         Expects(count >= 0);
+
+         static const dispatched<popcount_kernel> kernel{
+            {isa_level::scalar, popcount_words_scalar},
+#if defined(LIBCARAMEL_X86_KERNELS)
+            {isa_level::sse4_2, popcount_words_popcnt},
+            {isa_level::avx2, popcount_words_avx2},
+#endif
+         };
+
+         return kernel(p_words, count);
+      }
+   } // namespace detail
+
+   rank_select_index::rank_select_index(const dynamic_bitset& bits) : mp_bits{&bits}
+   {
+      const size_type word_count = bits.word_count();
+      const size_type block_count = (word_count + words_per_block - 1) / words_per_block;
+
+      m_block_ranks.resize(block_count + 1, 0);
+
+      size_type total = 0;
+      for (size_type block = 0; block < block_count; ++block)
+      {
+         m_block_ranks.lookup(block) = total;
+
+         const size_type first = block * words_per_block;
+         const size_type count = std::min(words_per_block, word_count - first);
+         total += detail::popcount_words(bits.words() + first, count); // NOLINT
+      }
+
+      m_block_ranks.lookup(block_count) = total;
+   }
+
+   auto rank_select_index::rank(size_type pos) const -> size_type
+   {
+      Expects(pos >= 0);
+      Expects(pos <= mp_bits->size());
+
+      const size_type block = pos / bits_per_block;
+      const size_type word = pos / dynamic_bitset::bits_per_word;
+      const size_type first_word = block * words_per_block;
+      const u64_t* p_words = mp_bits->words();
+
+      size_type result = m_block_ranks.lookup(block);
+      result += detail::popcount_words(p_words + first_word, word - first_word); // NOLINT
+
+      if (const size_type bit = pos % dynamic_bitset::bits_per_word; bit != 0)
+      {
+         result += std::popcount(p_words[word] & ~(~u64_t{0} << bit)); // NOLINT
+      }
+
+      return result;
+   }
+
+   auto rank_select_index::select(size_type nth) const -> size_type
+   {
+      Expects(nth >= 0);
+
+      const size_type block_count = m_block_ranks.size() - 1;
+      if (nth >= m_block_ranks.lookup(block_count))
+      {
+         return mp_bits->size();
+      }
+
+      // Find the last block whose rank is not greater than nth.
+      const auto* p_ranks = m_block_ranks.data();
+      const auto* p_block = std::upper_bound(p_ranks, p_ranks + block_count, nth) - 1;
+
+      size_type remaining = nth - *p_block;
+      size_type word = (p_block - p_ranks) * words_per_block;
+
+      const u64_t* p_words = mp_bits->words();
+      for (;; ++word)
+      {
+         const auto count = static_cast<size_type>(std::popcount(p_words[word])); // NOLINT
+         if (remaining < count)
+         {
+            return word * dynamic_bitset::bits_per_word +
+               detail::select_in_word(p_words[word], remaining); // NOLINT
+         }
+
+         remaining -= count;
+      }
+   }
+} // namespace caramel
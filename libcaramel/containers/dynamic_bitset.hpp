@@ -0,0 +1,455 @@
+/**
+ * @file containers/dynamic_bitset.hpp
+ * @brief Contains the dynamic_bitset API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace caramel::detail
+{
+   /**
+    * @brief Count the number of set bits in a contiguous range of words.
+    *
+    * @details Uses the widest vector instruction set supported by the running CPU.
+    *
+    * @pre `count >= 0`, otherwise UB
+    *
+    * @param[in] p_words The first word of the range.
+    * @param[in] count The number of words in the range.
+    *
+    * @return The total number of set bits in the range.
+    */
+   auto popcount_words(const u64_t* p_words, i64_t count) noexcept -> i64_t;
+} // namespace caramel::detail
+
+namespace caramel
+{
+   /**
+    * @brief A resizable sequence of bits stored in 64 bit words.
+    *
+    * @details Bulk operations work on whole words at a time. The bits of the last word past
+    * size() are always kept cleared.
+    */
+   class dynamic_bitset
+   {
+   public:
+      using size_type = std::int64_t;
+      using word_type = u64_t;
+
+      static constexpr size_type bits_per_word = std::numeric_limits<word_type>::digits;
+
+   public:
+      /**
+       * @brief Default constructor.
+       */
+      dynamic_bitset() = default;
+      /**
+       * @brief Construct a bitset holding count bits, all set to value.
+       *
+       * @pre `count >= 0`, otherwise UB
+       *
+       * @param[in] count The number of bits.
+       * @param[in] value The value of every bit.
+       */
+      dynamic_bitset(size_type count, bool value = false) { resize(count, value); }
+
+      /**
+       * @brief Access the value of a single bit.
+       *
+       * @pre `pos >= 0`
+       * @pre `pos < size()`
+       *
+       * @param[in] pos The index of the bit.
+       *
+       * @return The value of the bit at pos.
+       */
+      [[nodiscard]] auto test(size_type pos) const -> bool
+      {
+         Expects(pos >= 0);
+         Expects(pos < size());
+
+         return (m_words.lookup(word_index(pos)) & bit_mask(pos)) != 0;
+      }
+      /**
+       * @brief Set the bit at pos to value.
+       *
+       * @pre `pos >= 0`
+       * @pre `pos < size()`
+       */
+      auto set(size_type pos, bool value = true) -> dynamic_bitset&
+      {
+         Expects(pos >= 0);
+         Expects(pos < size());
+
+         auto& word = m_words.lookup(word_index(pos));
+         word = value ? word | bit_mask(pos) : word & ~bit_mask(pos);
+
+         return *this;
+      }
+      /**
+       * @brief Clear the bit at pos.
+       *
+       * @pre `pos >= 0`
+       * @pre `pos < size()`
+       */
+      auto reset(size_type pos) -> dynamic_bitset& { return set(pos, false); }
+      /**
+       * @brief Toggle the bit at pos.
+       *
+       * @pre `pos >= 0`
+       * @pre `pos < size()`
+       */
+      auto flip(size_type pos) -> dynamic_bitset&
+      {
+         Expects(pos >= 0);
+         Expects(pos < size());
+
+         m_words.lookup(word_index(pos)) ^= bit_mask(pos);
+
+         return *this;
+      }
+      /**
+       * @brief Set every bit.
+       */
+      auto set() -> dynamic_bitset&
+      {
+         std::fill_n(words(), word_count(), ~word_type{0});
+         clear_unused_bits();
+
+         return *this;
+      }
+      /**
+       * @brief Clear every bit.
+       */
+      auto reset() -> dynamic_bitset&
+      {
+         std::fill_n(words(), word_count(), word_type{0});
+
+         return *this;
+      }
+      /**
+       * @brief Toggle every bit.
+       */
+      auto flip() -> dynamic_bitset&
+      {
+         word_type* p_words = words();
+         for (size_type i = 0; i < word_count(); ++i)
+         {
+            p_words[i] = ~p_words[i]; // NOLINT
+         }
+
+         clear_unused_bits();
+
+         return *this;
+      }
+
+      /**
+       * @brief Perform a bitwise AND with the bits of other.
+       *
+       * @pre `size() == other.size()`
+       */
+      auto operator&=(const dynamic_bitset& other) -> dynamic_bitset&
+      {
+         return apply(other, [](word_type lhs, word_type rhs) {
+            return lhs & rhs;
+         });
+      }
+      /**
+       * @brief Perform a bitwise OR with the bits of other.
+       *
+       * @pre `size() == other.size()`
+       */
+      auto operator|=(const dynamic_bitset& other) -> dynamic_bitset&
+      {
+         return apply(other, [](word_type lhs, word_type rhs) {
+            return lhs | rhs;
+         });
+      }
+      /**
+       * @brief Perform a bitwise XOR with the bits of other.
+       *
+       * @pre `size() == other.size()`
+       */
+      auto operator^=(const dynamic_bitset& other) -> dynamic_bitset&
+      {
+         return apply(other, [](word_type lhs, word_type rhs) {
+            return lhs ^ rhs;
+         });
+      }
+      /**
+       * @brief Perform a bitwise AND NOT with the bits of other, clearing every bit set in other.
+       *
+       * @pre `size() == other.size()`
+       */
+      auto difference(const dynamic_bitset& other) -> dynamic_bitset&
+      {
+         return apply(other, [](word_type lhs, word_type rhs) {
+            return lhs & ~rhs;
+         });
+      }
+      /**
+       * @brief Return a copy of the bitset with every bit toggled.
+       */
+      auto operator~() const -> dynamic_bitset
+      {
+         dynamic_bitset result = *this;
+         result.flip();
+
+         return result;
+      }
+
+      /**
+       * @brief Count the number of set bits.
+       */
+      [[nodiscard]] auto count() const noexcept -> size_type
+      {
+         return detail::popcount_words(words(), word_count());
+      }
+      /**
+       * @brief Check if at least one bit is set.
+       */
+      [[nodiscard]] auto any() const noexcept -> bool
+      {
+         return std::any_of(words(), words() + word_count(), [](word_type word) {
+            return word != 0;
+         });
+      }
+      /**
+       * @brief Check if no bits are set.
+       */
+      [[nodiscard]] auto none() const noexcept -> bool { return not any(); }
+      /**
+       * @brief Check if every bit is set.
+       */
+      [[nodiscard]] auto all() const noexcept -> bool { return count() == size(); }
+
+      /**
+       * @brief Find the index of the first set bit.
+       *
+       * @return The index of the first set bit, or size() if no bits are set.
+       */
+      [[nodiscard]] auto find_first() const noexcept -> size_type { return find_from_word(0); }
+      /**
+       * @brief Find the index of the first set bit strictly after pos.
+       *
+       * @pre `pos >= 0`
+       *
+       * @return The index of the next set bit, or size() if no bits are set after pos.
+       */
+      [[nodiscard]] auto find_next(size_type pos) const -> size_type
+      {
+         Expects(pos >= 0);
+
+         const size_type next = pos + 1;
+         if (next >= size())
+         {
+            return size();
+         }
+
+         const size_type index = word_index(next);
+         const word_type mask = ~word_type{0} << (next % bits_per_word);
+         const word_type word = words()[index] & mask; // NOLINT
+         if (word != 0)
+         {
+            return index * bits_per_word + std::countr_zero(word);
+         }
+
+         return find_from_word(index + 1);
+      }
+
+      /**
+       * @brief Check if the bitset holds no bits.
+       */
+      [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+      /**
+       * @brief Check the number of bits stored in the bitset.
+       */
+      [[nodiscard]] auto size() const noexcept -> size_type { return m_size; }
+      /**
+       * @brief Check the number of words used to store the bits.
+       */
+      [[nodiscard]] auto word_count() const noexcept -> size_type { return m_words.size(); }
+      /**
+       * @brief Access the underlying words. Bit i is stored in word i / 64 at position i % 64.
+       */
+      auto words() noexcept -> word_type* { return m_words.data(); }
+      /**
+       * @brief Access the underlying words. Bit i is stored in word i / 64 at position i % 64.
+       */
+      [[nodiscard]] auto words() const noexcept -> const word_type* { return m_words.data(); }
+
+      /**
+       * @brief Append a bit at the end of the bitset.
+       */
+      void append(bool value)
+      {
+         if (m_size % bits_per_word == 0)
+         {
+            m_words.resize(m_words.size() + 1, word_type{0});
+         }
+
+         ++m_size;
+         set(m_size - 1, value);
+      }
+      /**
+       * @brief Resize the bitset to count bits. New bits are set to value.
+       *
+       * @pre `count >= 0`
+       */
+      void resize(size_type count, bool value = false)
+      {
+         Expects(count >= 0);
+
+         const size_type old_size = m_size;
+         const word_type fill = value ? ~word_type{0} : word_type{0};
+
+         if (value && old_size % bits_per_word != 0 && count > old_size)
+         {
+            m_words.lookup(word_index(old_size)) |= ~word_type{0} << (old_size % bits_per_word);
+         }
+
+         m_words.resize(words_for(count), fill);
+         m_size = count;
+
+         clear_unused_bits();
+      }
+      /**
+       * @brief Remove every bit from the bitset.
+       */
+      void clear()
+      {
+         m_words.clear();
+         m_size = 0;
+      }
+
+      friend auto operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs) -> bool
+      {
+         return lhs.size() == rhs.size() &&
+            std::equal(lhs.words(), lhs.words() + lhs.word_count(), rhs.words());
+      }
+
+   private:
+      static constexpr auto word_index(size_type pos) noexcept -> size_type
+      {
+         return pos / bits_per_word;
+      }
+      static constexpr auto bit_mask(size_type pos) noexcept -> word_type
+      {
+         return word_type{1} << (pos % bits_per_word);
+      }
+      static constexpr auto words_for(size_type bit_count) noexcept -> size_type
+      {
+         return (bit_count + bits_per_word - 1) / bits_per_word;
+      }
+
+      template <typename Operation>
+      auto apply(const dynamic_bitset& other, Operation operation) -> dynamic_bitset&
+      {
+         Expects(size() == other.size());
+
+         word_type* p_lhs = words();
+         const word_type* p_rhs = other.words();
+         for (size_type i = 0; i < word_count(); ++i)
+         {
+            p_lhs[i] = operation(p_lhs[i], p_rhs[i]); // NOLINT
+         }
+
+         return *this;
+      }
+
+      [[nodiscard]] auto find_from_word(size_type index) const noexcept -> size_type
+      {
+         const word_type* p_words = words();
+         for (; index < word_count(); ++index)
+         {
+            if (p_words[index] != 0) // NOLINT
+            {
+               return index * bits_per_word + std::countr_zero(p_words[index]); // NOLINT
+            }
+         }
+
+         return size();
+      }
+
+      void clear_unused_bits() noexcept
+      {
+         if (const size_type used = m_size % bits_per_word; used != 0)
+         {
+            words()[word_count() - 1] &= ~(~word_type{0} << used); // NOLINT
+         }
+      }
+
+   private:
+      dynamic_array<word_type> m_words;
+      size_type m_size{0};
+   };
+
+   inline auto operator&(dynamic_bitset lhs, const dynamic_bitset& rhs) -> dynamic_bitset
+   {
+      return lhs &= rhs;
+   }
+   inline auto operator|(dynamic_bitset lhs, const dynamic_bitset& rhs) -> dynamic_bitset
+   {
+      return lhs |= rhs;
+   }
+   inline auto operator^(dynamic_bitset lhs, const dynamic_bitset& rhs) -> dynamic_bitset
+   {
+      return lhs ^= rhs;
+   }
+
+   /**
+    * @brief A succinct index answering rank and select queries over a dynamic_bitset.
+    *
+    * @details Stores the number of set bits preceding every block of 512 bits, which costs 12.5%
+    * of the size of the bitset. The index refers to the bitset it was built from and must be
+    * rebuilt whenever that bitset is modified.
+    */
+   class rank_select_index
+   {
+   public:
+      using size_type = dynamic_bitset::size_type;
+
+      static constexpr size_type words_per_block = 8;
+      static constexpr size_type bits_per_block = words_per_block * dynamic_bitset::bits_per_word;
+
+   public:
+      /**
+       * @brief Build the index for bits.
+       *
+       * @param[in] bits The bitset to index. Must outlive the index.
+       */
+      rank_select_index(const dynamic_bitset& bits);
+
+      /**
+       * @brief Count the number of set bits in [0, pos).
+       *
+       * @pre `pos >= 0`
+       * @pre `pos <= size()` of the indexed bitset
+       */
+      [[nodiscard]] auto rank(size_type pos) const -> size_type;
+      /**
+       * @brief Find the position of the nth set bit, starting from 0.
+       *
+       * @pre `nth >= 0`
+       *
+       * @return The position of the nth set bit, or the size of the bitset if it holds fewer than
+       * nth + 1 set bits.
+       */
+      [[nodiscard]] auto select(size_type nth) const -> size_type;
+
+   private:
+      const dynamic_bitset* mp_bits;
+      dynamic_array<size_type> m_block_ranks;
+   };
+} // namespace caramel
@@ -0,0 +1,239 @@
+#include <libcaramel/containers/mapped_array.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace caramel::detail
+{
+   namespace
+   {
+      constexpr std::array<char, 8> magic{'C', 'R', 'M', 'L', 'M', 'A', 'P', '1'};
+
+      struct file_header
+      {
+         std::array<char, 8> magic;
+         i64_t element_size;
+         i64_t element_alignment;
+         i64_t size;
+      };
+
+      static_assert(sizeof(file_header) <= mapped_storage::data_offset);
+
+      [[noreturn]] void throw_errno(const char* what)
+      {
+         throw std::system_error(errno, std::generic_category(), what);
+      }
+
+      auto header_of(std::byte* p_mapping) noexcept -> file_header*
+      {
+         return reinterpret_cast<file_header*>(p_mapping); // NOLINT
+      }
+
+      auto file_size(i64_t element_size, i64_t capacity) noexcept -> i64_t
+      {
+         return mapped_storage::data_offset + element_size * capacity;
+      }
+   } // namespace
+
+   auto mapped_storage::create(const std::filesystem::path& path, i64_t element_size,
+                               i64_t element_alignment, i64_t capacity) -> mapped_storage
+   {
+      mapped_storage storage;
+      storage.m_element_size = element_size;
+      storage.m_writable = true;
+      storage.m_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (storage.m_descriptor == -1)
+      {
+         throw_errno("mapped_array: open");
+      }
+
+      const i64_t length = file_size(element_size, capacity);
+      if (::ftruncate(storage.m_descriptor, length) == -1)
+      {
+         throw_errno("mapped_array: ftruncate");
+      }
+
+      storage.map(length);
+
+      *header_of(storage.mp_mapping) = file_header{magic, element_size, element_alignment, 0};
+
+      return storage;
+   }
+   auto mapped_storage::open(const std::filesystem::path& path, i64_t element_size,
+                             i64_t element_alignment, map_mode mode) -> mapped_storage
+   {
+      mapped_storage storage;
+      storage.m_element_size = element_size;
+      storage.m_writable = mode == map_mode::read_write;
+      storage.m_descriptor =
+         ::open(path.c_str(), (storage.m_writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+      if (storage.m_descriptor == -1)
+      {
+         throw_errno("mapped_array: open");
+      }
+
+      struct stat status{};
+      if (::fstat(storage.m_descriptor, &status) == -1)
+      {
+         throw_errno("mapped_array: fstat");
+      }
+
+      const auto length = static_cast<i64_t>(status.st_size);
+      if (length < data_offset)
+      {
+         throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                 "mapped_array: file is too small to hold a header");
+      }
+
+      storage.map(length);
+
+      const file_header* p_header = header_of(storage.mp_mapping);
+      if (p_header->magic != magic)
+      {
+         throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                 "mapped_array: file was not created by a mapped_array");
+      }
+      if (p_header->element_size != element_size ||
+          p_header->element_alignment != element_alignment)
+      {
+         throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                 "mapped_array: file holds elements of a different type");
+      }
+      if (p_header->size < 0 || p_header->size > storage.capacity())
+      {
+         throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                 "mapped_array: file is truncated");
+      }
+
+      return storage;
+   }
+
+   mapped_storage::mapped_storage(mapped_storage&& other) noexcept :
+      m_descriptor{std::exchange(other.m_descriptor, -1)},
+      mp_mapping{std::exchange(other.mp_mapping, nullptr)},
+      m_mapping_size{std::exchange(other.m_mapping_size, 0)},
+      m_element_size{other.m_element_size}, m_writable{other.m_writable}
+   {}
+   mapped_storage::~mapped_storage() noexcept { close(); }
+
+   auto mapped_storage::operator=(mapped_storage&& rhs) noexcept -> mapped_storage&
+   {
+      if (this != &rhs)
+      {
+         close();
+
+         m_descriptor = std::exchange(rhs.m_descriptor, -1);
+         mp_mapping = std::exchange(rhs.mp_mapping, nullptr);
+         m_mapping_size = std::exchange(rhs.m_mapping_size, 0);
+         m_element_size = rhs.m_element_size;
+         m_writable = rhs.m_writable;
+      }
+
+      return *this;
+   }
+
+   auto mapped_storage::data() const noexcept -> std::byte*
+   {
+      return mp_mapping ? mp_mapping + data_offset : nullptr; // NOLINT
+   }
+   auto mapped_storage::size() const noexcept -> i64_t
+   {
+      return mp_mapping ? header_of(mp_mapping)->size : 0;
+   }
+   auto mapped_storage::capacity() const noexcept -> i64_t
+   {
+      return mp_mapping ? (m_mapping_size - data_offset) / m_element_size : 0;
+   }
+
+   void mapped_storage::set_size(i64_t size) noexcept
+   {
+      Expects(m_writable);
+      Expects(size >= 0 && size <= capacity());
+
+      header_of(mp_mapping)->size = size;
+   }
+   void mapped_storage::reserve(i64_t new_capacity)
+   {
+      Expects(m_writable);
+
+      const i64_t length = file_size(m_element_size, new_capacity);
+      if (length <= m_mapping_size)
+      {
+         return;
+      }
+
+      if (::ftruncate(m_descriptor, length) == -1)
+      {
+         throw_errno("mapped_array: ftruncate");
+      }
+
+#if defined(__linux__)
+      void* p_mapping = ::mremap(mp_mapping, static_cast<std::size_t>(m_mapping_size),
+                                 static_cast<std::size_t>(length), MREMAP_MAYMOVE);
+      if (p_mapping == MAP_FAILED) // NOLINT
+      {
+         throw_errno("mapped_array: mremap");
+      }
+
+      mp_mapping = static_cast<std::byte*>(p_mapping);
+      m_mapping_size = length;
+#else
+      // The file keeps every byte, only the view of it is replaced.
+      ::munmap(mp_mapping, static_cast<std::size_t>(m_mapping_size));
+      mp_mapping = nullptr;
+      m_mapping_size = 0;
+
+      map(length);
+#endif
+   }
+   void mapped_storage::flush(bool wait)
+   {
+      if (!mp_mapping || !m_writable)
+      {
+         return;
+      }
+
+      if (::msync(mp_mapping, static_cast<std::size_t>(m_mapping_size),
+                  wait ? MS_SYNC : MS_ASYNC) == -1)
+      {
+         throw_errno("mapped_array: msync");
+      }
+   }
+
+   void mapped_storage::close() noexcept
+   {
+      if (mp_mapping)
+      {
+         ::munmap(mp_mapping, static_cast<std::size_t>(m_mapping_size));
+         mp_mapping = nullptr;
+         m_mapping_size = 0;
+      }
+
+      if (m_descriptor != -1)
+      {
+         ::close(m_descriptor);
+         m_descriptor = -1;
+      }
+   }
+   void mapped_storage::map(i64_t length)
+   {
+      const int protection = m_writable ? PROT_READ | PROT_WRITE : PROT_READ; // NOLINT
+      void* p_mapping = ::mmap(nullptr, static_cast<std::size_t>(length), protection, MAP_SHARED,
+                               m_descriptor, 0);
+      if (p_mapping == MAP_FAILED) // NOLINT
+      {
+         throw_errno("mapped_array: mmap");
+      }
+
+      mp_mapping = static_cast<std::byte*>(p_mapping);
+      m_mapping_size = length;
+   }
+} // namespace caramel::detail
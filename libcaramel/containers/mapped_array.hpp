@@ -0,0 +1,398 @@
+/**
+ * @file containers/mapped_array.hpp
+ * @brief Contains the mapped_array API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/iterators/random_iterator.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <type_traits>
+
+namespace caramel
+{
+   /**
+    * @brief How a mapped_array accesses its file.
+    */
+   enum struct map_mode
+   {
+      read_only,
+      read_write
+   };
+
+   namespace detail
+   {
+      /**
+       * @brief Type independent part of a mapped_array: the file, its mapping and its header.
+       *
+       * @details The file starts with a header of `data_offset` bytes recording a magic number,
+       * the size and alignment of the elements and the number of elements stored. The elements
+       * follow, so the size persists with the data and a file reopened with a different element
+       * type is rejected.
+       */
+      class mapped_storage
+      {
+      public:
+         static constexpr i64_t data_offset = 64;
+
+      public:
+         /**
+          * @brief Create, or truncate, a file able to hold `capacity` elements.
+          *
+          * @throws std::system_error If the file could not be created or mapped.
+          */
+         static auto create(const std::filesystem::path& path, i64_t element_size,
+                            i64_t element_alignment, i64_t capacity) -> mapped_storage;
+         /**
+          * @brief Map an existing file.
+          *
+          * @throws std::system_error If the file could not be mapped or was not written for
+          * elements of that size and alignment.
+          */
+         static auto open(const std::filesystem::path& path, i64_t element_size,
+                          i64_t element_alignment, map_mode mode) -> mapped_storage;
+
+         mapped_storage() noexcept = default;
+         mapped_storage(const mapped_storage&) = delete;
+         mapped_storage(mapped_storage&& other) noexcept;
+         ~mapped_storage() noexcept;
+
+         auto operator=(const mapped_storage&) -> mapped_storage& = delete;
+         auto operator=(mapped_storage&& rhs) noexcept -> mapped_storage&;
+
+         [[nodiscard]] auto data() const noexcept -> std::byte*;
+         [[nodiscard]] auto size() const noexcept -> i64_t;
+         [[nodiscard]] auto capacity() const noexcept -> i64_t;
+         [[nodiscard]] auto is_writable() const noexcept -> bool { return m_writable; }
+
+         void set_size(i64_t size) noexcept;
+         /**
+          * @brief Grow the file and its mapping to hold at least `new_capacity` elements.
+          *
+          * @throws std::system_error If the file could not be resized or remapped.
+          */
+         void reserve(i64_t new_capacity);
+         /**
+          * @brief Write the dirty pages back to the file.
+          *
+          * @throws std::system_error If the pages could not be written.
+          */
+         void flush(bool wait);
+
+      private:
+         void close() noexcept;
+         void map(i64_t length);
+
+      private:
+         int m_descriptor{-1};
+         std::byte* mp_mapping{nullptr};
+         i64_t m_mapping_size{0};
+         i64_t m_element_size{0};
+         bool m_writable{false};
+      };
+   } // namespace detail
+
+   /**
+    * @brief An array of trivially copyable elements stored in a memory mapped file.
+    *
+    * @details Opening a mapped_array maps the file and does nothing else, the elements are paged
+    * in by the OS on first access, so loading a large table is near instant compared to decoding
+    * it into a dynamic_array. The read API mirrors the one of dynamic_array. When opened for
+    * writing, the array can grow: the file is extended and remapped, which invalidates every
+    * pointer and iterator, like a reallocation would. Writes reach the file at the latest when
+    * the array is destroyed; flush() forces them to disk.
+    *
+    * @tparam Any The type of the elements, stored as their raw bytes.
+    */
+   template <typename Any>
+      requires std::is_trivially_copyable_v<Any>
+   class mapped_array
+   {
+      static_assert(alignof(Any) <= detail::mapped_storage::data_offset,
+                    "elements are stored at a 64 byte offset from the start of the file");
+
+   public:
+      using value_type = Any;
+      using size_type = std::int64_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using pointer = value_type*;
+      using const_pointer = const value_type*;
+      using iterator = random_access_iterator<value_type>;
+      using const_iterator = random_access_iterator<const value_type>;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+   public:
+      /**
+       * @brief Create an empty array in a new file, replacing any existing file at path.
+       *
+       * @pre `capacity >= 0`, otherwise UB
+       *
+       * @param[in] path The file to create.
+       * @param[in] capacity The number of elements to reserve space for.
+       *
+       * @throws std::system_error If the file could not be created or mapped.
+       */
+      static auto create(const std::filesystem::path& path, size_type capacity = 0)
+         -> mapped_array
+      {
+         Expects(capacity >= 0);
+
+         return mapped_array{detail::mapped_storage::create(path, sizeof(value_type),
+                                                            alignof(value_type), capacity)};
+      }
+      /**
+       * @brief Map an array previously created with create().
+       *
+       * @param[in] path The file to map.
+       * @param[in] mode Whether the array may be modified.
+       *
+       * @throws std::system_error If the file could not be mapped or was not written for
+       * elements of that size and alignment.
+       */
+      static auto open(const std::filesystem::path& path, map_mode mode = map_mode::read_only)
+         -> mapped_array
+      {
+         return mapped_array{detail::mapped_storage::open(path, sizeof(value_type),
+                                                          alignof(value_type), mode)};
+      }
+
+      mapped_array(const mapped_array&) = delete;
+      mapped_array(mapped_array&&) noexcept = default;
+      ~mapped_array() noexcept = default;
+
+      auto operator=(const mapped_array&) -> mapped_array& = delete;
+      auto operator=(mapped_array&&) noexcept -> mapped_array& = default;
+
+      /**
+       * @brief Access the object stored at a specific index. Writing through the reference of a
+       * read only array is UB.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      auto lookup(size_type index) -> reference
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return data()[index]; // NOLINT
+      }
+      /**
+       * @brief Access the object stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      [[nodiscard]] auto lookup(size_type index) const -> const_reference
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return data()[index]; // NOLINT
+      }
+
+      /**
+       * @brief Access the underlying array. Writing through the pointer of a read only array is
+       * UB.
+       */
+      auto data() noexcept -> pointer
+      {
+         return reinterpret_cast<pointer>(m_storage.data()); // NOLINT
+      }
+      /**
+       * @brief Access the underlying array.
+       */
+      [[nodiscard]] auto data() const noexcept -> const_pointer
+      {
+         return reinterpret_cast<const_pointer>(m_storage.data()); // NOLINT
+      }
+
+      auto begin() noexcept -> iterator { return iterator{data()}; }
+      [[nodiscard]] auto begin() const noexcept -> const_iterator { return const_iterator{data()}; }
+      [[nodiscard]] auto cbegin() const noexcept -> const_iterator { return begin(); }
+      auto end() noexcept -> iterator { return iterator{data() + size()}; }
+      [[nodiscard]] auto end() const noexcept -> const_iterator
+      {
+         return const_iterator{data() + size()};
+      }
+      [[nodiscard]] auto cend() const noexcept -> const_iterator { return end(); }
+      auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+      [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{end()};
+      }
+      [[nodiscard]] auto rcbegin() const noexcept -> const_reverse_iterator { return rbegin(); }
+      auto rend() noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+      [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{begin()};
+      }
+      [[nodiscard]] auto rcend() const noexcept -> const_reverse_iterator { return rend(); }
+
+      /**
+       * @brief Check if the array is empty.
+       */
+      [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+      /**
+       * @brief Check the number of elements stored in the array.
+       */
+      [[nodiscard]] auto size() const noexcept -> size_type { return m_storage.size(); }
+      /**
+       * @brief Check the number of elements the file currently has space for.
+       */
+      [[nodiscard]] auto capacity() const noexcept -> size_type { return m_storage.capacity(); }
+      /**
+       * @brief Check if the array was opened for writing.
+       */
+      [[nodiscard]] auto is_writable() const noexcept -> bool { return m_storage.is_writable(); }
+
+      /**
+       * @brief Grow the file to hold at least new_cap elements, invalidating every iterator.
+       *
+       * @pre `is_writable()`
+       *
+       * @throws std::system_error If the file could not be resized or remapped.
+       */
+      void reserve(size_type new_cap)
+      {
+         Expects(is_writable());
+
+         if (new_cap > capacity())
+         {
+            m_storage.reserve(new_cap);
+         }
+      }
+      /**
+       * @brief Erase all elements. The file keeps its capacity.
+       *
+       * @pre `is_writable()`
+       */
+      void clear() noexcept
+      {
+         Expects(is_writable());
+
+         m_storage.set_size(0);
+      }
+
+      /**
+       * @brief Append a copy of value at the end of the array, growing the file if needed.
+       *
+       * @pre `is_writable()`
+       *
+       * @throws std::system_error If the file could not be resized or remapped.
+       */
+      void append(const value_type& value)
+      {
+         Expects(is_writable());
+
+         if (size() == capacity())
+         {
+            // value may live in the mapping that is about to move.
+            const value_type copy = value;
+            grow(size() + 1);
+            std::memcpy(data() + size(), &copy, sizeof(value_type)); // NOLINT
+         }
+         else
+         {
+            std::memcpy(data() + size(), &value, sizeof(value_type)); // NOLINT
+         }
+
+         m_storage.set_size(size() + 1);
+      }
+      /**
+       * @brief Append the elements of the range [first, last) at the end of the array.
+       *
+       * @pre `is_writable()`
+       *
+       * @throws std::system_error If the file could not be resized or remapped.
+       */
+      template <std::forward_iterator It>
+      void append(It first, It last)
+      {
+         Expects(is_writable());
+
+         const auto count = static_cast<size_type>(std::distance(first, last));
+         if (size() + count > capacity())
+         {
+            grow(size() + count);
+         }
+
+         std::copy(first, last, data() + size());
+         m_storage.set_size(size() + count);
+      }
+      /**
+       * @brief Remove the last element.
+       *
+       * @pre `is_writable()`
+       * @pre `!empty()`
+       */
+      void pop_back() noexcept
+      {
+         Expects(is_writable());
+         Expects(!empty());
+
+         m_storage.set_size(size() - 1);
+      }
+      /**
+       * @brief Resize the array to count elements, new elements are value initialized.
+       *
+       * @pre `is_writable()`
+       * @pre `count >= 0`
+       *
+       * @throws std::system_error If the file could not be resized or remapped.
+       */
+      void resize(size_type count)
+      {
+         Expects(is_writable());
+         Expects(count >= 0);
+
+         if (count > capacity())
+         {
+            grow(count);
+         }
+
+         if (count > size())
+         {
+            std::fill(data() + size(), data() + count, value_type{});
+         }
+
+         m_storage.set_size(count);
+      }
+
+      /**
+       * @brief Write every modification back to the file before returning.
+       *
+       * @throws std::system_error If the pages could not be written.
+       */
+      void flush() { m_storage.flush(true); }
+      /**
+       * @brief Schedule every modification to be written back to the file.
+       *
+       * @throws std::system_error If the pages could not be scheduled.
+       */
+      void flush_async() { m_storage.flush(false); }
+
+   private:
+      mapped_array(detail::mapped_storage&& storage) noexcept : m_storage{std::move(storage)} {}
+
+      void grow(size_type min_size)
+      {
+         m_storage.reserve(std::max(min_size, capacity() * 2));
+      }
+
+   private:
+      detail::mapped_storage m_storage;
+   };
+} // namespace caramel
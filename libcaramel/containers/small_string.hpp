@@ -0,0 +1,484 @@
+/**
+ * @file containers/small_string.hpp
+ * @brief Contains the small_string API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/memory_allocator.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<format>)
+#   include <format>
+#endif
+
+namespace caramel
+{
+   /**
+    * @brief A null terminated string with a small statically allocated storage buffer.
+    *
+    * @details Strings of up to Size characters are stored inline, longer strings are allocated
+    * through the memory_resource of the allocator. The characters are always followed by a null
+    * character, so c_str() never has to copy.
+    *
+    * @tparam Size The number of characters, excluding the null terminator, stored inline.
+    */
+   template <i64_t Size>
+   class small_string
+   {
+      using underlying_type = basic_dynamic_array<char, Size + 1, memory_allocator<char>>;
+
+   public:
+      using value_type = char;
+      using size_type = typename underlying_type::size_type;
+      using difference_type = std::ptrdiff_t;
+      using allocator_type = typename underlying_type::allocator_type;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using pointer = value_type*;
+      using const_pointer = const value_type*;
+      using iterator = typename underlying_type::iterator;
+      using const_iterator = typename underlying_type::const_iterator;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+      /**
+       * @brief Output iterator appending every character written through it to a small_string.
+       * Can be handed to std::format_to, std::copy and similar algorithms.
+       */
+      class appender
+      {
+      public:
+         using iterator_category = std::output_iterator_tag;
+         using value_type = void;
+         using difference_type = std::ptrdiff_t;
+         using pointer = void;
+         using reference = void;
+
+      public:
+         constexpr appender() noexcept = default;
+         constexpr explicit appender(small_string& str) noexcept : mp_string{&str} {}
+
+         constexpr auto operator=(char value) -> appender&
+         {
+            mp_string->append(value);
+            return *this;
+         }
+
+         constexpr auto operator*() noexcept -> appender& { return *this; }
+         constexpr auto operator++() noexcept -> appender& { return *this; }
+         constexpr auto operator++(int) noexcept -> appender { return *this; }
+
+      private:
+         small_string* mp_string{nullptr};
+      };
+
+   public:
+      /**
+       * @brief Default constructor.
+       */
+      constexpr small_string() { m_chars.append(in_place, '\0'); }
+      /**
+       * @brief Construct an empty string with a given allocator
+       *
+       * @param[in] allocator The allocator to use for all memory allocations of this string.
+       */
+      constexpr small_string(const allocator_type& allocator) : m_chars{allocator}
+      {
+         m_chars.append(in_place, '\0');
+      }
+      /**
+       * @brief Construct the string with a copy of the characters in str.
+       *
+       * @param[in] str The characters to copy.
+       * @param[in] allocator The allocator to use for all memory allocations of this string.
+       */
+      constexpr small_string(std::string_view str,
+                             const allocator_type& allocator = allocator_type{}) :
+         small_string(allocator)
+      {
+         append(str);
+      }
+      /**
+       * @brief Construct the string with a copy of the null terminated string p_str.
+       *
+       * @pre `p_str != nullptr`
+       *
+       * @param[in] p_str The characters to copy.
+       * @param[in] allocator The allocator to use for all memory allocations of this string.
+       */
+      constexpr small_string(const char* p_str,
+                             const allocator_type& allocator = allocator_type{}) :
+         small_string(std::string_view{p_str}, allocator)
+      {}
+      /**
+       * @brief Construct the string with count copies of the character value.
+       *
+       * @pre `count >= 0`
+       *
+       * @param[in] count The number of characters.
+       * @param[in] value The character to repeat.
+       * @param[in] allocator The allocator to use for all memory allocations of this string.
+       */
+      constexpr small_string(size_type count, char value,
+                             const allocator_type& allocator = allocator_type{}) :
+         small_string(allocator)
+      {
+         append(count, value);
+      }
+      /**
+       * @brief Construct the string using the contents of other.
+       */
+      constexpr small_string(const small_string& other) = default;
+      /**
+       * @brief Construct the string with the contents of the other using move semantic. After
+       * move, other is guarenteed to be empty().
+       */
+      constexpr small_string(small_string&& other) noexcept : m_chars{std::move(other.m_chars)}
+      {
+         other.m_chars.append(in_place, '\0');
+      }
+      /**
+       * @brief Construct the string using the contents of other, using allocator as the
+       * allocator.
+       */
+      constexpr small_string(const small_string& other, const allocator_type& allocator) :
+         m_chars(other.m_chars, allocator)
+      {}
+      /**
+       * @brief Construct the string with the contents of the other using move semantic, using
+       * allocator as the allocator. After move, other is guarenteed to be empty().
+       */
+      constexpr small_string(small_string&& other, const allocator_type& allocator) :
+         m_chars(std::move(other.m_chars), allocator)
+      {
+         other.m_chars.append(in_place, '\0');
+      }
+      constexpr ~small_string() = default;
+
+      /**
+       * @brief Replaces the contents with an copy of the contents of rhs.
+       */
+      constexpr auto operator=(const small_string& rhs) -> small_string& = default;
+      /**
+       * @brief Replaces the contents with those of other using move semantics, keeping the
+       * allocator of the string. After the move, rhs is guarenteed to be empty().
+       */
+      constexpr auto operator=(small_string&& rhs) noexcept(
+         std::is_nothrow_move_assignable_v<underlying_type>) -> small_string&
+      {
+         if (this != &rhs)
+         {
+            m_chars = std::move(rhs.m_chars);
+            rhs.m_chars.append(in_place, '\0');
+         }
+
+         return *this;
+      }
+      /**
+       * @brief Replaces the contents with a copy of the characters in str.
+       */
+      constexpr auto operator=(std::string_view str) -> small_string&
+      {
+         clear();
+         append(str);
+
+         return *this;
+      }
+
+      /**
+       * @brief Returns the allocator associated with the string.
+       *
+       * @return The associated allocator.
+       */
+      constexpr auto allocator() const noexcept -> allocator_type { return m_chars.allocator(); }
+
+      /**
+       * @brief Access the character stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      constexpr auto lookup(size_type index) -> reference
+      {
+         Expects(index < size());
+
+         return m_chars.lookup(index);
+      }
+      /**
+       * @brief Access the character stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      constexpr auto lookup(size_type index) const -> const_reference
+      {
+         Expects(index < size());
+
+         return m_chars.lookup(index);
+      }
+
+      /**
+       * @brief Access the characters of the string. The characters are followed by a null
+       * character.
+       */
+      constexpr auto data() noexcept -> pointer { return m_chars.data(); }
+      /**
+       * @brief Access the characters of the string. The characters are followed by a null
+       * character.
+       */
+      constexpr auto data() const noexcept -> const_pointer { return m_chars.data(); }
+      /**
+       * @brief Access the characters of the string as a null terminated C string.
+       */
+      constexpr auto c_str() const noexcept -> const_pointer { return m_chars.data(); }
+      /**
+       * @brief Access the characters of the string as a std::string_view.
+       */
+      constexpr auto view() const noexcept -> std::string_view
+      {
+         return {data(), static_cast<std::size_t>(size())};
+      }
+      constexpr operator std::string_view() const noexcept { return view(); }
+
+      /**
+       * @brief Returns an iterator to the first character of the string.
+       */
+      constexpr auto begin() noexcept -> iterator { return m_chars.begin(); }
+      /**
+       * @brief Returns an iterator to the first character of the string.
+       */
+      constexpr auto begin() const noexcept -> const_iterator { return m_chars.begin(); }
+      /**
+       * @brief Returns an iterator to the first character of the string.
+       */
+      constexpr auto cbegin() const noexcept -> const_iterator { return m_chars.cbegin(); }
+
+      /**
+       * @brief Returns an iterator to the null terminator following the last character.
+       */
+      constexpr auto end() noexcept -> iterator { return m_chars.end() - 1; }
+      /**
+       * @brief Returns an iterator to the null terminator following the last character.
+       */
+      constexpr auto end() const noexcept -> const_iterator { return m_chars.end() - 1; }
+      /**
+       * @brief Returns an iterator to the null terminator following the last character.
+       */
+      constexpr auto cend() const noexcept -> const_iterator { return m_chars.cend() - 1; }
+
+      /**
+       * @brief Returns a reverse iterator to the last character of the string.
+       */
+      constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+      /**
+       * @brief Returns a reverse iterator to the last character of the string.
+       */
+      constexpr auto rbegin() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{end()};
+      }
+      /**
+       * @brief Returns a reverse iterator to the character preceding the first character.
+       */
+      constexpr auto rend() noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+      /**
+       * @brief Returns a reverse iterator to the character preceding the first character.
+       */
+      constexpr auto rend() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{begin()};
+      }
+
+      /**
+       * @brief Check if the string holds no characters.
+       */
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size() == 0; };
+      /**
+       * @brief Check the number of characters in the string, excluding the null terminator.
+       */
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type
+      {
+         return m_chars.size() - 1;
+      };
+      /**
+       * @brief Check the number of characters the string can hold without allocating.
+       */
+      [[nodiscard]] constexpr auto capacity() const noexcept -> size_type
+      {
+         return m_chars.capacity() - 1;
+      };
+      /**
+       * @brief Increase the capacity of the string to a value that's greater or equal to new_cap.
+       *
+       * @param new_cap New capacity of the string, excluding the null terminator.
+       */
+      constexpr void reserve(size_type new_cap) { m_chars.reserve(new_cap + 1); }
+
+      /**
+       * @brief Removes every character from the string.
+       */
+      constexpr void clear() noexcept
+      {
+         m_chars.resize(1);
+         m_chars.lookup(0) = '\0';
+      }
+
+      /**
+       * @brief Appends a single character to the end of the string.
+       */
+      constexpr void append(char value)
+      {
+         m_chars.lookup(size()) = value;
+         m_chars.append(in_place, '\0');
+      }
+      /**
+       * @brief Appends count copies of the character value to the end of the string.
+       *
+       * @pre `count >= 0`
+       */
+      constexpr void append(size_type count, char value)
+      {
+         Expects(count >= 0);
+
+         const size_type old_size = size();
+
+         m_chars.resize(old_size + count + 1, '\0');
+         std::fill_n(m_chars.begin() + old_size, count, value);
+      }
+      /**
+       * @brief Appends a copy of the characters in str to the end of the string. Allocates at
+       * most once.
+       */
+      constexpr void append(std::string_view str)
+      {
+         const size_type old_size = size();
+         const auto count = static_cast<size_type>(str.size());
+
+         // str may view the characters of this string, which a reallocation would invalidate.
+         if (const std::less_equal<> less_equal;
+             less_equal(data(), str.data()) && less_equal(str.data(), data() + old_size))
+         {
+            const difference_type offset = str.data() - data();
+
+            reserve(old_size + count);
+            str = std::string_view{data() + offset, str.size()};
+         }
+
+         m_chars.resize(old_size + count + 1, '\0');
+         std::copy(str.begin(), str.end(), m_chars.begin() + old_size);
+      }
+
+      /**
+       * @brief Returns an output iterator appending to the end of the string.
+       */
+      constexpr auto back_appender() noexcept -> appender { return appender{*this}; }
+
+      /**
+       * @brief Removes the last character of the string.
+       *
+       * @pre size() != 0
+       */
+      constexpr void pop_back()
+      {
+         Expects(size() != 0);
+
+         m_chars.pop_back();
+         m_chars.lookup(size()) = '\0';
+      }
+
+      /**
+       * @brief Resizes the string to count characters. New characters are set to value.
+       *
+       * @pre `count >= 0`
+       */
+      constexpr void resize(size_type count, char value = '\0')
+      {
+         Expects(count >= 0);
+
+         if (count > size())
+         {
+            append(count - size(), value);
+         }
+         else
+         {
+            m_chars.resize(count + 1);
+            m_chars.lookup(count) = '\0';
+         }
+      }
+
+      constexpr auto operator+=(std::string_view str) -> small_string&
+      {
+         append(str);
+         return *this;
+      }
+      constexpr auto operator+=(char value) -> small_string&
+      {
+         append(value);
+         return *this;
+      }
+
+   private:
+      underlying_type m_chars;
+   };
+
+   template <i64_t SizeOne, i64_t SizeTwo>
+   constexpr auto operator==(const small_string<SizeOne>& lhs, const small_string<SizeTwo>& rhs)
+      -> bool
+   {
+      return lhs.view() == rhs.view();
+   }
+   template <i64_t Size>
+   constexpr auto operator==(const small_string<Size>& lhs, std::string_view rhs) -> bool
+   {
+      return lhs.view() == rhs;
+   }
+
+   template <i64_t SizeOne, i64_t SizeTwo>
+   constexpr auto operator<=>(const small_string<SizeOne>& lhs, const small_string<SizeTwo>& rhs)
+   {
+      return lhs.view() <=> rhs.view();
+   }
+   template <i64_t Size>
+   constexpr auto operator<=>(const small_string<Size>& lhs, std::string_view rhs)
+   {
+      return lhs.view() <=> rhs;
+   }
+
+   template <i64_t Size>
+   inline constexpr bool enable_wink_out<small_string<Size>> = true;
+
+#if defined(__cpp_lib_format)
+   /**
+    * @brief Format args according to fmt and append the result to the end of str.
+    *
+    * @return An output iterator to the end of str.
+    */
+   template <i64_t Size, typename... Args>
+   auto format_to(small_string<Size>& str, std::format_string<Args...> fmt, Args&&... args)
+   {
+      return std::format_to(str.back_appender(), fmt, std::forward<Args>(args)...);
+   }
+#endif
+} // namespace caramel
+
+template <caramel::i64_t Size>
+struct std::hash<caramel::small_string<Size>>
+{
+   auto operator()(const caramel::small_string<Size>& str) const noexcept -> std::size_t
+   {
+      return std::hash<std::string_view>{}(str.view());
+   }
+};
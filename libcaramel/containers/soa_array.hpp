@@ -0,0 +1,762 @@
+/**
+ * @file containers/soa_array.hpp
+ * @brief Contains the soa_array API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/iterators/iterator_facade.hpp>
+#include <libcaramel/memory/memory_allocator.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace caramel::detail
+{
+   /**
+    * @brief Iterator over the rows of a soa_array. Dereferencing yields a tuple of references,
+    * one per column.
+    */
+   template <bool IsConst, typename... Ts>
+   class soa_iterator : public iterator_facade<soa_iterator<IsConst, Ts...>>
+   {
+      template <typename Any>
+      using maybe_const_t = std::conditional_t<IsConst, const Any, Any>;
+
+   public:
+      using value_type = std::tuple<Ts...>;
+      using reference = std::tuple<maybe_const_t<Ts>&...>;
+      using columns_type = std::tuple<maybe_const_t<Ts>*...>;
+
+   public:
+      constexpr soa_iterator() = default;
+      constexpr soa_iterator(columns_type columns, std::ptrdiff_t index) :
+         m_columns{columns}, m_index{index}
+      {}
+      template <bool OtherConst>
+      constexpr soa_iterator(const soa_iterator<OtherConst, Ts...>& other) requires(
+         IsConst and not OtherConst) :
+         m_columns{other.m_columns},
+         m_index{other.m_index}
+      {}
+
+      [[nodiscard]] constexpr auto dereference() const noexcept -> reference
+      {
+         return std::apply(
+            [index = m_index](auto*... p_columns) {
+               return reference{p_columns[index]...};
+            },
+            m_columns);
+      }
+
+      constexpr void advance(std::ptrdiff_t off) noexcept { m_index += off; }
+      [[nodiscard]] constexpr auto distance_to(soa_iterator other) const noexcept -> std::ptrdiff_t
+      {
+         return other.m_index - m_index;
+      }
+      constexpr auto operator==(soa_iterator other) const noexcept -> bool
+      {
+         return other.m_index == m_index;
+      }
+
+   private:
+      columns_type m_columns{};
+      std::ptrdiff_t m_index{0};
+
+      template <bool, typename...>
+      friend class soa_iterator;
+   };
+} // namespace caramel::detail
+
+namespace caramel
+{
+   /**
+    * @brief A resizable structure-of-arrays container.
+    *
+    * @details Every field of the rows is stored in its own contiguous column. All columns share a
+    * single size, a single capacity and a single allocation. Each column starts on a
+    * column_alignment boundary so that scans over a single column can be vectorized.
+    *
+    * @tparam Ts The type of each column
+    */
+   template <typename... Ts>
+   class soa_array
+   {
+      static_assert(sizeof...(Ts) > 0, "soa_array requires at least one column");
+
+      using columns_type = std::tuple<Ts*...>;
+      using const_columns_type = std::tuple<const Ts*...>;
+
+   public:
+      using value_type = std::tuple<Ts...>;
+      using size_type = std::int64_t;
+      using difference_type = std::ptrdiff_t;
+      using allocator_type = memory_allocator<std::byte>;
+      using reference = std::tuple<Ts&...>;
+      using const_reference = std::tuple<const Ts&...>;
+      using iterator = detail::soa_iterator<false, Ts...>;
+      using const_iterator = detail::soa_iterator<true, Ts...>;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+      template <std::size_t Index>
+      using column_type = std::tuple_element_t<Index, value_type>;
+
+      /**
+       * @brief The alignment, in bytes, of the first element of every column.
+       */
+      static constexpr std::size_t column_alignment = std::max({std::size_t{64}, alignof(Ts)...});
+
+   public:
+      /**
+       * @brief Default constructor.
+       */
+      soa_array() = default;
+      /**
+       * @brief Default construct the container with a given allocator
+       *
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      soa_array(const allocator_type& allocator) : m_allocator{allocator} {}
+      /**
+       * @brief Construct the container using the contents of other.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      soa_array(const soa_array& other) : soa_array(other.m_allocator)
+      {
+         reserve(other.size());
+         copy_columns_from(other);
+      }
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. After
+       * move, other is guarenteed to be empty().
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      soa_array(soa_array&& other) noexcept : m_allocator{other.m_allocator} { steal(other); }
+      /**
+       * @brief Construct the container using the contents of other, using allocator as the
+       * allocator.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      soa_array(const soa_array& other, const allocator_type& allocator) : soa_array(allocator)
+      {
+         reserve(other.size());
+         copy_columns_from(other);
+      }
+      /**
+       * @brief Construct the container with the contents of the other using move semantic, using
+       * allocator as the allocator. The storage of other is only taken when both allocators are
+       * equal, otherwise its rows are moved one by one. After move, other is guarenteed to be
+       * empty().
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       * @param[in] allocator The allocator to use for all memory allocations of this container.
+       */
+      soa_array(soa_array&& other, const allocator_type& allocator) : soa_array(allocator)
+      {
+         move_assign(other);
+      }
+      /**
+       * @brief Destructor
+       */
+      ~soa_array() noexcept { release(); }
+
+      /**
+       * @brief Replaces the contents with an copy of the contents of rhs.
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      auto operator=(const soa_array& rhs) -> soa_array&
+      {
+         if (this != &rhs)
+         {
+            clear();
+            reserve(rhs.size());
+            copy_columns_from(rhs);
+         }
+
+         return *this;
+      }
+      /**
+       * @brief Replaces the contents with those of other using move semantics, keeping the
+       * allocator of the container. The storage of rhs is taken when the allocators are equal,
+       * otherwise its rows are moved one by one into new storage, which may throw. After move,
+       * rhs is guarenteed to be empty().
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      auto operator=(soa_array&& rhs) -> soa_array&
+      {
+         if (this != &rhs)
+         {
+            move_assign(rhs);
+         }
+
+         return *this;
+      }
+
+      /**
+       * @brief Returns the allocator associated with the container.
+       *
+       * @return The associated allocator.
+       */
+      auto allocator() const noexcept -> allocator_type { return m_allocator; }
+
+      /**
+       * @brief Access the row stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       *
+       * @param[in] index The position to lookup the row in the array
+       *
+       * @return A tuple of references to each field of the row.
+       */
+      auto lookup(size_type index) -> reference
+      {
+         Expects(index < m_size);
+         Expects(index >= 0);
+
+         return *(begin() + index);
+      }
+      /**
+       * @brief Access the row stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       *
+       * @param[in] index The position to lookup the row in the array
+       *
+       * @return A tuple of const references to each field of the row.
+       */
+      auto lookup(size_type index) const -> const_reference
+      {
+         Expects(index < m_size);
+         Expects(index >= 0);
+
+         return *(begin() + index);
+      }
+
+      /**
+       * @brief Access the storage of a single column.
+       *
+       * @tparam Index The index of the column.
+       *
+       * @return A pointer to the first element of the column. The pointer is aligned on
+       * column_alignment.
+       */
+      template <std::size_t Index>
+      auto data() noexcept -> column_type<Index>*
+      {
+         return std::get<Index>(m_columns);
+      }
+      /**
+       * @brief Access the storage of a single column.
+       *
+       * @tparam Index The index of the column.
+       *
+       * @return A const pointer to the first element of the column. The pointer is aligned on
+       * column_alignment.
+       */
+      template <std::size_t Index>
+      auto data() const noexcept -> const column_type<Index>*
+      {
+         return std::get<Index>(m_columns);
+      }
+
+      /**
+       * @brief Access a single column as a contiguous range.
+       *
+       * @tparam Index The index of the column.
+       *
+       * @return A span over the size() elements of the column.
+       */
+      template <std::size_t Index>
+      auto column() noexcept -> std::span<column_type<Index>>
+      {
+         return {data<Index>(), static_cast<std::size_t>(m_size)};
+      }
+      /**
+       * @brief Access a single column as a contiguous range.
+       *
+       * @tparam Index The index of the column.
+       *
+       * @return A span over the size() elements of the column.
+       */
+      template <std::size_t Index>
+      auto column() const noexcept -> std::span<const column_type<Index>>
+      {
+         return {data<Index>(), static_cast<std::size_t>(m_size)};
+      }
+
+      /**
+       * @brief Returns an iterator to the first row of the soa_array.
+       */
+      auto begin() noexcept -> iterator { return iterator{m_columns, 0}; }
+      /**
+       * @brief Returns an iterator to the first row of the soa_array.
+       */
+      auto begin() const noexcept -> const_iterator { return const_iterator{const_columns(), 0}; }
+      /**
+       * @brief Returns an iterator to the first row of the soa_array.
+       */
+      auto cbegin() const noexcept -> const_iterator { return begin(); }
+
+      /**
+       * @brief Get an iterator to the row following the last row of the soa_array.
+       */
+      auto end() noexcept -> iterator { return iterator{m_columns, m_size}; }
+      /**
+       * @brief Get an iterator to the row following the last row of the soa_array.
+       */
+      auto end() const noexcept -> const_iterator
+      {
+         return const_iterator{const_columns(), m_size};
+      }
+      /**
+       * @brief Get an iterator to the row following the last row of the soa_array.
+       */
+      auto cend() const noexcept -> const_iterator { return end(); }
+
+      /**
+       * @brief Returns a reverse iterator to the last row of the soa_array.
+       */
+      auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+      /**
+       * @brief Returns a reverse iterator to the last row of the soa_array.
+       */
+      auto rbegin() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{end()};
+      }
+      /**
+       * @brief Returns a reverse iterator to the row preceding the first row of the soa_array.
+       */
+      auto rend() noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+      /**
+       * @brief Returns a reverse iterator to the row preceding the first row of the soa_array.
+       */
+      auto rend() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{begin()};
+      }
+
+      /**
+       * @brief Check if the soa_array is empty.
+       *
+       * @return True if the container is empty, false otherwise.
+       */
+      [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; };
+      /**
+       * @brief Check the number of rows stored in the soa_array.
+       *
+       * @return The number of rows in the soa_array.
+       */
+      [[nodiscard]] auto size() const noexcept -> size_type { return m_size; };
+      /**
+       * @brief Check the number of rows that the soa_array has currently allocated space for.
+       *
+       * @return Capacity of the currently allocated storage.
+       */
+      [[nodiscard]] auto capacity() const noexcept -> size_type { return m_capacity; };
+      /**
+       * @brief Increase the capacity of the soa_array to a value that's greater or equal to
+       * new_cap. If new_cap is greater than the current capacity(), new storage is allocated,
+       * otherwise the method does nothing. If reallocated occurs, all current iterators are
+       * invalidated.
+       *
+       * @param new_cap New capacity of the soa_array.
+       *
+       * @throws std::bad_alloc If the storage could not be allocated, leaving the array
+       * unchanged.
+       * @throws Any exception thrown when moving a row, leaving the size and capacity unchanged.
+       */
+      void reserve(size_type new_cap)
+      {
+         if (new_cap > capacity())
+         {
+            grow(new_cap);
+         }
+      }
+
+      /**
+       * @brief Erases all rows from the container, After this call, size() returs zero.
+       */
+      void clear() noexcept
+      {
+         for_each_column([this](auto* p_column) {
+            std::destroy(p_column, p_column + m_size);
+         });
+
+         m_size = 0;
+      }
+
+      /**
+       * @brief Appends a copy of the given row to the end of the container.
+       *
+       * @param[in] value The row to append.
+       */
+      void append(const value_type& value)
+      {
+         std::apply(
+            [this](const auto&... fields) {
+               append(in_place, fields...);
+            },
+            value);
+      }
+      /**
+       * @brief Appends the given row to the end of the container. Each field is moved into the
+       * new row.
+       *
+       * @param[in] value The row to append.
+       */
+      void append(value_type&& value)
+      {
+         std::apply(
+            [this](auto&&... fields) {
+               append(in_place, std::move(fields)...);
+            },
+            std::move(value));
+      }
+      /**
+       * @brief Appends a row to the end of the container. Each field is constructed in-place from
+       * the argument at the same position.
+       *
+       * @param[in] args One argument per column, forwarded to the constructor of the field.
+       *
+       * @return A tuple of references to each field of the new row.
+       */
+      template <typename... Args>
+      requires(sizeof...(Args) == sizeof...(Ts) and
+               (std::constructible_from<Ts, Args> and ...)) auto append(in_place_t, Args&&... args)
+         -> reference
+      {
+         if (size() >= capacity())
+         {
+            grow();
+         }
+
+         auto fields = std::forward_as_tuple(std::forward<Args>(args)...);
+         build_columns(
+            [&](auto column) {
+               std::construct_at(std::get<column>(m_columns) + m_size,
+                                 std::get<column>(std::move(fields)));
+            },
+            [&](auto column) {
+               std::destroy_at(std::get<column>(m_columns) + m_size);
+            });
+
+         ++m_size;
+
+         return lookup(m_size - 1);
+      }
+
+      /**
+       * @brief Erases the specified row from the container.
+       *
+       * @pre pos >= begin()
+       * @pre pos < end()
+       *
+       * @param[in] pos Iterator to the row to remove.
+       *
+       * @return Iterator following the removed row.
+       */
+      auto erase(const_iterator pos) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos < cend());
+
+         const size_type index = pos - cbegin();
+
+         for_each_column([&](auto* p_column) {
+            std::move(p_column + index + 1, p_column + m_size, p_column + index);
+         });
+
+         pop_back();
+
+         return begin() + index;
+      }
+
+      /**
+       * @brief Removes the last row in the container.
+       *
+       * @pre size() != 0
+       */
+      void pop_back()
+      {
+         Expects(size() != 0);
+
+         --m_size;
+
+         for_each_column([this](auto* p_column) {
+            std::destroy_at(p_column + m_size);
+         });
+      }
+
+      /**
+       * @brief Resizes the container to contain count rows. If the current size is greater than
+       * count, the container is reduced to its first count rows. If the current size is less
+       * than count, value initialized rows are appended.
+       *
+       * @pre count >= 0
+       *
+       * @param[in] count New size of the container.
+       */
+      void resize(size_type count)
+      {
+         Expects(count >= 0);
+
+         if (size() > count)
+         {
+            for_each_column([&](auto* p_column) {
+               std::destroy(p_column + count, p_column + m_size);
+            });
+         }
+         else if (size() < count)
+         {
+            reserve(count);
+
+            for_each_column([&](auto* p_column) {
+               std::uninitialized_value_construct(p_column + m_size, p_column + count);
+            });
+         }
+
+         m_size = count;
+      }
+
+   private:
+      template <typename Function>
+      void for_each_column(Function&& function)
+      {
+         std::apply(
+            [&](auto*... p_columns) {
+               (function(p_columns), ...);
+            },
+            m_columns);
+      }
+
+      auto const_columns() const noexcept -> const_columns_type { return m_columns; }
+
+      static constexpr auto align_up(size_type bytes) noexcept -> size_type
+      {
+         constexpr auto alignment = static_cast<size_type>(column_alignment);
+
+         return (bytes + alignment - 1) / alignment * alignment;
+      }
+
+      /**
+       * @brief Compute the byte offset of each column within a block able to hold capacity rows.
+       * The last entry is the total size of the block.
+       */
+      static constexpr auto column_offsets(size_type capacity) noexcept
+         -> std::array<size_type, sizeof...(Ts) + 1>
+      {
+         constexpr std::array<size_type, sizeof...(Ts)> sizes{
+            static_cast<size_type>(sizeof(Ts))...};
+
+         std::array<size_type, sizeof...(Ts) + 1> offsets{};
+         for (std::size_t i = 0; i < sizes.size(); ++i)
+         {
+            offsets[i + 1] = offsets[i] + align_up(sizes[i] * capacity); // NOLINT
+         }
+
+         return offsets;
+      }
+
+      static auto make_columns(std::byte* p_storage, size_type capacity) noexcept -> columns_type
+      {
+         const auto offsets = column_offsets(capacity);
+
+         return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+         {
+            return columns_type{reinterpret_cast<Ts*>(p_storage + offsets[Is])...}; // NOLINT
+         }
+         (std::index_sequence_for<Ts...>{});
+      }
+
+      void grow(size_type min_size = 0)
+      {
+         const size_type new_capacity =
+            detail::grown_capacity(std::max(m_capacity + 1, min_size));
+         const size_type new_bytes = column_offsets(new_capacity).back();
+
+         auto* p_new_storage =
+            m_allocator.allocate(count_t{new_bytes}, align_t{column_alignment});
+         if (!p_new_storage)
+         {
+            throw std::bad_alloc{};
+         }
+
+         auto new_columns = make_columns(p_new_storage, new_capacity);
+
+         try
+         {
+            build_columns(
+               [&](auto column) {
+                  std::uninitialized_move_n(std::get<column>(m_columns), m_size,
+                                            std::get<column>(new_columns));
+               },
+               [&](auto column) {
+                  std::destroy_n(std::get<column>(new_columns), m_size);
+               });
+         }
+         catch (...)
+         {
+            m_allocator.deallocate(gsl::make_not_null(p_new_storage), count_t{new_bytes},
+                                   align_t{column_alignment});
+            throw;
+         }
+
+         for_each_column([this](auto* p_column) {
+            std::destroy_n(p_column, m_size);
+         });
+         deallocate_storage();
+
+         mp_storage = p_new_storage;
+         m_columns = new_columns;
+         m_capacity = new_capacity;
+      }
+
+      /**
+       * @brief Apply build to every column in turn. If it throws, undo is applied to the columns
+       * already built before rethrowing, so that no column is left with more rows than the
+       * others.
+       *
+       * @details Both are called with a std::integral_constant holding the index of the column.
+       */
+      template <typename Build, typename Undo>
+      static void build_columns(Build&& build, Undo&& undo)
+      {
+         std::size_t built = 0;
+
+         try
+         {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+               ((build(std::integral_constant<std::size_t, Is>{}), ++built), ...);
+            }
+            (std::index_sequence_for<Ts...>{});
+         }
+         catch (...)
+         {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+               ((Is < built ? undo(std::integral_constant<std::size_t, Is>{}) : void()), ...);
+            }
+            (std::index_sequence_for<Ts...>{});
+
+            throw;
+         }
+      }
+
+      /**
+       * @brief Copy the rows of other into the storage of an empty array able to hold them.
+       */
+      void copy_columns_from(const soa_array& other)
+      {
+         Expects(empty());
+         Expects(capacity() >= other.size());
+
+         build_columns(
+            [&](auto column) {
+               std::uninitialized_copy_n(std::get<column>(other.m_columns), other.m_size,
+                                         std::get<column>(m_columns));
+            },
+            [&](auto column) {
+               std::destroy_n(std::get<column>(m_columns), other.m_size);
+            });
+
+         m_size = other.m_size;
+      }
+
+      /**
+       * @brief Take the rows of rhs, leaving it empty, while keeping the allocator of the array.
+       * The storage of rhs is stolen when the allocators are equal, otherwise the rows are moved
+       * one by one into storage of our allocator and the storage of rhs is released.
+       */
+      void move_assign(soa_array& rhs)
+      {
+         if (m_allocator == rhs.m_allocator)
+         {
+            release();
+            steal(rhs);
+
+            return;
+         }
+
+         clear();
+         reserve(rhs.size());
+
+         build_columns(
+            [&](auto column) {
+               std::uninitialized_move_n(std::get<column>(rhs.m_columns), rhs.m_size,
+                                         std::get<column>(m_columns));
+            },
+            [&](auto column) {
+               std::destroy_n(std::get<column>(m_columns), rhs.m_size);
+            });
+
+         m_size = rhs.m_size;
+
+         rhs.release();
+      }
+
+      void steal(soa_array& other) noexcept
+      {
+         mp_storage = std::exchange(other.mp_storage, nullptr);
+         m_columns = std::exchange(other.m_columns, columns_type{});
+         m_size = std::exchange(other.m_size, 0);
+         m_capacity = std::exchange(other.m_capacity, 0);
+      }
+
+      void release() noexcept
+      {
+         clear();
+         deallocate_storage();
+
+         mp_storage = nullptr;
+         m_columns = columns_type{};
+         m_capacity = 0;
+      }
+
+      void deallocate_storage() noexcept
+      {
+         if (mp_storage)
+         {
+            m_allocator.deallocate(gsl::make_not_null(mp_storage),
+                                   count_t{column_offsets(m_capacity).back()},
+                                   align_t{column_alignment});
+         }
+      }
+
+   private:
+      std::byte* mp_storage{nullptr};
+      columns_type m_columns{};
+
+      size_type m_size{0};
+      size_type m_capacity{0};
+
+      allocator_type m_allocator;
+   };
+} // namespace caramel
@@ -0,0 +1,882 @@
+/**
+ * @file containers/static_dynamic_array.hpp
+ * @brief Contains the static_dynamic_array API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/iterators/random_iterator.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace caramel::detail
+{
+   /**
+    * @brief The smallest unsigned integer type able to represent every value in [0, Count]
+    */
+   template <i64_t Count>
+   using smallest_size_t = std::conditional_t<
+      (Count <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+      std::conditional_t<(Count <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+                         std::conditional_t<(Count <= std::numeric_limits<std::uint32_t>::max()),
+                                            std::uint32_t, std::uint64_t>>>;
+} // namespace caramel::detail
+
+namespace caramel
+{
+   /**
+    * @brief A resizable array with a fixed capacity that never allocates memory.
+    *
+    * @details Elements are stored inline and the number of elements is stored in the smallest
+    * unsigned integer type able to hold Capacity. The container is trivially copyable and
+    * trivially destructible whenever Any is, and every operation is usable during constant
+    * evaluation. Going over the capacity is a precondition violation.
+    *
+    * @tparam Any The type of the elements
+    * @tparam Capacity The maximum number of elements the container can hold.
+    */
+   template <typename Any, i64_t Capacity>
+   class static_dynamic_array
+   {
+      static_assert(Capacity > 0, "static_dynamic_array requires a capacity of at least 1");
+
+      using stored_size_type = detail::smallest_size_t<Capacity>;
+
+   public:
+      using value_type = Any;
+      using size_type = std::int64_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type&;
+      using const_reference = const value_type&;
+      using pointer = value_type*;
+      using const_pointer = const value_type*;
+      using iterator = random_access_iterator<value_type>;
+      using const_iterator = random_access_iterator<const value_type>;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+   public:
+      /**
+       * @brief Default constructor.
+       */
+      constexpr static_dynamic_array() noexcept
+      {
+         // A constant expression may not hold indeterminate values, so the storage has to be
+         // fully initialized when the container is built at compile time.
+         if constexpr (std::is_trivially_default_constructible_v<value_type>)
+         {
+            if (std::is_constant_evaluated())
+            {
+               for (auto& element : m_elements)
+               {
+                  std::construct_at(&element);
+               }
+            }
+         }
+      }
+      /**
+       * @brief Construct the container with count copies of elements with value value
+       *
+       * @pre `count >= 0`, otherwise UB
+       * @pre `count <= capacity()`, otherwise UB
+       *
+       * @param[in] count The size of the container.
+       * @param[in] value The value to initialize elements from.
+       */
+      constexpr static_dynamic_array(size_type count, const_reference value) :
+         static_dynamic_array()
+      {
+         Expects(count >= 0);
+         Expects(count <= capacity());
+
+         resize(count, value);
+      }
+      /**
+       * @brief Construct the container with the contents of the initializer list init.
+       *
+       * @pre `std::size(init) <= capacity()`, otherwise UB
+       *
+       * @param[in] init Initializer list to initialize the elements of the container with.
+       */
+      constexpr static_dynamic_array(std::initializer_list<Any> init) : static_dynamic_array()
+      {
+         insert(cend(), init.begin(), init.end());
+      }
+      /**
+       * @brief Construct the container with the contents of the range [first, last)
+       *
+       * @pre `std::distance(first, last) <= capacity()`, otherwise UB
+       *
+       * @param[in] first The first element of the range to copy from.
+       * @param[in] last One past the last element of the range to copy from.
+       */
+      template <std::input_iterator InputIt>
+      constexpr static_dynamic_array(InputIt first, InputIt last) : static_dynamic_array()
+      {
+         insert(cend(), first, last);
+      }
+
+      // clang-format off
+      constexpr static_dynamic_array(const static_dynamic_array&)
+         requires std::is_trivially_copy_constructible_v<value_type> = default;
+      /**
+       * @brief Construct the container using the contents of other.
+       *
+       * @param[in] other Another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      constexpr static_dynamic_array(const static_dynamic_array& other)
+         noexcept(std::is_nothrow_copy_constructible_v<value_type>)
+         : static_dynamic_array()
+      {
+         for (const auto& element : other)
+         {
+            std::construct_at(offset(size()), element);
+            ++m_size;
+         }
+      }
+      constexpr static_dynamic_array(static_dynamic_array&&) noexcept
+         requires std::is_trivially_move_constructible_v<value_type> = default;
+      /**
+       * @brief Construct the container with the contents of the other using move semantic. After
+       * the move, other is left in a valid but unspecified state.
+       *
+       * @param[in] other another container to be used as source to initialize the elements of the
+       * container with.
+       */
+      constexpr static_dynamic_array(static_dynamic_array&& other)
+         noexcept(std::is_nothrow_move_constructible_v<value_type>)
+         : static_dynamic_array()
+      {
+         for (auto& element : other)
+         {
+            std::construct_at(offset(size()), std::move(element));
+            ++m_size;
+         }
+
+         other.clear();
+      }
+
+      constexpr ~static_dynamic_array()
+         requires std::is_trivially_destructible_v<value_type> = default;
+      /**
+       * @brief Destructor
+       */
+      constexpr ~static_dynamic_array() { clear(); }
+
+      constexpr auto operator=(const static_dynamic_array&) -> static_dynamic_array&
+         requires std::is_trivially_copy_assignable_v<value_type> and
+                  std::is_trivially_copy_constructible_v<value_type> and
+                  std::is_trivially_destructible_v<value_type> = default;
+      /**
+       * @brief Replaces the contents with an copy of the contents of rhs.
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      constexpr auto operator=(const static_dynamic_array& rhs) -> static_dynamic_array&
+      {
+         if (this != &rhs)
+         {
+            assign_from(rhs.begin(), rhs.size());
+         }
+
+         return *this;
+      }
+      constexpr auto operator=(static_dynamic_array&&) noexcept -> static_dynamic_array&
+         requires std::is_trivially_move_assignable_v<value_type> and
+                  std::is_trivially_move_constructible_v<value_type> and
+                  std::is_trivially_destructible_v<value_type> = default;
+      /**
+       * @brief Replaces the contents with those of other using move semantics. After the move,
+       * rhs is left in a valid but unspecified state.
+       *
+       * @param[in] rhs other container to use as a data source.
+       */
+      constexpr auto operator=(static_dynamic_array&& rhs)
+         noexcept(std::is_nothrow_move_assignable_v<value_type> and
+                  std::is_nothrow_move_constructible_v<value_type>)
+         -> static_dynamic_array&
+      {
+         if (this != &rhs)
+         {
+            assign_from(std::make_move_iterator(rhs.begin()), rhs.size());
+
+            rhs.clear();
+         }
+
+         return *this;
+      }
+      // clang-format on
+
+      /**
+       * @brief Replaces the contents with those identified by initializer list init_list
+       *
+       * @pre `std::size(init_list) <= capacity()`, otherwise UB
+       *
+       * @param init_list Initializer list to use as data source.
+       */
+      constexpr auto operator=(std::initializer_list<Any> init_list) -> static_dynamic_array&
+      {
+         Expects(static_cast<size_type>(init_list.size()) <= capacity());
+
+         assign_from(init_list.begin(), static_cast<size_type>(init_list.size()));
+
+         return *this;
+      }
+
+      /**
+       * @brief Access the object stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       *
+       * @param[in] index The position to lookup the object in the array
+       *
+       * @return A reference to the object stored at index.
+       */
+      constexpr auto lookup(size_type index) -> reference
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return m_elements[index];
+      }
+      /**
+       * @brief Access the object stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       *
+       * @param[in] index The position to lookup the object in the array
+       *
+       * @return A const reference to the object stored at index.
+       */
+      constexpr auto lookup(size_type index) const -> const_reference
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return m_elements[index];
+      }
+
+      /**
+       * @brief Access the data stored by the container.
+       *
+       * @return A pointer to the first element in the container.
+       */
+      constexpr auto data() noexcept -> pointer { return m_elements; }
+      /**
+       * @brief Access the data stored by the container.
+       *
+       * @return A const_pointer to the first element in the container.
+       */
+      constexpr auto data() const noexcept -> const_pointer { return m_elements; }
+
+      /**
+       * @brief Returns an iterator to the first element of the static_dynamic_array.
+       *
+       * @return An iterator to the first element of the static_dynamic_array. If the
+       * static_dynamic_array is empty, the iterator will be equal to end().
+       */
+      constexpr auto begin() noexcept -> iterator { return iterator{data()}; }
+      /**
+       * @brief Returns an iterator to the first element of the static_dynamic_array.
+       *
+       * @return A const_iterator to the first element of the static_dynamic_array. If the
+       * static_dynamic_array is empty, the const_iterator will be equal to end().
+       */
+      constexpr auto begin() const noexcept -> const_iterator { return const_iterator{data()}; }
+      /**
+       * @brief Returns an iterator to the first element of the static_dynamic_array.
+       *
+       * @return iterator to the first element. If the static_dynamic_array is empty, the
+       * const_iterator will be equal to end().
+       */
+      constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{data()}; }
+
+      /**
+       * @brief Get an iterator to the element following the last element of the
+       * static_dynamic_array.
+       *
+       * @return iterator to the element following the last element. Attempting to access it results
+       * in undefined behaviour.
+       */
+      constexpr auto end() noexcept -> iterator { return iterator{data() + size()}; }
+      /**
+       * @brief Return an iterator to the element following the last element of the
+       * static_dynamic_array.
+       *
+       * @return iterator to the element following the last element. Attempting to access it results
+       * in undefined behaviour.
+       */
+      constexpr auto end() const noexcept -> const_iterator
+      {
+         return const_iterator{data() + size()};
+      }
+      /**
+       * @brief Returns an it iterator to the element following the last element of the
+       * static_dynamic_array.
+       *
+       * @return iterator to the element following the last element. Attempting to access it results
+       * in undefined behaviour.
+       */
+      constexpr auto cend() const noexcept -> const_iterator
+      {
+         return const_iterator{data() + size()};
+      }
+
+      /**
+       * @brief Returns a reverse iterator to the first element of the reversed
+       * static_dynamic_array. It corresponds to the last element of the non-reversed
+       * static_dynamic_array. If the static_dynamic_array is empty, the returned iterator is equal
+       * to rend().
+       *
+       * @return Reverse iterator to the first element.
+       */
+      constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{end()}; }
+      /**
+       * @brief Returns a reverse iterator to the first element of the reversed
+       * static_dynamic_array. It corresponds to the last element of the non-reversed
+       * static_dynamic_array. If the static_dynamic_array is empty, the returned iterator is equal
+       * to rend().
+       *
+       * @return Reverse iterator to the first element.
+       */
+      constexpr auto rbegin() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{cend()};
+      }
+      /**
+       * @brief Returns a reverse iterator to the first element of the reversed
+       * static_dynamic_array. It corresponds to the last element of the non-reversed
+       * static_dynamic_array. If the static_dynamic_array is empty, the returned iterator is equal
+       * to rend().
+       *
+       * @return Reverse iterator to the first element.
+       */
+      constexpr auto rcbegin() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{cend()};
+      }
+
+      /**
+       * @brief Returns a reverse iterator to the element following the last element of the reversed
+       * static_dynamic_array. It corresponds to the element preceding the first element of the
+       * non-reversed static_dynamic_array. This element acts as a placeholder, attempting to access
+       * it results in UB.
+       *
+       * @return Reverse iterator to the element following the last element.
+       */
+      constexpr auto rend() noexcept -> reverse_iterator { return reverse_iterator{begin()}; }
+      /**
+       * @brief Returns a reverse iterator to the element following the last element of the reversed
+       * static_dynamic_array. It corresponds to the element preceding the first element of the
+       * non-reversed static_dynamic_array. This element acts as a placeholder, attempting to access
+       * it results in UB.
+       *
+       * @return Reverse iterator to the element following the last element.
+       */
+      constexpr auto rend() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{cbegin()};
+      }
+      /**
+       * @brief Returns a reverse iterator to the element following the last element of the reversed
+       * static_dynamic_array. It corresponds to the element preceding the first element of the
+       * non-reversed static_dynamic_array. This element acts as a placeholder, attempting to access
+       * it results in UB.
+       *
+       * @return Reverse iterator to the element following the last element.
+       */
+      constexpr auto rcend() const noexcept -> const_reverse_iterator
+      {
+         return const_reverse_iterator{cbegin()};
+      }
+
+      /**
+       * @brief Check if the static_dynamic_array is empty.
+       *
+       * @return True if the container is empty, false otherwise.
+       */
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_size == 0; };
+      /**
+       * @brief Check if the static_dynamic_array has reached its capacity.
+       *
+       * @return True if no more elements may be added to the container, false otherwise.
+       */
+      [[nodiscard]] constexpr auto full() const noexcept -> bool { return m_size == Capacity; };
+      /**
+       * @brief Check the number of elements stored in the static_dynamic_array.
+       *
+       * @return The number of elements in the static_dynamic_array.
+       */
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type
+      {
+         return static_cast<size_type>(m_size);
+      };
+      /**
+       * @brief Check the maximum number of elements the static_dynamic_array can hold.
+       *
+       * @return The capacity of the inline storage.
+       */
+      [[nodiscard]] static constexpr auto capacity() noexcept -> size_type { return Capacity; };
+
+      /**
+       * @brief Erases all elements from the container, After this call, size() returs zero.
+       */
+      constexpr void clear() noexcept
+      {
+         std::destroy(begin(), end());
+         m_size = 0;
+      }
+
+      /**
+       * @brief Inserts an element value at the position before pos in the container.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() < capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] value Element value to insert.
+       *
+       * @return Iterator pointing to the inserted value.
+       */
+      constexpr auto insert(const_iterator pos, const_reference value) -> iterator
+      {
+         return insert(pos, in_place, value);
+      }
+      /**
+       * @brief Inserts an element value at the position before pos in the container.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() < capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] value Element value to insert.
+       *
+       * @return Iterator pointing to the inserted value.
+       */
+      constexpr auto insert(const_iterator pos, value_type&& value) -> iterator
+      {
+         return insert(pos, in_place, std::move(value));
+      }
+      /**
+       * @brief Insert a new element into the container directly before pos. The element is
+       * constructed in-place using the arguments Args... that are forwarded to the constructor.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() < capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * @param[in] args Arguments to forward to the constructor of the element.
+       *
+       * @return Iterator pointing to the inserted value.
+       */
+      template <typename... Args>
+      requires std::constructible_from<value_type, Args...> constexpr auto
+      insert(const_iterator pos, in_place_t, Args&&... args) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos <= cend());
+         Expects(!full());
+
+         const size_type index = pos - cbegin();
+
+         if (index == size())
+         {
+            append(in_place, std::forward<Args>(args)...);
+
+            return begin() + index;
+         }
+
+         // The arguments may refer to an element of the container, build the value before the
+         // elements are shifted.
+         value_type value(std::forward<Args>(args)...);
+
+         std::construct_at(offset(size()), std::move(*offset(size() - 1)));
+         std::move_backward(offset(index), offset(size() - 1), offset(size()));
+         ++m_size;
+
+         *offset(index) = std::move(value);
+
+         return begin() + index;
+      }
+      /**
+       * @brief Inserts count elements from a specified value.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() + count <= capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] count The number of elements to insert.
+       * @param[in] value Element value to insert.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      constexpr auto insert(const_iterator pos, size_type count, const_reference value) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos <= cend());
+         Expects(count >= 0);
+         Expects(size() + count <= capacity());
+
+         const size_type index = pos - cbegin();
+         const value_type copy = value;
+
+         pointer first = open_gap(index, count);
+         for (size_type i = 0; i < count; ++i)
+         {
+            std::construct_at(first + i, copy);
+         }
+
+         m_size = static_cast<stored_size_type>(size() + count);
+
+         return begin() + index;
+      }
+      /**
+       * @brief Inserts elements from a range [first, last) before pos.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() + std::distance(first, last) <= capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] first The first value to insert
+       * @param[in] last One past the last value to insert.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      template <std::input_iterator InputIt>
+      constexpr auto insert(const_iterator pos, InputIt first, InputIt last) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos <= cend());
+
+         const size_type index = pos - cbegin();
+
+         if constexpr (std::forward_iterator<InputIt>)
+         {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+
+            Expects(size() + count <= capacity());
+
+            pointer p_first = open_gap(index, count);
+            for (; first != last; ++first, ++p_first)
+            {
+               std::construct_at(p_first, *first);
+            }
+
+            m_size = static_cast<stored_size_type>(size() + count);
+         }
+         else
+         {
+            // Single pass ranges cannot be measured beforehand, so the elements are appended and
+            // rotated into place.
+            const size_type old_size = size();
+            for (; first != last; ++first)
+            {
+               append(in_place, *first);
+            }
+
+            std::rotate(offset(index), offset(old_size), offset(size()));
+         }
+
+         return begin() + index;
+      }
+      /**
+       * @brief Insert elements from an initializer_list before the position pos.
+       *
+       * @pre pos >= begin()
+       * @pre pos <= end()
+       * @pre size() + std::size(init_list) <= capacity()
+       *
+       * @param[in] pos Iterator before which the content will be inserted. pos may be the end()
+       * iterator.
+       * @param[in] init_list Initializer list to insert the values from.
+       *
+       * @return Iterator pointing to the first element inserted.
+       */
+      constexpr auto insert(const_iterator pos, std::initializer_list<value_type> init_list)
+         -> iterator
+      {
+         return insert(pos, init_list.begin(), init_list.end());
+      }
+
+      /**
+       * @brief Erases the specified element from the container.
+       *
+       * @pre pos >= begin()
+       * @pre pos < end()
+       *
+       * @param[in] pos Iterator to the element to remove.
+       *
+       * @return Iterator following the removed element.
+       */
+      constexpr auto erase(const_iterator pos) -> iterator
+      {
+         Expects(pos >= cbegin());
+         Expects(pos < cend());
+
+         const size_type index = pos - cbegin();
+
+         std::move(offset(index + 1), offset(size()), offset(index));
+         pop_back();
+
+         return begin() + index;
+      }
+      /**
+       * @brief Erases the specified elements from the container.
+       *
+       * @pre first >= begin()
+       * @pre last <= end()
+       * @pre first <= last
+       *
+       * @param[in] first The first element of the range to remove.
+       * @param[in] last One past the last element of the range to remove.
+       *
+       * @return Iterator following the last removed element.
+       */
+      constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+      {
+         Expects(first >= cbegin());
+         Expects(last <= cend());
+         Expects(first <= last);
+
+         const size_type index = first - cbegin();
+         const size_type count = last - first;
+
+         if (count != 0)
+         {
+            pointer new_end = std::move(offset(index + count), offset(size()), offset(index));
+            std::destroy(new_end, offset(size()));
+
+            m_size = static_cast<stored_size_type>(size() - count);
+         }
+
+         return begin() + index;
+      }
+
+      /**
+       * @brief Appends the given element value to the end of the container. The new element is
+       * initialized as a copy of value.
+       *
+       * @pre size() < capacity()
+       *
+       * @param[in] value The value of the element to append.
+       */
+      constexpr void append(const value_type& value) { append(in_place, value); }
+      /**
+       * @brief Appends the given element value to the end of the container. Value is moved into the
+       * new element.
+       *
+       * @pre size() < capacity()
+       *
+       * @param[in] value The value of the element to append.
+       */
+      constexpr void append(value_type&& value) { append(in_place, std::move(value)); }
+      /**
+       * @brief Appends the given element value to the end of the container. The element is
+       * constructed in-place using the arguments Args... that are forwarded to the constructor.
+       *
+       * @pre size() < capacity()
+       *
+       * @param[in] args Arguments to forward to the constructor of the element.
+       */
+      template <typename... Args>
+      requires std::constructible_from<value_type, Args...> constexpr auto append(in_place_t,
+                                                                                  Args&&... args)
+         -> reference
+      {
+         Expects(!full());
+
+         pointer p_element = std::construct_at(offset(size()), std::forward<Args>(args)...);
+         ++m_size;
+
+         return *p_element;
+      }
+
+      /**
+       * @brief Removes the last element in the container.
+       *
+       * @pre size() != 0
+       */
+      constexpr void pop_back()
+      {
+         Expects(size() != 0);
+
+         --m_size;
+         std::destroy_at(offset(size()));
+      };
+
+      /**
+       * @brief Resizes the container to contain count elements. If the current size is greater than
+       * count, the container is reduced to its first count elements. If the current size is less
+       * than count, default constructed elements are appended.
+       *
+       * @pre count >= 0
+       * @pre count <= capacity()
+       *
+       * @param[in] count New size of the container.
+       */
+      constexpr void resize(size_type count)
+      {
+         Expects(count >= 0);
+         Expects(count <= capacity());
+
+         if (size() > count)
+         {
+            std::destroy(offset(count), offset(size()));
+         }
+         else
+         {
+            for (size_type i = size(); i < count; ++i)
+            {
+               std::construct_at(offset(i));
+            }
+         }
+
+         m_size = static_cast<stored_size_type>(count);
+      }
+      /**
+       * @brief Resizes the container to contain count elements. If the current size is greater than
+       * count, the container is reduced to its first count elements. If the current size is less
+       * than count, additional copies of value are appended.
+       *
+       * @pre count >= 0
+       * @pre count <= capacity()
+       *
+       * @param[in] count New size of the container.
+       * @param[in] value The value to initialize new elements with.
+       */
+      constexpr void resize(size_type count, const_reference value)
+      {
+         Expects(count >= 0);
+         Expects(count <= capacity());
+
+         if (size() > count)
+         {
+            std::destroy(offset(count), offset(size()));
+         }
+         else
+         {
+            for (size_type i = size(); i < count; ++i)
+            {
+               std::construct_at(offset(i), value);
+            }
+         }
+
+         m_size = static_cast<stored_size_type>(count);
+      }
+
+   private:
+      constexpr auto offset(size_type i) noexcept -> pointer { return m_elements + i; }
+      constexpr auto offset(size_type i) const noexcept -> const_pointer { return m_elements + i; }
+
+      /**
+       * @brief Move the elements in [index, size()) count slots to the right, leaving the slots in
+       * [index, index + count) without any live object. Does not update the size.
+       */
+      constexpr auto open_gap(size_type index, size_type count) -> pointer
+      {
+         pointer first = offset(index);
+         pointer last = offset(size());
+
+         if (last - first > count)
+         {
+            for (pointer it = last - count; it != last; ++it)
+            {
+               std::construct_at(it + count, std::move(*it));
+            }
+
+            std::move_backward(first, last - count, last);
+            std::destroy(first, first + count);
+         }
+         else
+         {
+            for (pointer it = first; it != last; ++it)
+            {
+               std::construct_at(it + count, std::move(*it));
+            }
+
+            std::destroy(first, last);
+         }
+
+         return first;
+      }
+
+      template <typename InputIt>
+      constexpr void assign_from(InputIt first, size_type count)
+      {
+         const size_type common = std::min(size(), count);
+
+         for (size_type i = 0; i < common; ++i, ++first)
+         {
+            *offset(i) = *first;
+         }
+
+         if (count > size())
+         {
+            for (size_type i = common; i < count; ++i, ++first)
+            {
+               std::construct_at(offset(i), *first);
+            }
+         }
+         else
+         {
+            std::destroy(offset(count), offset(size()));
+         }
+
+         m_size = static_cast<stored_size_type>(count);
+      }
+
+   private:
+      union
+      {
+         value_type m_elements[Capacity]; // NOLINT
+      };
+
+      stored_size_type m_size{0};
+   };
+
+   template <std::equality_comparable Any, i64_t CapacityOne, i64_t CapacityTwo>
+   constexpr auto operator==(const static_dynamic_array<Any, CapacityOne>& lhs,
+                             const static_dynamic_array<Any, CapacityTwo>& rhs) -> bool
+   {
+      return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+   }
+
+   template <typename Any, i64_t CapacityOne, i64_t CapacityTwo>
+   constexpr auto operator<=>(const static_dynamic_array<Any, CapacityOne>& lhs,
+                              const static_dynamic_array<Any, CapacityTwo>& rhs)
+   {
+      constexpr auto compare = [](const Any& left, const Any& right) {
+         return detail::synth_three_way(left, right);
+      };
+
+      return std::lexicographical_compare_three_way(std::begin(lhs), std::end(lhs), std::begin(rhs),
+                                                    std::end(rhs), compare);
+   }
+
+   template <typename Any, typename... U>
+   static_dynamic_array(Any, U...) -> static_dynamic_array<Any, 1 + sizeof...(U)>;
+} // namespace caramel
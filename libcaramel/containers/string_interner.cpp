@@ -0,0 +1,175 @@
+#include <libcaramel/containers/string_interner.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace caramel
+{
+   namespace
+   {
+      constexpr string_interner::size_type initial_slot_count = 64;
+
+      constexpr auto mix(u64_t value) noexcept -> u64_t
+      {
+         value ^= value >> 32U;
+         value *= 0xd6e8feb86659fd93ULL; // NOLINT
+         value ^= value >> 32U;
+
+         return value;
+      }
+
+      /**
+       * Hashes eight bytes at a time, which keeps short keys cheap while remaining good enough
+       * for linear probing.
+       */
+      auto hash_string(std::string_view str) noexcept -> u64_t
+      {
+         u64_t hash = 0x9e3779b97f4a7c15ULL ^ str.size(); // NOLINT
+
+         const char* p_chars = str.data();
+         std::size_t remaining = str.size();
+         for (; remaining >= sizeof(u64_t); remaining -= sizeof(u64_t))
+         {
+            u64_t word = 0;
+            std::memcpy(&word, p_chars, sizeof(u64_t));
+            hash = mix(hash ^ word);
+            p_chars += sizeof(u64_t); // NOLINT
+         }
+
+         if (remaining != 0)
+         {
+            u64_t word = 0;
+            std::memcpy(&word, p_chars, remaining);
+            hash = mix(hash ^ word);
+         }
+
+         return mix(hash);
+      }
+
+      constexpr auto fragment_of(u64_t hash) noexcept -> u32_t
+      {
+         return static_cast<u32_t>(hash >> 32U);
+      }
+   } // namespace
+
+   string_interner::string_interner() :
+      string_interner(gsl::make_not_null(get_default_memory_resource()))
+   {}
+   string_interner::string_interner(gsl::not_null<memory_resource*> p_upstream) :
+      m_arena{p_upstream}, m_entries{memory_allocator<entry>{p_upstream.get()}},
+      m_slots{memory_allocator<slot>{p_upstream.get()}}
+   {
+      m_slots.resize(initial_slot_count, slot{0, 0});
+   }
+
+   auto string_interner::intern(std::string_view str) -> symbol_t
+   {
+      const u64_t hash = hash_string(str);
+
+      size_type index = find_slot(str, hash);
+      if (const slot& found = m_slots.lookup(index); found.symbol_plus_one != 0)
+      {
+         return symbol_t{found.symbol_plus_one - 1};
+      }
+
+      Expects(size() < std::numeric_limits<u32_t>::max());
+
+      // Keep the load factor under one half so probe sequences stay short.
+      if ((size() + 1) * 2 > m_slots.size())
+      {
+         grow_table();
+         index = find_slot(str, hash);
+      }
+
+      auto* p_chars = static_cast<char*>(
+         m_arena.allocate(count_t{static_cast<i64_t>(str.size()) + 1}, align_t{1}));
+      if (!p_chars)
+      {
+         throw std::bad_alloc{};
+      }
+
+      std::copy(str.begin(), str.end(), p_chars);
+      p_chars[str.size()] = '\0'; // NOLINT
+
+      const auto symbol = static_cast<u32_t>(size());
+      m_entries.append(entry{p_chars, hash, static_cast<u32_t>(str.size())});
+      m_slots.lookup(index) = slot{symbol + 1, fragment_of(hash)};
+
+      return symbol_t{symbol};
+   }
+
+   auto string_interner::find(std::string_view str) const -> std::optional<symbol_t>
+   {
+      const slot& found = m_slots.lookup(find_slot(str, hash_string(str)));
+      if (found.symbol_plus_one == 0)
+      {
+         return std::nullopt;
+      }
+
+      return symbol_t{found.symbol_plus_one - 1};
+   }
+
+   auto string_interner::contains(std::string_view str) const -> bool
+   {
+      return find(str).has_value();
+   }
+
+   auto string_interner::lookup(symbol_t symbol) const -> std::string_view
+   {
+      const entry& value = m_entries.lookup(symbol.value());
+
+      return {value.p_chars, value.length};
+   }
+
+   auto string_interner::find_slot(std::string_view str, u64_t hash) const -> size_type
+   {
+      const size_type mask = m_slots.size() - 1;
+      const u32_t fragment = fragment_of(hash);
+
+      for (auto index = static_cast<size_type>(hash) & mask;; index = (index + 1) & mask)
+      {
+         const slot& current = m_slots.lookup(index);
+         if (current.symbol_plus_one == 0)
+         {
+            return index;
+         }
+
+         if (current.hash_fragment == fragment)
+         {
+            const entry& candidate = m_entries.lookup(current.symbol_plus_one - 1);
+            if (candidate.hash == hash &&
+                std::string_view{candidate.p_chars, candidate.length} == str)
+            {
+               return index;
+            }
+         }
+      }
+   }
+
+   void string_interner::grow_table()
+   {
+      const size_type new_count = m_slots.size() * 2;
+      const size_type mask = new_count - 1;
+
+      // The new table is built aside, so the current one is kept if it cannot be allocated.
+      basic_dynamic_array<slot, 0> slots{m_slots.allocator()};
+      slots.resize(new_count, slot{0, 0});
+
+      for (size_type i = 0; i < size(); ++i)
+      {
+         const u64_t hash = m_entries.lookup(i).hash;
+
+         auto index = static_cast<size_type>(hash) & mask;
+         while (slots.lookup(index).symbol_plus_one != 0)
+         {
+            index = (index + 1) & mask;
+         }
+
+         slots.lookup(index) = slot{static_cast<u32_t>(i) + 1, fragment_of(hash)};
+      }
+
+      m_slots.swap(slots);
+   }
+} // namespace caramel
@@ -0,0 +1,129 @@
+/**
+ * @file containers/string_interner.hpp
+ * @brief Contains the string_interner API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/util/strong_type.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace caramel
+{
+   /**
+    * @brief Compact identifier of a string stored in a string_interner.
+    */
+   using symbol_t = strong_type<u32_t, struct symbol_type, equatable>;
+
+   /**
+    * @brief Deduplicating string table mapping every distinct string to a 32 bit symbol.
+    *
+    * @details The characters of every distinct string are stored once, contiguously, in a
+    * monotonic arena. Lookups go through an open addressing hash table whose slots keep part of
+    * the hash of the string to skip most character comparisons, and the full hash of every string
+    * is stored so that growing the table never rehashes characters. Symbols are handed out in
+    * insertion order starting from 0 and stay valid for the lifetime of the interner.
+    */
+   class string_interner
+   {
+   public:
+      using size_type = std::int64_t;
+
+   public:
+      /**
+       * @brief Construct an interner allocating from the default memory_resource.
+       */
+      string_interner();
+      /**
+       * @brief Construct an interner allocating all of its memory from p_upstream.
+       *
+       * @param[in] p_upstream The resource the arena and the tables allocate from.
+       */
+      string_interner(gsl::not_null<memory_resource*> p_upstream);
+      string_interner(const string_interner&) = delete;
+      string_interner(string_interner&&) = delete;
+      ~string_interner() = default;
+
+      auto operator=(const string_interner&) -> string_interner& = delete;
+      auto operator=(string_interner&&) -> string_interner& = delete;
+
+      /**
+       * @brief Get the symbol of str, storing a copy of str if it was never seen before.
+       *
+       * @param[in] str The string to intern.
+       *
+       * @return The symbol associated with str.
+       *
+       * @throws std::bad_alloc If the characters could not be stored, leaving the interner
+       * unchanged.
+       */
+      auto intern(std::string_view str) -> symbol_t;
+      /**
+       * @brief Get the symbol of str without storing it.
+       *
+       * @param[in] str The string to look for.
+       *
+       * @return The symbol associated with str, if it was interned before.
+       */
+      [[nodiscard]] auto find(std::string_view str) const -> std::optional<symbol_t>;
+      /**
+       * @brief Check if str has been interned.
+       */
+      [[nodiscard]] auto contains(std::string_view str) const -> bool;
+      /**
+       * @brief Access the string associated with a symbol. The characters are null terminated.
+       *
+       * @pre `symbol` was returned by this interner.
+       */
+      [[nodiscard]] auto lookup(symbol_t symbol) const -> std::string_view;
+
+      /**
+       * @brief Check the number of distinct strings stored.
+       */
+      [[nodiscard]] auto size() const noexcept -> size_type { return m_entries.size(); }
+      /**
+       * @brief Check if no strings are stored.
+       */
+      [[nodiscard]] auto empty() const noexcept -> bool { return m_entries.empty(); }
+
+   private:
+      struct entry
+      {
+         const char* p_chars;
+         u64_t hash;
+         u32_t length;
+      };
+
+      struct slot
+      {
+         u32_t symbol_plus_one; ///< 0 marks an empty slot.
+         u32_t hash_fragment;
+      };
+
+      [[nodiscard]] auto find_slot(std::string_view str, u64_t hash) const -> size_type;
+      void grow_table();
+
+   private:
+      monotonic_resource m_arena;
+
+      basic_dynamic_array<entry, 0> m_entries;
+      basic_dynamic_array<slot, 0> m_slots;
+   };
+} // namespace caramel
+
+template <>
+struct std::hash<caramel::symbol_t>
+{
+   auto operator()(caramel::symbol_t symbol) const noexcept -> std::size_t
+   {
+      return std::hash<caramel::u32_t>{}(symbol.value());
+   }
+};
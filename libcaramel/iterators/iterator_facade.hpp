@@ -3,8 +3,10 @@
 #include <libcaramel/util/crtp.hpp>
 
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace caramel
 {
@@ -134,6 +136,10 @@ namespace caramel
       template <typename Any>
       concept single_pass_iter = bool(Any::single_pass_iterator);
 
+      template <typename Any>
+      concept contiguous_iter = random_access_iter<Any> and bool(Any::contiguous_iterator) and
+         std::is_lvalue_reference_v<decltype(std::declval<const Any&>().dereference())>;
+
       template <typename Any, typename Iter>
       concept iter_diff = std::is_convertible_v<Any, infer_difference_type_t<Iter>>;
       // clang-format on
@@ -315,6 +321,10 @@ namespace std
                // Otherwise it is a forward iterator
                std::forward_iterator_tag>>>;
 
-      using iterator_concept = iterator_category;
+      // Contiguous iterators keep the random access category, like pointers do, for the
+      // algorithms that only know the C++17 tags.
+      using iterator_concept =
+         std::conditional_t<caramel::detail::contiguous_iter<Derived>,
+                            std::contiguous_iterator_tag, iterator_category>;
    };
 } // namespace std
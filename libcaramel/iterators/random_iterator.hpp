@@ -3,6 +3,7 @@
 #include <libcaramel/iterators/iterator_facade.hpp>
 
 #include <iterator>
+#include <type_traits>
 
 namespace caramel
 {
@@ -10,22 +11,39 @@ namespace caramel
    class random_access_iterator : public iterator_facade<random_access_iterator<Any>>
    {
    public:
-      random_access_iterator() = default;
-      random_access_iterator(Any* p_value) : mp_value(p_value) {}
+      static constexpr bool contiguous_iterator = true;
 
-      [[nodiscard]] auto dereference() const noexcept -> Any& { return *mp_value; }
+   public:
+      constexpr random_access_iterator() = default;
+      constexpr random_access_iterator(Any* p_value) : mp_value(p_value) {}
+      template <typename Other>
+         requires(not std::is_same_v<Other, Any> and std::is_convertible_v<Other*, Any*>)
+      constexpr random_access_iterator(random_access_iterator<Other> other) :
+         mp_value(other.mp_value)
+      {}
+
+      [[nodiscard]] constexpr auto dereference() const noexcept -> Any& { return *mp_value; }
+      /**
+       * @brief Get the pointer without dereferencing it, so that std::to_address is valid on
+       * past-the-end and null iterators.
+       */
+      [[nodiscard]] constexpr auto operator->() const noexcept -> Any* { return mp_value; }
 
-      void advance(std::ptrdiff_t off) noexcept { mp_value += off; }
-      [[nodiscard]] auto distance_to(random_access_iterator other) const noexcept -> std::ptrdiff_t
+      constexpr void advance(std::ptrdiff_t off) noexcept { mp_value += off; }
+      [[nodiscard]] constexpr auto distance_to(random_access_iterator other) const noexcept
+         -> std::ptrdiff_t
       {
          return other.mp_value - mp_value;
       }
-      auto operator==(random_access_iterator other) const noexcept -> bool
+      constexpr auto operator==(random_access_iterator other) const noexcept -> bool
       {
          return other.mp_value == mp_value;
       }
 
    private:
       Any* mp_value{nullptr};
+
+      template <typename Other>
+      friend class random_access_iterator;
    };
 } // namespace caramel
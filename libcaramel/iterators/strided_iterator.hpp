@@ -0,0 +1,60 @@
+#pragma once
+
+#include <libcaramel/iterators/iterator_facade.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+namespace caramel
+{
+   /**
+    * @brief Random access iterator visiting every stride-th element of an array, such as a
+    * column of a row-major matrix.
+    *
+    * @details The iterator keeps the first element and an index rather than a moving pointer, so
+    * the past-the-end iterator of a range never points beyond the underlying array.
+    */
+   template <typename Any>
+   class strided_iterator : public iterator_facade<strided_iterator<Any>>
+   {
+   public:
+      constexpr strided_iterator() = default;
+      constexpr strided_iterator(Any* p_first, std::ptrdiff_t index, std::ptrdiff_t stride) :
+         mp_first(p_first), m_index(index), m_stride(stride)
+      {}
+      template <typename Other>
+         requires(not std::is_same_v<Other, Any> and std::is_convertible_v<Other*, Any*>)
+      constexpr strided_iterator(strided_iterator<Other> other) :
+         mp_first(other.mp_first), m_index(other.m_index), m_stride(other.m_stride)
+      {}
+
+      [[nodiscard]] constexpr auto dereference() const noexcept -> Any&
+      {
+         return mp_first[m_index * m_stride]; // NOLINT
+      }
+
+      constexpr void advance(std::ptrdiff_t off) noexcept { m_index += off; }
+      [[nodiscard]] constexpr auto distance_to(strided_iterator other) const noexcept
+         -> std::ptrdiff_t
+      {
+         return other.m_index - m_index;
+      }
+      constexpr auto operator==(strided_iterator other) const noexcept -> bool
+      {
+         return other.m_index == m_index;
+      }
+
+      /**
+       * @brief Get the number of elements between two consecutive visited elements.
+       */
+      [[nodiscard]] constexpr auto stride() const noexcept -> std::ptrdiff_t { return m_stride; }
+
+   private:
+      Any* mp_first{nullptr};
+      std::ptrdiff_t m_index{0};
+      std::ptrdiff_t m_stride{1};
+
+      template <typename Other>
+      friend class strided_iterator;
+   };
+} // namespace caramel
@@ -1,5 +1,13 @@
 #pragma once
 
-#include <libcaramel/memory/allocator.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+#include <libcaramel/memory/fixed_block_resource.hpp>
 #include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/inline_resource.hpp>
+#include <libcaramel/memory/memory_allocator.hpp>
 #include <libcaramel/memory/memory_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/numa_resource.hpp>
+#include <libcaramel/memory/object_pool.hpp>
+#include <libcaramel/memory/profiling_resource.hpp>
+#include <libcaramel/memory/static_allocator.hpp>
@@ -0,0 +1,333 @@
+#include <libcaramel/memory/checked_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace caramel
+{
+   namespace
+   {
+      constexpr u64_t live_tag_seed = 0xa110ca7edb10c4edULL;  // NOLINT
+      constexpr u64_t freed_tag_seed = 0xf7eedb10c4ed0000ULL; // NOLINT
+      constexpr u64_t canary = 0xca7a7ca7a7ca7a7cULL;         // NOLINT
+      constexpr i64_t canary_size = sizeof(canary);
+      constexpr unsigned char poison = 0xdd; // NOLINT
+
+      /**
+       * Tags depend on the address of the header so that a copied header is not mistaken for a
+       * valid one.
+       */
+      auto make_tag(u64_t seed, const void* p_header) noexcept -> u64_t
+      {
+         return seed ^ reinterpret_cast<std::uintptr_t>(p_header); // NOLINT
+      }
+
+      auto round_up(i64_t value, i64_t alignment) noexcept -> i64_t
+      {
+         return (value + alignment - 1) & ~(alignment - 1);
+      }
+   } // namespace
+
+   auto to_string(memory_error error) noexcept -> std::string_view
+   {
+      switch (error)
+      {
+         case memory_error::size_mismatch:
+            return "size mismatch";
+         case memory_error::alignment_mismatch:
+            return "alignment mismatch";
+         case memory_error::double_free:
+            return "double free";
+         case memory_error::invalid_pointer:
+            return "invalid pointer";
+         case memory_error::buffer_overflow:
+            return "buffer overflow";
+         case memory_error::use_after_free:
+            return "use after free";
+         case memory_error::leak:
+            return "leak";
+      }
+
+      return "unknown";
+   }
+
+   void default_memory_error_handler(const memory_error_info& info)
+   {
+      const std::string_view name = to_string(info.error);
+
+      std::fprintf(stderr, // NOLINT
+                   "libcaramel: %.*s at %p (allocated with %lld bytes aligned to %lld, "
+                   "deallocated with %lld bytes aligned to %lld)\n",
+                   static_cast<int>(name.size()), name.data(), info.p_address,
+                   static_cast<long long>(info.expected_bytes),
+                   static_cast<long long>(info.expected_alignment),
+                   static_cast<long long>(info.actual_bytes),
+                   static_cast<long long>(info.actual_alignment));
+
+      if (info.error != memory_error::leak)
+      {
+         std::abort();
+      }
+   }
+
+   void checked_resource::block_list::push_back(header* p_block) noexcept
+   {
+      p_block->p_prev = p_last;
+      p_block->p_next = nullptr;
+
+      if (p_last)
+      {
+         p_last->p_next = p_block;
+      }
+      else
+      {
+         p_first = p_block;
+      }
+
+      p_last = p_block;
+   }
+   void checked_resource::block_list::remove(header* p_block) noexcept
+   {
+      if (p_block->p_prev)
+      {
+         p_block->p_prev->p_next = p_block->p_next;
+      }
+      else
+      {
+         p_first = p_block->p_next;
+      }
+
+      if (p_block->p_next)
+      {
+         p_block->p_next->p_prev = p_block->p_prev;
+      }
+      else
+      {
+         p_last = p_block->p_prev;
+      }
+
+      p_block->p_prev = nullptr;
+      p_block->p_next = nullptr;
+   }
+
+   checked_resource::checked_resource() :
+      checked_resource(gsl::make_not_null(get_default_memory_resource()))
+   {}
+   checked_resource::checked_resource(gsl::not_null<memory_resource*> p_upstream,
+                                      checked_resource_options options,
+                                      memory_error_handler handler) :
+      mp_upstream{p_upstream.get()},
+      m_options{options}, m_handler{std::move(handler)}
+   {
+      Expects(options.quarantine_bytes >= 0);
+   }
+   checked_resource::~checked_resource() noexcept
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      evict_quarantine(0);
+      report_live_blocks();
+   }
+
+   auto checked_resource::allocate(count_t bytes, align_t alignment) noexcept -> pointer
+   {
+      Expects(bytes.value() >= 0);
+      Expects(alignment.value() > 0);
+
+      const i64_t block_alignment =
+         std::max(alignment.value(), static_cast<i64_t>(alignof(header)));
+      const i64_t offset = round_up(sizeof(header), block_alignment);
+
+      auto* p_base = static_cast<std::byte*>(mp_upstream->allocate(
+         count_t{offset + bytes.value() + canary_size}, align_t{block_alignment}));
+      if (!p_base)
+      {
+         return nullptr;
+      }
+
+      std::byte* p_user = p_base + offset;                   // NOLINT
+      std::byte* p_header_storage = p_user - sizeof(header); // NOLINT
+
+      auto* p_header = new (p_header_storage)
+         header{nullptr, nullptr, bytes.value(), alignment.value(), offset, 0};
+      p_header->tag = make_tag(live_tag_seed, p_header);
+
+      std::memcpy(p_user + bytes.value(), &canary, sizeof(canary)); // NOLINT
+
+      const std::scoped_lock lock{m_mutex};
+
+      m_live.push_back(p_header);
+      ++m_live_count;
+      m_live_bytes += bytes.value();
+
+      return p_user;
+   }
+   void checked_resource::deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                                     align_t alignment) noexcept
+   {
+      auto* p_user = static_cast<std::byte*>(ptr.get());
+      auto* p_header = reinterpret_cast<header*>(p_user - sizeof(header)); // NOLINT
+
+      const std::scoped_lock lock{m_mutex};
+
+      if (p_header->tag == make_tag(freed_tag_seed, p_header))
+      {
+         report({memory_error::double_free, p_user, p_header->bytes, bytes.value(),
+                 p_header->alignment, alignment.value()});
+         return;
+      }
+
+      if (p_header->tag != make_tag(live_tag_seed, p_header))
+      {
+         report({memory_error::invalid_pointer, p_user, bytes.value(), bytes.value(),
+                 alignment.value(), alignment.value()});
+         return;
+      }
+
+      const memory_error_info info{memory_error::size_mismatch, p_user,
+                                   p_header->bytes,             bytes.value(),
+                                   p_header->alignment,         alignment.value()};
+      if (p_header->bytes != bytes.value())
+      {
+         report(info);
+      }
+
+      if (p_header->alignment != alignment.value())
+      {
+         auto mismatch = info;
+         mismatch.error = memory_error::alignment_mismatch;
+         report(mismatch);
+      }
+
+      if (std::memcmp(p_user + p_header->bytes, &canary, sizeof(canary)) != 0) // NOLINT
+      {
+         auto overflow = info;
+         overflow.error = memory_error::buffer_overflow;
+         report(overflow);
+      }
+
+      m_live.remove(p_header);
+      --m_live_count;
+      m_live_bytes -= p_header->bytes;
+
+      p_header->tag = make_tag(freed_tag_seed, p_header);
+      if (m_options.poison_freed)
+      {
+         std::memset(p_user, poison, static_cast<std::size_t>(p_header->bytes));
+      }
+
+      if (m_options.quarantine_bytes > 0)
+      {
+         m_quarantine.push_back(p_header);
+         m_quarantine_bytes += footprint(p_header);
+
+         evict_quarantine(m_options.quarantine_bytes);
+      }
+      else
+      {
+         release_block(p_header);
+      }
+   }
+   auto checked_resource::is_equal(const memory_resource& other) const noexcept -> bool
+   {
+      return this == &other;
+   }
+
+   auto checked_resource::report_leaks() -> i64_t
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      report_live_blocks();
+
+      return m_live_count;
+   }
+
+   auto checked_resource::live_allocations() const -> i64_t
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      return m_live_count;
+   }
+   auto checked_resource::live_bytes() const -> i64_t
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      return m_live_bytes;
+   }
+
+   auto checked_resource::upstream() const noexcept -> memory_resource* { return mp_upstream; }
+
+   void checked_resource::release_block(header* p_block) noexcept
+   {
+      const i64_t block_alignment =
+         std::max(p_block->alignment, static_cast<i64_t>(alignof(header)));
+      const i64_t total = footprint(p_block);
+
+      auto* p_header_storage = reinterpret_cast<std::byte*>(p_block); // NOLINT
+      std::byte* p_base = p_header_storage + sizeof(header) - p_block->offset; // NOLINT
+
+      std::destroy_at(p_block);
+      mp_upstream->deallocate(gsl::make_not_null(static_cast<pointer>(p_base)), count_t{total},
+                              align_t{block_alignment});
+   }
+   auto checked_resource::footprint(const header* p_block) noexcept -> i64_t
+   {
+      return p_block->offset + p_block->bytes + canary_size;
+   }
+   void checked_resource::evict_quarantine(i64_t max_bytes) noexcept
+   {
+      while (m_quarantine_bytes > max_bytes && m_quarantine.p_first)
+      {
+         header* p_block = m_quarantine.p_first;
+         m_quarantine.remove(p_block);
+         m_quarantine_bytes -= footprint(p_block);
+
+         auto* p_user = reinterpret_cast<std::byte*>(p_block) + sizeof(header); // NOLINT
+         if (m_options.poison_freed)
+         {
+            const auto* p_first = reinterpret_cast<const unsigned char*>(p_user); // NOLINT
+            const auto* p_last = p_first + p_block->bytes;                        // NOLINT
+            if (std::any_of(p_first, p_last, [](unsigned char c) { return c != poison; }))
+            {
+               report({memory_error::use_after_free, p_user, p_block->bytes, p_block->bytes,
+                       p_block->alignment, p_block->alignment});
+            }
+         }
+
+         release_block(p_block);
+      }
+   }
+   void checked_resource::report_live_blocks() noexcept
+   {
+      for (header* p_block = m_live.p_first; p_block; p_block = p_block->p_next)
+      {
+         auto* p_user = reinterpret_cast<std::byte*>(p_block) + sizeof(header); // NOLINT
+         report({memory_error::leak, p_user, p_block->bytes, p_block->bytes, p_block->alignment,
+                 p_block->alignment});
+      }
+   }
+   void checked_resource::report(const memory_error_info& info) noexcept
+   {
+      if (!m_handler)
+      {
+         return;
+      }
+
+      try
+      {
+         m_handler(info);
+      }
+      catch (...)
+      {
+         // A throwing handler cannot propagate out of a noexcept deallocation.
+      }
+   }
+} // namespace caramel
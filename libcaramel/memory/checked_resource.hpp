@@ -0,0 +1,198 @@
+/**
+ * @file memory/checked_resource.hpp
+ * @brief Contains the checked_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+namespace caramel
+{
+   /**
+    * @brief The misuses a checked_resource detects.
+    */
+   enum struct memory_error
+   {
+      size_mismatch,      ///< Deallocated with a size different from the allocation.
+      alignment_mismatch, ///< Deallocated with an alignment different from the allocation.
+      double_free,        ///< Deallocated a second time.
+      invalid_pointer,    ///< Deallocated a pointer the resource never handed out.
+      buffer_overflow,    ///< Wrote past the end of the allocation.
+      use_after_free,     ///< Wrote to the allocation while it was in quarantine.
+      leak                ///< Never deallocated.
+   };
+
+   /**
+    * @brief Get a short, stable, name for an error, suitable for logs.
+    */
+   auto to_string(memory_error error) noexcept -> std::string_view;
+
+   /**
+    * @brief Description of a misuse detected by a checked_resource.
+    *
+    * @details The expected values are the ones recorded at allocation, the actual values the ones
+    * given to deallocate. Both are equal when they are not relevant to the error.
+    */
+   struct memory_error_info
+   {
+      memory_error error;
+      const void* p_address;
+
+      i64_t expected_bytes;
+      i64_t actual_bytes;
+      i64_t expected_alignment;
+      i64_t actual_alignment;
+   };
+
+   /**
+    * @brief Handler called for every detected misuse.
+    */
+   using memory_error_handler = std::function<void(const memory_error_info&)>;
+
+   /**
+    * @brief Print the error to stderr and abort, except for leaks which are only printed.
+    */
+   void default_memory_error_handler(const memory_error_info& info);
+
+   struct checked_resource_options
+   {
+      /// Fill deallocated memory with a pattern, checked when the block leaves the quarantine.
+      bool poison_freed{true};
+      /// Number of deallocated bytes, headers and canaries included, kept away from the upstream
+      /// resource so double frees and writes after free keep being detected for a while. 0
+      /// returns memory immediately.
+      i64_t quarantine_bytes{0};
+   };
+
+   /**
+    * @brief memory_resource detecting misuse of the memory it hands out, at a bounded cost.
+    *
+    * @details Every allocation is preceded by a header recording its size and alignment and
+    * followed by a canary. Deallocation checks the size, the alignment, the header and the canary
+    * before returning the memory to the upstream resource. The live allocations are kept in an
+    * intrusive list so leaks are reported when the resource is destroyed.
+    *
+    * The overhead is one header (48 bytes, rounded up to the alignment) and an 8 byte canary per
+    * allocation, a lock per call, and the quarantine if one is requested. No sanitizer build is
+    * needed, so the resource can wrap the default memory_resource of a canary deployment.
+    */
+   class checked_resource : public memory_resource
+   {
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+   public:
+      /**
+       * @brief Construct the resource using the default memory_resource as upstream.
+       */
+      checked_resource();
+      /**
+       * @brief Construct the resource with a given upstream resource.
+       *
+       * @pre `options.quarantine_bytes >= 0`, otherwise UB
+       *
+       * @param[in] p_upstream The resource to allocate the checked blocks from.
+       * @param[in] options What to check beyond sizes, alignments and canaries.
+       * @param[in] handler Called for every detected misuse, while the resource is locked: it
+       * must not use the resource.
+       */
+      checked_resource(gsl::not_null<memory_resource*> p_upstream,
+                       checked_resource_options options = {},
+                       memory_error_handler handler = default_memory_error_handler);
+      checked_resource(const checked_resource&) = delete;
+      checked_resource(checked_resource&&) = delete;
+      /**
+       * @brief Flush the quarantine and report every allocation still alive as a leak. Leaked
+       * memory is not returned to the upstream resource.
+       */
+      ~checked_resource() noexcept override;
+
+      auto operator=(const checked_resource&) -> checked_resource& = delete;
+      auto operator=(checked_resource&&) -> checked_resource& = delete;
+
+      /**
+       * @brief Allocate a block surrounded by a header and a canary.
+       *
+       * @pre `bytes >= 0`, otherwise UB
+       * @pre `alignment > 0` and a power of two, otherwise UB
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override;
+      /**
+       * @brief Check the block and return it to the upstream resource or the quarantine. Blocks
+       * failing a check of their header are never returned upstream.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override;
+      /**
+       * @brief Check if other is this resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override;
+
+      /**
+       * @brief Report every allocation currently alive as a leak.
+       *
+       * @return The number of allocations reported.
+       */
+      auto report_leaks() -> i64_t;
+
+      /**
+       * @brief Get the number of allocations currently alive.
+       */
+      [[nodiscard]] auto live_allocations() const -> i64_t;
+      /**
+       * @brief Get the number of bytes requested by the allocations currently alive.
+       */
+      [[nodiscard]] auto live_bytes() const -> i64_t;
+
+      /**
+       * @brief Access the upstream resource.
+       */
+      [[nodiscard]] auto upstream() const noexcept -> memory_resource*;
+
+   private:
+      struct header
+      {
+         header* p_prev;
+         header* p_next;
+         i64_t bytes;
+         i64_t alignment;
+         i64_t offset;
+         u64_t tag; ///< Last member so that underflows overwrite it.
+      };
+
+      struct block_list
+      {
+         header* p_first{nullptr};
+         header* p_last{nullptr};
+
+         void push_back(header* p_block) noexcept;
+         void remove(header* p_block) noexcept;
+      };
+
+      void release_block(header* p_block) noexcept;
+      /// Number of bytes taken from the upstream resource by a block.
+      static auto footprint(const header* p_block) noexcept -> i64_t;
+      void evict_quarantine(i64_t max_bytes) noexcept;
+      void report_live_blocks() noexcept;
+      void report(const memory_error_info& info) noexcept;
+
+   private:
+      memory_resource* mp_upstream;
+      checked_resource_options m_options;
+      memory_error_handler m_handler;
+
+      mutable std::mutex m_mutex;
+      block_list m_live;
+      block_list m_quarantine;
+      i64_t m_live_count{0};
+      i64_t m_live_bytes{0};
+      i64_t m_quarantine_bytes{0};
+   };
+} // namespace caramel
@@ -0,0 +1,134 @@
+#include <libcaramel/memory/fixed_block_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace caramel
+{
+   namespace
+   {
+      auto round_up(i64_t value, i64_t alignment) noexcept -> i64_t
+      {
+         return (value + alignment - 1) & ~(alignment - 1);
+      }
+   } // namespace
+
+   fixed_block_resource::fixed_block_resource(count_t block_size,
+                                              align_t block_alignment) noexcept :
+      fixed_block_resource(block_size, block_alignment,
+                           gsl::make_not_null(get_default_memory_resource()))
+   {}
+   fixed_block_resource::fixed_block_resource(count_t block_size, align_t block_alignment,
+                                              gsl::not_null<memory_resource*> p_upstream,
+                                              count_t blocks_per_slab) noexcept :
+      mp_upstream{p_upstream.get()},
+      m_block_alignment{std::max(block_alignment.value(),
+                                 static_cast<i64_t>(alignof(free_block)))},
+      m_next_slab_blocks{blocks_per_slab.value()}
+   {
+      Expects(block_size.value() > 0);
+      Expects(block_alignment.value() > 0);
+      Expects(blocks_per_slab.value() > 0);
+
+      const i64_t link_size = sizeof(free_block);
+      m_block_size = round_up(std::max(block_size.value(), link_size), m_block_alignment);
+   }
+   fixed_block_resource::~fixed_block_resource() noexcept { release(); }
+
+   auto fixed_block_resource::allocate(count_t bytes, align_t alignment) noexcept -> pointer
+   {
+      Expects(bytes.value() >= 0);
+      Expects(alignment.value() > 0);
+
+      if (!is_pooled(bytes.value(), alignment.value()))
+      {
+         return mp_upstream->allocate(bytes, alignment);
+      }
+
+      if (mp_free)
+      {
+         free_block* p_block = mp_free;
+         mp_free = p_block->p_next;
+
+         return p_block;
+      }
+
+      if (mp_current == mp_end && !acquire_slab())
+      {
+         return nullptr;
+      }
+
+      std::byte* p_block = mp_current;
+      mp_current += m_block_size; // NOLINT
+
+      return p_block;
+   }
+   void fixed_block_resource::deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                                         align_t alignment) noexcept
+   {
+      if (!is_pooled(bytes.value(), alignment.value()))
+      {
+         mp_upstream->deallocate(ptr, bytes, alignment);
+
+         return;
+      }
+
+      mp_free = new (ptr.get()) free_block{mp_free};
+   }
+   auto fixed_block_resource::is_equal(const memory_resource& other) const noexcept -> bool
+   {
+      return this == &other;
+   }
+
+   void fixed_block_resource::release() noexcept
+   {
+      while (mp_slabs)
+      {
+         slab_header* p_next = mp_slabs->p_next;
+         mp_upstream->deallocate(gsl::make_not_null(static_cast<pointer>(mp_slabs)),
+                                 count_t{mp_slabs->size}, align_t{mp_slabs->alignment});
+         mp_slabs = p_next;
+      }
+
+      mp_free = nullptr;
+      mp_current = nullptr;
+      mp_end = nullptr;
+   }
+
+   auto fixed_block_resource::block_size() const noexcept -> i64_t { return m_block_size; }
+   auto fixed_block_resource::block_alignment() const noexcept -> i64_t
+   {
+      return m_block_alignment;
+   }
+   auto fixed_block_resource::upstream() const noexcept -> memory_resource* { return mp_upstream; }
+
+   auto fixed_block_resource::is_pooled(i64_t bytes, i64_t alignment) const noexcept -> bool
+   {
+      return bytes <= m_block_size && alignment <= m_block_alignment;
+   }
+
+   auto fixed_block_resource::acquire_slab() noexcept -> bool
+   {
+      const i64_t slab_alignment =
+         std::max(m_block_alignment, static_cast<i64_t>(alignof(slab_header)));
+      const i64_t header_size = round_up(static_cast<i64_t>(sizeof(slab_header)), slab_alignment);
+      const i64_t slab_size = header_size + m_next_slab_blocks * m_block_size;
+
+      auto* p_memory = static_cast<std::byte*>(
+         mp_upstream->allocate(count_t{slab_size}, align_t{slab_alignment}));
+      if (!p_memory)
+      {
+         return false;
+      }
+
+      mp_slabs = new (p_memory) slab_header{mp_slabs, slab_size, slab_alignment};
+      mp_current = p_memory + header_size; // NOLINT
+      mp_end = p_memory + slab_size;       // NOLINT
+      m_next_slab_blocks *= 2;
+
+      return true;
+   }
+} // namespace caramel
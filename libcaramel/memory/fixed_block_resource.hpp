@@ -0,0 +1,140 @@
+/**
+ * @file memory/fixed_block_resource.hpp
+ * @brief Contains the fixed_block_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+namespace caramel
+{
+   /**
+    * @brief Pool handing out blocks of one size, carved from slabs acquired from an upstream
+    * resource.
+    *
+    * @details Freed blocks are kept in an intrusive free list, threaded through the blocks
+    * themselves, and handed out again first, so allocation and deallocation are O(1) and recently
+    * freed, still cached, blocks are reused. Slabs are carved lazily, each one holding twice as
+    * many blocks as the previous one, and are only returned to the upstream resource on
+    * release() or destruction.
+    *
+    * Requests larger than a block or more aligned than the blocks are forwarded to the upstream
+    * resource, so the pool may back any allocator. It is not synchronized: a pool per thread,
+    * for instance a `thread_local` one, gives every thread its own cache of blocks.
+    */
+   class fixed_block_resource : public memory_resource
+   {
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+      static constexpr i64_t default_blocks_per_slab = 64;
+
+   public:
+      /**
+       * @brief Construct the pool using the default memory_resource as upstream.
+       *
+       * @pre `block_size > 0`, otherwise UB
+       * @pre `block_alignment > 0` and a power of two, otherwise UB
+       *
+       * @param[in] block_size The size in bytes of the blocks.
+       * @param[in] block_alignment The alignment in bytes of the blocks.
+       */
+      fixed_block_resource(count_t block_size, align_t block_alignment) noexcept;
+      /**
+       * @brief Construct the pool with a given upstream resource.
+       *
+       * @pre `block_size > 0`, otherwise UB
+       * @pre `block_alignment > 0` and a power of two, otherwise UB
+       * @pre `blocks_per_slab > 0`, otherwise UB
+       *
+       * @param[in] block_size The size in bytes of the blocks.
+       * @param[in] block_alignment The alignment in bytes of the blocks.
+       * @param[in] p_upstream The resource to acquire the slabs from.
+       * @param[in] blocks_per_slab The number of blocks of the first slab.
+       */
+      fixed_block_resource(count_t block_size, align_t block_alignment,
+                           gsl::not_null<memory_resource*> p_upstream,
+                           count_t blocks_per_slab = count_t{default_blocks_per_slab}) noexcept;
+      fixed_block_resource(const fixed_block_resource&) = delete;
+      fixed_block_resource(fixed_block_resource&&) = delete;
+      ~fixed_block_resource() noexcept override;
+
+      auto operator=(const fixed_block_resource&) -> fixed_block_resource& = delete;
+      auto operator=(fixed_block_resource&&) -> fixed_block_resource& = delete;
+
+      /**
+       * @brief Take a block from the free list, or carve one from the current slab, acquiring a
+       * new slab if needed.
+       *
+       * @pre `bytes >= 0`, otherwise UB
+       * @pre `alignment > 0` and a power of two, otherwise UB
+       *
+       * @param[in] bytes The size of the allocation in bytes
+       * @param[in] alignment The alignment of the allocation in bytes
+       *
+       * @return A valid pointer to a memory chunk or nullptr if the upstream allocation failed
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override;
+      /**
+       * @brief Push a block on the free list, or return a forwarded allocation to the upstream
+       * resource.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override;
+      /**
+       * @brief Check if other is this resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override;
+
+      /**
+       * @brief Return every slab to the upstream resource. Every block handed out by the pool
+       * becomes dangling.
+       */
+      void release() noexcept;
+
+      /**
+       * @brief Get the size of the blocks, rounded up to hold a free list link and keep the
+       * blocks aligned.
+       */
+      [[nodiscard]] auto block_size() const noexcept -> i64_t;
+      /**
+       * @brief Get the alignment of the blocks.
+       */
+      [[nodiscard]] auto block_alignment() const noexcept -> i64_t;
+      /**
+       * @brief Access the upstream resource.
+       */
+      [[nodiscard]] auto upstream() const noexcept -> memory_resource*;
+
+   private:
+      struct slab_header
+      {
+         slab_header* p_next;
+         i64_t size;
+         i64_t alignment;
+      };
+
+      struct free_block
+      {
+         free_block* p_next;
+      };
+
+      [[nodiscard]] auto is_pooled(i64_t bytes, i64_t alignment) const noexcept -> bool;
+      auto acquire_slab() noexcept -> bool;
+
+   private:
+      memory_resource* mp_upstream;
+
+      i64_t m_block_size;
+      i64_t m_block_alignment;
+      i64_t m_next_slab_blocks;
+
+      free_block* mp_free{nullptr};
+      slab_header* mp_slabs{nullptr};
+      std::byte* mp_current{nullptr};
+      std::byte* mp_end{nullptr};
+   };
+} // namespace caramel
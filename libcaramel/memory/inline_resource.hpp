@@ -0,0 +1,148 @@
+/**
+ * @file memory/inline_resource.hpp
+ * @brief Contains the inline_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace caramel
+{
+   /**
+    * @brief Resource bump allocating from a buffer it holds, falling back to an upstream resource
+    * once the buffer is exhausted.
+    *
+    * @details Meant to live on the stack of a function building several temporary containers,
+    * so that they all share one buffer instead of each having its own static capacity, and cause
+    * no heap traffic in the common case. Deallocating the latest allocation from the buffer gives
+    * its bytes back, other buffer allocations are only reclaimed when the resource is destroyed.
+    * Allocations from the upstream resource are returned to it as soon as they are deallocated.
+    *
+    * @tparam Bytes The size of the buffer.
+    */
+   template <i64_t Bytes>
+   class inline_resource : public memory_resource
+   {
+      static_assert(Bytes > 0, "The buffer of an inline_resource cannot be empty");
+
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+      static constexpr i64_t buffer_size = Bytes;
+
+   public:
+      /**
+       * @brief Construct the resource using the default memory_resource as upstream.
+       */
+      inline_resource() noexcept :
+         inline_resource(gsl::make_not_null(get_default_memory_resource()))
+      {}
+      /**
+       * @brief Construct the resource with a given upstream resource.
+       *
+       * @param[in] p_upstream The resource used once the buffer is exhausted.
+       */
+      inline_resource(gsl::not_null<memory_resource*> p_upstream) noexcept :
+         mp_upstream{p_upstream.get()}
+      {}
+      inline_resource(const inline_resource&) = delete;
+      inline_resource(inline_resource&&) = delete;
+      ~inline_resource() noexcept override = default;
+
+      auto operator=(const inline_resource&) -> inline_resource& = delete;
+      auto operator=(inline_resource&&) -> inline_resource& = delete;
+
+      /**
+       * @brief Bump allocate bytes from the buffer, or from the upstream resource if they do not
+       * fit.
+       *
+       * @pre `bytes >= 0`, otherwise UB
+       * @pre `alignment > 0` and a power of two, otherwise UB
+       *
+       * @param[in] bytes The size of the allocation in bytes
+       * @param[in] alignment The alignment of the allocation in bytes
+       *
+       * @return A valid pointer to a memory chunk or nullptr if the upstream allocation failed
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override
+      {
+         Expects(bytes.value() >= 0);
+         Expects(alignment.value() > 0);
+
+         const auto address = reinterpret_cast<std::uintptr_t>(mp_current); // NOLINT
+         const auto mask = static_cast<std::uintptr_t>(alignment.value() - 1);
+         const auto padding = static_cast<i64_t>(((address + mask) & ~mask) - address);
+
+         // Even empty allocations take a byte, so that every pointer into the buffer is before
+         // its end and deallocate() can tell it from upstream memory that may follow the buffer.
+         if (end() - mp_current - padding < std::max(bytes.value(), i64_t{1}))
+         {
+            return mp_upstream->allocate(bytes, alignment);
+         }
+
+         std::byte* p_result = mp_current + padding; // NOLINT
+         mp_current = p_result + bytes.value();      // NOLINT
+
+         return p_result;
+      }
+      /**
+       * @brief Give the bytes of the latest buffer allocation back, or return an upstream
+       * allocation to the upstream resource.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override
+      {
+         auto* p_bytes = static_cast<std::byte*>(ptr.get());
+         if (!owns(p_bytes))
+         {
+            mp_upstream->deallocate(ptr, bytes, alignment);
+         }
+         else if (p_bytes + bytes.value() == mp_current) // NOLINT
+         {
+            mp_current = p_bytes;
+         }
+      }
+      /**
+       * @brief Check if other is this resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override
+      {
+         return this == &other;
+      }
+
+      /**
+       * @brief Get the number of bytes of the buffer in use, padding included.
+       */
+      [[nodiscard]] auto used() const noexcept -> i64_t { return mp_current - m_buffer; }
+
+      /**
+       * @brief Access the upstream resource.
+       */
+      [[nodiscard]] auto upstream() const noexcept -> memory_resource* { return mp_upstream; }
+
+   private:
+      auto end() noexcept -> std::byte* { return m_buffer + Bytes; } // NOLINT
+      auto owns(const std::byte* p_bytes) const noexcept -> bool
+      {
+         const auto address = reinterpret_cast<std::uintptr_t>(p_bytes); // NOLINT
+
+         return address >= reinterpret_cast<std::uintptr_t>(m_buffer) &&       // NOLINT
+                address < reinterpret_cast<std::uintptr_t>(m_buffer + Bytes); // NOLINT
+      }
+
+   private:
+      memory_resource* mp_upstream;
+      std::byte* mp_current{m_buffer};
+
+      alignas(std::max_align_t) std::byte m_buffer[Bytes]; // NOLINT
+   };
+} // namespace caramel
@@ -6,6 +6,7 @@
 #include <libcaramel/util/crtp.hpp>
 #include <libcaramel/util/types.hpp>
 
+#include <gsl/gsl_assert>
 #include <gsl/pointers>
 
 namespace caramel
@@ -34,13 +35,24 @@ namespace caramel
          return static_cast<pointer>(
             mp_resource->allocate(count_t{sizeof(Any)} * count, align_t{alignof(Any)}));
       }
+      auto allocate(count_t count, align_t alignment) -> pointer
+      {
+         Expects(alignment.value() >= static_cast<i64_t>(alignof(Any)));
+
+         return static_cast<pointer>(mp_resource->allocate(count_t{sizeof(Any)} * count, alignment));
+      }
       void deallocate(gsl::not_null<pointer> ptr, count_t count)
       {
          mp_resource->deallocate(gsl::make_not_null(static_cast<memory_resource::pointer>(ptr)),
                                  count_t{sizeof(Any)} * count, align_t{alignof(Any)});
       }
+      void deallocate(gsl::not_null<pointer> ptr, count_t count, align_t alignment)
+      {
+         mp_resource->deallocate(gsl::make_not_null(static_cast<memory_resource::pointer>(ptr)),
+                                 count_t{sizeof(Any)} * count, alignment);
+      }
 
-      auto resource() noexcept -> memory_resource* { return mp_resource; }
+      auto resource() const noexcept -> memory_resource* { return mp_resource; }
 
    private:
       memory_resource* mp_resource{nullptr};
@@ -0,0 +1,66 @@
+#include <libcaramel/memory/monotonic_resource.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace caramel
+{
+   monotonic_resource::monotonic_resource() noexcept :
+      monotonic_resource(gsl::make_not_null(get_default_memory_resource()))
+   {}
+   monotonic_resource::monotonic_resource(gsl::not_null<memory_resource*> p_upstream,
+                                          count_t initial_size) noexcept :
+      mp_upstream{p_upstream.get()},
+      m_next_chunk_size{initial_size.value()}
+   {
+      Expects(initial_size.value() > 0);
+   }
+   monotonic_resource::~monotonic_resource() noexcept { release(); }
+
+   auto monotonic_resource::is_equal(const memory_resource& other) const noexcept -> bool
+   {
+      return this == &other;
+   }
+
+   void monotonic_resource::release() noexcept
+   {
+      while (mp_chunks)
+      {
+         chunk_header* p_next = mp_chunks->p_next;
+         mp_upstream->deallocate(gsl::make_not_null(static_cast<pointer>(mp_chunks)),
+                                 count_t{mp_chunks->size}, align_t{mp_chunks->alignment});
+         mp_chunks = p_next;
+      }
+
+      mp_current = nullptr;
+      mp_end = nullptr;
+   }
+
+   auto monotonic_resource::upstream() const noexcept -> memory_resource* { return mp_upstream; }
+
+   auto monotonic_resource::acquire_chunk(i64_t min_bytes, i64_t alignment) noexcept -> bool
+   {
+      const i64_t chunk_alignment =
+         std::max(alignment, static_cast<i64_t>(alignof(std::max_align_t)));
+      const i64_t header_size =
+         (static_cast<i64_t>(sizeof(chunk_header)) + chunk_alignment - 1) & ~(chunk_alignment - 1);
+      const i64_t chunk_size = std::max(m_next_chunk_size, header_size + min_bytes);
+
+      auto* p_memory = static_cast<std::byte*>(
+         mp_upstream->allocate(count_t{chunk_size}, align_t{chunk_alignment}));
+      if (!p_memory)
+      {
+         return false;
+      }
+
+      auto* p_header = new (p_memory) chunk_header{mp_chunks, chunk_size, chunk_alignment};
+
+      mp_chunks = p_header;
+      mp_current = p_memory + header_size; // NOLINT
+      mp_end = p_memory + chunk_size;      // NOLINT
+      m_next_chunk_size = chunk_size * 2;
+
+      return true;
+   }
+} // namespace caramel
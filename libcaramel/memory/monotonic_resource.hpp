@@ -0,0 +1,139 @@
+/**
+ * @file memory/monotonic_resource.hpp
+ * @brief Contains the monotonic_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <cstdint>
+
+namespace caramel
+{
+   /**
+    * @brief Arena allocator handing out memory from chunks acquired from an upstream resource.
+    *
+    * @details Allocation bumps a pointer within the current chunk, deallocation does nothing and
+    * every chunk is returned to the upstream resource at once on release() or destruction. Each
+    * new chunk is twice as large as the previous one.
+    */
+   class monotonic_resource : public memory_resource
+   {
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+      static constexpr i64_t default_chunk_size = 1024;
+
+   public:
+      /**
+       * @brief Construct the resource using the default memory_resource as upstream.
+       */
+      monotonic_resource() noexcept;
+      /**
+       * @brief Construct the resource with a given upstream resource.
+       *
+       * @pre `initial_size > 0`, otherwise UB
+       *
+       * @param[in] p_upstream The resource to acquire the chunks from.
+       * @param[in] initial_size The size in bytes of the first chunk.
+       */
+      monotonic_resource(gsl::not_null<memory_resource*> p_upstream,
+                         count_t initial_size = count_t{default_chunk_size}) noexcept;
+      monotonic_resource(const monotonic_resource&) = delete;
+      monotonic_resource(monotonic_resource&&) = delete;
+      ~monotonic_resource() noexcept override;
+
+      auto operator=(const monotonic_resource&) -> monotonic_resource& = delete;
+      auto operator=(monotonic_resource&&) -> monotonic_resource& = delete;
+
+      /**
+       * @brief Bump allocate bytes from the current chunk, acquiring a new chunk if needed.
+       *
+       * @pre `bytes >= 0`, otherwise UB
+       * @pre `alignment > 0` and a power of two, otherwise UB
+       *
+       * @param[in] bytes The size of the allocation in bytes
+       * @param[in] alignment The alignment of the allocation in bytes
+       *
+       * @return A valid pointer to a memory chunk or nullptr if the upstream allocation failed
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override;
+      /**
+       * @brief Does nothing, memory is only reclaimed by release().
+       *
+       * @details Defined in the header along with allocate(), so that they are inlined when
+       * called on a known monotonic_resource, as by a static_allocator.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override;
+      /**
+       * @brief Check if other is this resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override;
+
+      /**
+       * @brief Return every chunk to the upstream resource. Every pointer handed out by the
+       * resource becomes dangling.
+       */
+      void release() noexcept;
+
+      /**
+       * @brief Access the upstream resource.
+       */
+      [[nodiscard]] auto upstream() const noexcept -> memory_resource*;
+
+   private:
+      struct chunk_header
+      {
+         chunk_header* p_next;
+         i64_t size;
+         i64_t alignment;
+      };
+
+      static auto align_up(std::byte* ptr, i64_t alignment) noexcept -> std::byte*
+      {
+         const auto address = reinterpret_cast<std::uintptr_t>(ptr); // NOLINT
+         const auto mask = static_cast<std::uintptr_t>(alignment - 1);
+
+         return ptr + (((address + mask) & ~mask) - address); // NOLINT
+      }
+
+      auto acquire_chunk(i64_t min_bytes, i64_t alignment) noexcept -> bool;
+
+   private:
+      memory_resource* mp_upstream;
+
+      chunk_header* mp_chunks{nullptr};
+      std::byte* mp_current{nullptr};
+      std::byte* mp_end{nullptr};
+
+      i64_t m_next_chunk_size;
+   };
+
+   inline auto monotonic_resource::allocate(count_t bytes, align_t alignment) noexcept -> pointer
+   {
+      Expects(bytes.value() >= 0);
+      Expects(alignment.value() > 0);
+
+      std::byte* p_result = mp_current ? align_up(mp_current, alignment.value()) : nullptr;
+      if (!p_result || mp_end - p_result < bytes.value())
+      {
+         if (!acquire_chunk(bytes.value(), alignment.value()))
+         {
+            return nullptr;
+         }
+
+         p_result = align_up(mp_current, alignment.value());
+      }
+
+      mp_current = p_result + bytes.value(); // NOLINT
+
+      return p_result;
+   }
+   inline void monotonic_resource::deallocate(gsl::not_null<pointer>, count_t, align_t) noexcept {}
+} // namespace caramel
@@ -0,0 +1,224 @@
+#include <libcaramel/memory/numa_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#   include <linux/mempolicy.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+
+#   define LIBCARAMEL_NUMA_POLICIES 1
+#endif
+
+namespace caramel
+{
+   namespace
+   {
+      // Nodes are passed to the kernel as a single word of bits.
+      constexpr i32_t max_node_count = sizeof(unsigned long) * CHAR_BIT; // NOLINT
+
+      /**
+       * @brief Parse the highest node of a kernel node list, such as "0-1" or "0,2-3".
+       */
+      auto parse_node_count(const std::string& nodes) noexcept -> i32_t
+      {
+         const auto last_digit = std::find_if(nodes.rbegin(), nodes.rend(), [](char c) {
+            return std::isdigit(static_cast<unsigned char>(c)) != 0;
+         });
+         if (last_digit == nodes.rend())
+         {
+            return 1;
+         }
+
+         const auto first_digit = std::find_if(last_digit, nodes.rend(), [](char c) {
+            return std::isdigit(static_cast<unsigned char>(c)) == 0;
+         });
+
+         i32_t highest = 0;
+         for (auto it = first_digit.base(); it != last_digit.base(); ++it)
+         {
+            highest = std::min(highest * 10 + (*it - '0'), max_node_count); // NOLINT
+         }
+
+         return std::clamp(highest + 1, 1, max_node_count);
+      }
+
+#if defined(LIBCARAMEL_NUMA_POLICIES)
+      auto page_size() noexcept -> i64_t
+      {
+         static const i64_t size = ::sysconf(_SC_PAGESIZE);
+
+         return size;
+      }
+
+      /**
+       * @brief Get the size of the mapping holding bytes, in whole pages.
+       */
+      auto mapping_size(i64_t bytes) noexcept -> std::size_t
+      {
+         const i64_t pages = (std::max(bytes, i64_t{1}) + page_size() - 1) / page_size();
+
+         return static_cast<std::size_t>(pages * page_size());
+      }
+
+      auto set_policy(void* p_pages, std::size_t length, int mode, unsigned long nodes) noexcept
+         -> bool
+      {
+         return ::syscall(SYS_mbind, p_pages, length, mode, &nodes, sizeof(nodes) * CHAR_BIT + 1,
+                          0) == 0;
+      }
+
+      /**
+       * @brief Apply policy to the pages, before they are first touched.
+       */
+      void apply_policy(void* p_pages, std::size_t length, numa_policy policy,
+                        i32_t node) noexcept
+      {
+         // A failure leaves the pages to the default first touch placement, which is still
+         // correct, only slower.
+         switch (policy)
+         {
+            case numa_policy::local:
+               set_policy(p_pages, length, MPOL_PREFERRED, 1UL << current_numa_node());
+               break;
+            case numa_policy::bind:
+               set_policy(p_pages, length, MPOL_BIND, 1UL << node);
+               break;
+            case numa_policy::interleave:
+            {
+               const i32_t count = numa_node_count();
+               set_policy(p_pages, length, MPOL_INTERLEAVE,
+                          count == max_node_count ? ~0UL : (1UL << count) - 1);
+               break;
+            }
+         }
+      }
+
+      auto probe_policies() noexcept -> bool
+      {
+         const std::size_t length = mapping_size(1);
+         void* p_page =
+            ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+         if (p_page == MAP_FAILED) // NOLINT
+         {
+            return false;
+         }
+
+         const bool applied =
+            set_policy(p_page, length, MPOL_PREFERRED, 1UL << current_numa_node());
+         ::munmap(p_page, length);
+
+         return applied;
+      }
+#endif
+   } // namespace
+
+   auto numa_available() noexcept -> bool
+   {
+#if defined(LIBCARAMEL_NUMA_POLICIES)
+      static const bool available = probe_policies();
+
+      return available;
+#else
+      return false;
+#endif
+   }
+
+   auto numa_node_count() noexcept -> i32_t
+   {
+      static const i32_t count = [] {
+         std::ifstream file{"/sys/devices/system/node/possible"};
+         if (!file)
+         {
+            return 1;
+         }
+
+         return parse_node_count(std::string{std::istreambuf_iterator<char>{file}, {}});
+      }();
+
+      return count;
+   }
+
+   auto current_numa_node() noexcept -> i32_t
+   {
+#if defined(LIBCARAMEL_NUMA_POLICIES)
+      unsigned cpu = 0;
+      unsigned node = 0;
+      if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+      {
+         return 0;
+      }
+
+      return std::min(static_cast<i32_t>(node), numa_node_count() - 1);
+#else
+      return 0;
+#endif
+   }
+
+   numa_resource::numa_resource() noexcept = default;
+   numa_resource::numa_resource(numa_policy policy, i32_t node) noexcept :
+      m_policy{policy}, m_node{node}
+   {
+      Expects(node >= 0 && node < numa_node_count());
+   }
+
+   auto numa_resource::allocate(count_t bytes, align_t alignment) noexcept -> pointer
+   {
+      Expects(bytes.value() >= 0);
+      Expects(alignment.value() > 0);
+
+#if defined(LIBCARAMEL_NUMA_POLICIES)
+      if (alignment.value() > page_size())
+      {
+         return nullptr;
+      }
+
+      const std::size_t length = mapping_size(bytes.value());
+      void* p_pages =
+         ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p_pages == MAP_FAILED) // NOLINT
+      {
+         return nullptr;
+      }
+
+      if (numa_available())
+      {
+         apply_policy(p_pages, length, m_policy, m_node);
+      }
+
+      return p_pages;
+#else
+      return ::operator new(static_cast<std::size_t>(bytes.value()),
+                            static_cast<std::align_val_t>(alignment.value()), std::nothrow);
+#endif
+   }
+   void numa_resource::deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                                  align_t alignment) noexcept
+   {
+      Expects(bytes.value() >= 0);
+      Expects(alignment.value() > 0);
+
+#if defined(LIBCARAMEL_NUMA_POLICIES)
+      ::munmap(ptr.get(), mapping_size(bytes.value()));
+#else
+      ::operator delete(ptr.get(), static_cast<std::size_t>(bytes.value()),
+                        static_cast<std::align_val_t>(alignment.value()));
+#endif
+   }
+   auto numa_resource::is_equal(const memory_resource& other) const noexcept -> bool
+   {
+      return dynamic_cast<const numa_resource*>(&other) != nullptr;
+   }
+
+   auto numa_resource::policy() const noexcept -> numa_policy { return m_policy; }
+   auto numa_resource::node() const noexcept -> i32_t { return m_node; }
+} // namespace caramel
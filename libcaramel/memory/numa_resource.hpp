@@ -0,0 +1,111 @@
+/**
+ * @file memory/numa_resource.hpp
+ * @brief Contains the numa_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+namespace caramel
+{
+   /**
+    * @brief Where a numa_resource places the pages of its allocations.
+    */
+   enum struct numa_policy : u32_t
+   {
+      local,     ///< On the node of the thread calling allocate(), whichever thread touches them.
+      bind,      ///< On a chosen node only.
+      interleave ///< Spread page by page over every node, for arrays shared by all threads.
+   };
+
+   /**
+    * @brief Check if the kernel applies memory policies, so that numa_resource does more than
+    * mapping pages.
+    *
+    * @details It is not the case on non Linux targets and where the syscalls are filtered out,
+    * as in some containers.
+    */
+   auto numa_available() noexcept -> bool;
+   /**
+    * @brief Get the number of NUMA nodes of the machine, 1 if it is not known.
+    */
+   auto numa_node_count() noexcept -> i32_t;
+   /**
+    * @brief Get the NUMA node of the CPU the calling thread runs on, 0 if it is not known.
+    */
+   auto current_numa_node() noexcept -> i32_t;
+
+   /**
+    * @brief Resource mapping pages directly from the OS and binding them to NUMA nodes according
+    * to a numa_policy.
+    *
+    * @details Every allocation is rounded up to whole pages and gets its own mapping, so the
+    * resource is meant for large arrays. Small allocations are better served by a
+    * monotonic_resource using it as upstream. Policies are applied with the mbind syscall,
+    * without depending on libnuma. When it is not available, allocations still succeed with the
+    * default first touch placement of the OS.
+    *
+    * Any numa_resource can deallocate the memory of another, so they all compare equal.
+    */
+   class numa_resource : public memory_resource
+   {
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+   public:
+      /**
+       * @brief Construct a resource placing allocations on the node of the allocating thread.
+       */
+      numa_resource() noexcept;
+      /**
+       * @brief Construct a resource with a given policy.
+       *
+       * @pre `node >= 0 && node < numa_node_count()`, otherwise UB
+       *
+       * @param[in] policy Where to place the pages of the allocations.
+       * @param[in] node The node to bind the allocations to, only used by numa_policy::bind.
+       */
+      numa_resource(numa_policy policy, i32_t node = 0) noexcept;
+
+      /**
+       * @brief Map whole pages and apply the policy of the resource to them.
+       *
+       * @pre `bytes >= 0`, otherwise UB
+       * @pre `alignment > 0` and a power of two, otherwise UB
+       *
+       * @param[in] bytes The size of the allocation in bytes
+       * @param[in] alignment The alignment of the allocation in bytes
+       *
+       * @return A valid pointer to a memory chunk or nullptr if the mapping failed or alignment
+       * exceeds the page size.
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override;
+      /**
+       * @brief Unmap the pages of an allocation.
+       *
+       * @pre ptr was allocated by a numa_resource with the same size.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override;
+      /**
+       * @brief Check if other is a numa_resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override;
+
+      /**
+       * @brief Get the policy of the resource.
+       */
+      [[nodiscard]] auto policy() const noexcept -> numa_policy;
+      /**
+       * @brief Get the node allocations are bound to by numa_policy::bind.
+       */
+      [[nodiscard]] auto node() const noexcept -> i32_t;
+
+   private:
+      numa_policy m_policy{numa_policy::local};
+      i32_t m_node{0};
+   };
+} // namespace caramel
@@ -0,0 +1,108 @@
+/**
+ * @file memory/object_pool.hpp
+ * @brief Contains the object_pool API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/fixed_block_resource.hpp>
+
+#include <gsl/pointers>
+
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace caramel
+{
+   /**
+    * @brief Pool of objects of one type, such as the nodes of a list, a tree or a graph.
+    *
+    * @details The objects are constructed in blocks of a fixed_block_resource, so creating and
+    * destroying one is O(1) and objects allocated together are close in memory. Containers of
+    * nodes may also draw from the pool with `memory_allocator<Any>{&pool.resource()}`. Objects
+    * still alive when the pool is destroyed are not destroyed, only their memory is reclaimed.
+    *
+    * @tparam Any The type of the objects.
+    */
+   template <typename Any>
+   class object_pool
+   {
+   public:
+      using value_type = Any;
+      using pointer = Any*;
+
+   public:
+      /**
+       * @brief Construct the pool using the default memory_resource as upstream.
+       */
+      object_pool() noexcept : m_resource{count_t{sizeof(Any)}, align_t{alignof(Any)}} {}
+      /**
+       * @brief Construct the pool with a given upstream resource.
+       *
+       * @pre `objects_per_slab > 0`, otherwise UB
+       *
+       * @param[in] p_upstream The resource to acquire the slabs from.
+       * @param[in] objects_per_slab The number of objects of the first slab.
+       */
+      object_pool(gsl::not_null<memory_resource*> p_upstream,
+                  count_t objects_per_slab =
+                     count_t{fixed_block_resource::default_blocks_per_slab}) noexcept :
+         m_resource{count_t{sizeof(Any)}, align_t{alignof(Any)}, p_upstream, objects_per_slab}
+      {}
+
+      /**
+       * @brief Construct an object in a block of the pool.
+       *
+       * @param[in] args The arguments forwarded to the constructor of the object.
+       *
+       * @return The constructed object.
+       *
+       * @throws std::bad_alloc If the upstream resource could not provide a new slab.
+       */
+      template <typename... Args>
+      auto construct(Args&&... args) -> gsl::not_null<pointer>
+      {
+         auto* p_block = m_resource.allocate(count_t{sizeof(Any)}, align_t{alignof(Any)});
+         if (!p_block)
+         {
+            throw std::bad_alloc{};
+         }
+
+         try
+         {
+            return std::construct_at(static_cast<pointer>(p_block), std::forward<Args>(args)...);
+         }
+         catch (...)
+         {
+            m_resource.deallocate(gsl::make_not_null(p_block), count_t{sizeof(Any)},
+                                  align_t{alignof(Any)});
+            throw;
+         }
+      }
+      /**
+       * @brief Destroy an object and give its block back to the pool.
+       *
+       * @pre p_object was constructed by this pool and not destroyed yet.
+       *
+       * @param[in] p_object The object to destroy.
+       */
+      void destroy(gsl::not_null<pointer> p_object) noexcept
+      {
+         memory_resource::pointer p_block = p_object.get();
+
+         std::destroy_at(p_object.get());
+         m_resource.deallocate(gsl::make_not_null(p_block), count_t{sizeof(Any)},
+                               align_t{alignof(Any)});
+      }
+
+      /**
+       * @brief Access the fixed_block_resource the objects are allocated from.
+       */
+      auto resource() noexcept -> fixed_block_resource& { return m_resource; }
+
+   private:
+      fixed_block_resource m_resource;
+   };
+} // namespace caramel
@@ -0,0 +1,291 @@
+#include <libcaramel/memory/profiling_resource.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#if __has_include(<execinfo.h>) && __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#   include <cxxabi.h>
+#   include <dlfcn.h>
+#   include <execinfo.h>
+
+#   define LIBCARAMEL_HAS_BACKTRACE 1
+#endif
+
+namespace caramel
+{
+   namespace
+   {
+      /**
+       * Frames of the profiler itself at the top of every captured stack: record_sample() and
+       * allocate().
+       */
+      constexpr int profiler_frames = 2;
+
+      auto to_hex(const void* address) -> std::string
+      {
+         const auto value = reinterpret_cast<std::uintptr_t>(address); // NOLINT
+
+         std::array<char, 2 + 2 * sizeof(void*) + 1> buffer{};
+         std::snprintf(buffer.data(), buffer.size(), "0x%llx",
+                       static_cast<unsigned long long>(value)); // NOLINT
+
+         return buffer.data();
+      }
+
+      auto symbolize(void* address) -> std::string
+      {
+#if defined(LIBCARAMEL_HAS_BACKTRACE)
+         Dl_info info{};
+         if (dladdr(address, &info) != 0 && info.dli_sname)
+         {
+            int status = 0;
+            const std::unique_ptr<char, decltype(&std::free)> p_demangled{
+               abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free};
+
+            std::string name = status == 0 ? p_demangled.get() : info.dli_sname;
+
+            // ';' separates frames in the folded format.
+            std::replace(name.begin(), name.end(), ';', ':');
+
+            return name;
+         }
+#endif
+
+         return to_hex(address);
+      }
+   } // namespace
+
+   profiling_resource::profiling_resource() :
+      profiling_resource(gsl::make_not_null(get_default_memory_resource()))
+   {}
+   profiling_resource::profiling_resource(gsl::not_null<memory_resource*> p_upstream,
+                                          count_t sampling_interval) :
+      mp_upstream{p_upstream.get()},
+      m_sampling_interval{sampling_interval.value()}, m_bytes_until_sample{0},
+      m_generator{std::random_device{}()}
+   {
+      Expects(sampling_interval.value() > 0);
+
+      m_bytes_until_sample.store(next_sample_distance());
+   }
+
+   auto profiling_resource::allocate(count_t bytes, align_t alignment) noexcept -> pointer
+   {
+      pointer ptr = mp_upstream->allocate(bytes, alignment);
+      if (!ptr)
+      {
+         return nullptr;
+      }
+
+      const bool sampled = m_sampling_interval == 1 ||
+         m_bytes_until_sample.fetch_sub(bytes.value(), std::memory_order_relaxed) <=
+            bytes.value();
+      if (sampled)
+      {
+         record_sample(ptr, bytes.value());
+      }
+
+      return ptr;
+   }
+   void profiling_resource::deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                                       align_t alignment) noexcept
+   {
+      if (m_live_sample_count.load(std::memory_order_relaxed) != 0)
+      {
+         const std::scoped_lock lock{m_mutex};
+
+         if (auto it = m_live_samples.find(ptr.get()); it != m_live_samples.end())
+         {
+            stack_stats& stats = it->second.stack->second;
+            stats.in_use_objects -= 1;
+            stats.in_use_bytes -= it->second.bytes;
+            stats.estimated_in_use_objects -= it->second.weight;
+            stats.estimated_in_use_bytes -=
+               it->second.weight * static_cast<double>(it->second.bytes);
+
+            m_live_samples.erase(it);
+            m_live_sample_count.fetch_sub(1, std::memory_order_relaxed);
+         }
+      }
+
+      mp_upstream->deallocate(ptr, bytes, alignment);
+   }
+   auto profiling_resource::is_equal(const memory_resource& other) const noexcept -> bool
+   {
+      return this == &other;
+   }
+
+   void profiling_resource::write_folded(std::ostream& os, profile_metric metric) const
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      for (const auto& [stack, stats] : m_stacks)
+      {
+         const auto rounded = std::llround(estimate(stats, metric));
+         if (rounded <= 0)
+         {
+            continue;
+         }
+
+         if (stack.empty())
+         {
+            os << "[unknown]";
+         }
+         for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+         {
+            os << (it == stack.rbegin() ? "" : ";") << symbolize(*it);
+         }
+         os << ' ' << rounded << '\n';
+      }
+   }
+   void profiling_resource::write_pprof(std::ostream& os) const
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      stack_stats totals{};
+      for (const auto& [stack, stats] : m_stacks)
+      {
+         totals.in_use_objects += stats.in_use_objects;
+         totals.in_use_bytes += stats.in_use_bytes;
+         totals.allocated_objects += stats.allocated_objects;
+         totals.allocated_bytes += stats.allocated_bytes;
+      }
+
+      const auto write_counts = [&os](const stack_stats& stats) {
+         os << stats.in_use_objects << ": " << stats.in_use_bytes << " [" << stats.allocated_objects
+            << ": " << stats.allocated_bytes << "] @";
+      };
+
+      os << "heap profile: ";
+      write_counts(totals);
+      os << " heap_v2/" << m_sampling_interval << '\n';
+
+      for (const auto& [stack, stats] : m_stacks)
+      {
+         write_counts(stats);
+         for (void* address : stack)
+         {
+            os << ' ' << to_hex(address);
+         }
+         os << '\n';
+      }
+
+      if (std::ifstream maps{"/proc/self/maps"})
+      {
+         os << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+      }
+   }
+
+   auto profiling_resource::sample_count() const -> i64_t
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      return m_sample_count;
+   }
+   auto profiling_resource::estimated_total(profile_metric metric) const -> double
+   {
+      const std::scoped_lock lock{m_mutex};
+
+      double total = 0.0;
+      for (const auto& [stack, stats] : m_stacks)
+      {
+         total += estimate(stats, metric);
+      }
+
+      return total;
+   }
+
+   auto profiling_resource::upstream() const noexcept -> memory_resource* { return mp_upstream; }
+
+   [[gnu::noinline]] void profiling_resource::record_sample(pointer ptr, i64_t bytes) noexcept
+   {
+      call_stack stack;
+
+      try
+      {
+#if defined(LIBCARAMEL_HAS_BACKTRACE)
+         std::array<void*, max_stack_depth + profiler_frames> frames{};
+         const int depth = ::backtrace(frames.data(), static_cast<int>(frames.size()));
+         if (depth > profiler_frames)
+         {
+            stack.assign(frames.begin() + profiler_frames, frames.begin() + depth);
+         }
+#endif
+
+         const double weight = sample_weight(bytes);
+
+         const std::scoped_lock lock{m_mutex};
+
+         auto [it, inserted] = m_stacks.try_emplace(std::move(stack));
+         stack_stats& stats = it->second;
+         stats.allocated_objects += 1;
+         stats.allocated_bytes += bytes;
+         stats.estimated_allocated_objects += weight;
+         stats.estimated_allocated_bytes += weight * static_cast<double>(bytes);
+
+         if (m_live_samples.try_emplace(ptr, live_sample{it, bytes, weight}).second)
+         {
+            stats.in_use_objects += 1;
+            stats.in_use_bytes += bytes;
+            stats.estimated_in_use_objects += weight;
+            stats.estimated_in_use_bytes += weight * static_cast<double>(bytes);
+
+            m_live_sample_count.fetch_add(1, std::memory_order_relaxed);
+         }
+
+         ++m_sample_count;
+         m_bytes_until_sample.store(next_sample_distance(), std::memory_order_relaxed);
+      }
+      catch (...)
+      {
+         // Running out of memory for the bookkeeping only loses the sample.
+      }
+   }
+   auto profiling_resource::next_sample_distance() -> i64_t
+   {
+      std::exponential_distribution<double> distribution{
+         1.0 / static_cast<double>(m_sampling_interval)};
+
+      return std::max<i64_t>(1, std::llround(distribution(m_generator)));
+   }
+   auto profiling_resource::estimate(const stack_stats& stats, profile_metric metric) noexcept
+      -> double
+   {
+      switch (metric)
+      {
+         case profile_metric::allocated_bytes:
+            return stats.estimated_allocated_bytes;
+         case profile_metric::allocated_objects:
+            return stats.estimated_allocated_objects;
+         case profile_metric::in_use_bytes:
+            return stats.estimated_in_use_bytes;
+         case profile_metric::in_use_objects:
+            return stats.estimated_in_use_objects;
+      }
+
+      return 0.0;
+   }
+   auto profiling_resource::sample_weight(i64_t bytes) const -> double
+   {
+      if (m_sampling_interval == 1 || bytes <= 0)
+      {
+         return 1.0;
+      }
+
+      // Probability that a sample point falls within an allocation of that size.
+      const double probability =
+         1.0 - std::exp(-static_cast<double>(bytes) / static_cast<double>(m_sampling_interval));
+
+      return 1.0 / probability;
+   }
+} // namespace caramel
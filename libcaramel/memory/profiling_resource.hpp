@@ -0,0 +1,169 @@
+/**
+ * @file memory/profiling_resource.hpp
+ * @brief Contains the profiling_resource API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace caramel
+{
+   /**
+    * @brief The quantity a profile written by a profiling_resource reports for each call stack.
+    */
+   enum struct profile_metric
+   {
+      allocated_bytes,   ///< Bytes allocated since the creation of the resource.
+      allocated_objects, ///< Allocations made since the creation of the resource.
+      in_use_bytes,      ///< Bytes allocated and not yet deallocated.
+      in_use_objects     ///< Allocations not yet deallocated.
+   };
+
+   /**
+    * @brief Sampling heap profiler forwarding every call to an upstream resource.
+    *
+    * @details Allocations are sampled on average once every `sampling_interval` bytes, the
+    * distance between two samples following an exponential distribution so that every byte has
+    * the same chance of being sampled whatever the allocation pattern. Only sampled allocations
+    * capture a backtrace and are recorded, the cost of the others is an atomic decrement, and a
+    * deallocation only looks up the sampled allocations while some are alive.
+    *
+    * Samples are aggregated by call stack and reported either as folded stacks, ready for
+    * flamegraph.pl or speedscope, or in the legacy text heap profile format understood by pprof.
+    * Folded stacks report estimates of the real totals; the pprof output reports the raw samples
+    * along with the sampling interval and lets pprof do the scaling.
+    *
+    * The bookkeeping uses the global operator new, never a memory_resource, so the resource can
+    * wrap the default memory_resource to profile every libcaramel container:
+    *
+    * @code{.cpp}
+    * profiling_resource profiler{gsl::make_not_null(get_default_memory_resource())};
+    * set_default_memory_resource(gsl::make_not_null(&profiler));
+    * @endcode
+    */
+   class profiling_resource : public memory_resource
+   {
+   public:
+      using pointer = typename memory_resource::pointer;
+      using const_pointer = typename memory_resource::const_pointer;
+
+      static constexpr i64_t default_sampling_interval = 512 * 1024;
+      static constexpr i64_t max_stack_depth = 64;
+
+   public:
+      /**
+       * @brief Construct the resource using the default memory_resource as upstream.
+       */
+      profiling_resource();
+      /**
+       * @brief Construct the resource with a given upstream resource.
+       *
+       * @pre `sampling_interval > 0`, otherwise UB
+       *
+       * @param[in] p_upstream The resource to forward every call to.
+       * @param[in] sampling_interval The mean number of bytes between two samples, 1 samples
+       * every allocation.
+       */
+      profiling_resource(gsl::not_null<memory_resource*> p_upstream,
+                         count_t sampling_interval = count_t{default_sampling_interval});
+      profiling_resource(const profiling_resource&) = delete;
+      profiling_resource(profiling_resource&&) = delete;
+      ~profiling_resource() noexcept override = default;
+
+      auto operator=(const profiling_resource&) -> profiling_resource& = delete;
+      auto operator=(profiling_resource&&) -> profiling_resource& = delete;
+
+      /**
+       * @brief Allocate from the upstream resource, recording the call stack if the allocation
+       * is sampled.
+       */
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override;
+      /**
+       * @brief Deallocate to the upstream resource, removing the allocation from the in use
+       * totals if it was sampled.
+       */
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override;
+      /**
+       * @brief Check if other is this resource.
+       */
+      auto is_equal(const memory_resource& other) const noexcept -> bool override;
+
+      /**
+       * @brief Write the profile as folded stacks, one `root;...;leaf value` line per call stack.
+       */
+      void write_folded(std::ostream& os,
+                        profile_metric metric = profile_metric::in_use_bytes) const;
+      /**
+       * @brief Write the profile in the legacy pprof heap profile format, followed by the
+       * mapped libraries so pprof can symbolize the addresses.
+       */
+      void write_pprof(std::ostream& os) const;
+
+      /**
+       * @brief Get the number of allocations sampled so far.
+       */
+      [[nodiscard]] auto sample_count() const -> i64_t;
+      /**
+       * @brief Get the estimated total of a metric over every call stack.
+       */
+      [[nodiscard]] auto estimated_total(profile_metric metric) const -> double;
+
+      /**
+       * @brief Access the upstream resource.
+       */
+      [[nodiscard]] auto upstream() const noexcept -> memory_resource*;
+
+   private:
+      using call_stack = std::vector<void*>;
+
+      struct stack_stats
+      {
+         i64_t allocated_objects{0};
+         i64_t allocated_bytes{0};
+         i64_t in_use_objects{0};
+         i64_t in_use_bytes{0};
+
+         double estimated_allocated_objects{0.0};
+         double estimated_allocated_bytes{0.0};
+         double estimated_in_use_objects{0.0};
+         double estimated_in_use_bytes{0.0};
+      };
+
+      struct live_sample
+      {
+         std::map<call_stack, stack_stats>::iterator stack;
+         i64_t bytes;
+         double weight;
+      };
+
+      void record_sample(pointer ptr, i64_t bytes) noexcept;
+      auto next_sample_distance() -> i64_t;
+      [[nodiscard]] auto sample_weight(i64_t bytes) const -> double;
+
+      static auto estimate(const stack_stats& stats, profile_metric metric) noexcept -> double;
+
+   private:
+      memory_resource* mp_upstream;
+      i64_t m_sampling_interval;
+
+      std::atomic<i64_t> m_bytes_until_sample;
+      std::atomic<i64_t> m_live_sample_count{0};
+
+      mutable std::mutex m_mutex;
+      std::mt19937_64 m_generator;
+      std::map<call_stack, stack_stats> m_stacks;
+      std::unordered_map<pointer, live_sample> m_live_samples;
+      i64_t m_sample_count{0};
+   };
+} // namespace caramel
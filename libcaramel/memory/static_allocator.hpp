@@ -0,0 +1,143 @@
+/**
+ * @file memory/static_allocator.hpp
+ * @brief Contains the static_allocator API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/memory_resource.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+#include <gsl/pointers>
+
+#include <concepts>
+#include <type_traits>
+
+namespace caramel
+{
+   /**
+    * @brief Binding giving access to one instance of Resource, shared by the whole program.
+    *
+    * @details The instance is default constructed on first use and is not synchronized, so a
+    * resource that is not thread safe, such as a monotonic_resource, must only be used from one
+    * thread. Distinct Tag types give distinct instances of the same Resource.
+    *
+    * @tparam Resource The concrete type of the resource.
+    * @tparam Tag Any type, to tell instances of the same Resource apart.
+    */
+   template <typename Resource, typename Tag = void>
+   struct static_resource
+   {
+      static auto resource() noexcept -> Resource&
+      {
+         static Resource instance;
+
+         return instance;
+      }
+   };
+
+   /**
+    * @brief A type with a static resource() function returning a reference to a concrete
+    * memory_resource, such as static_resource.
+    */
+   // clang-format off
+   template <typename Binding>
+   concept resource_binding = requires
+   {
+      { Binding::resource() } noexcept;
+
+      requires std::is_lvalue_reference_v<decltype(Binding::resource())>;
+      requires std::derived_from<std::remove_cvref_t<decltype(Binding::resource())>,
+                                 memory_resource>;
+      requires !std::is_abstract_v<std::remove_cvref_t<decltype(Binding::resource())>>;
+   };
+   // clang-format on
+
+   namespace detail
+   {
+      template <typename Resource>
+      struct resource_binding_of
+      {
+         using type = Resource;
+      };
+
+      template <typename Resource>
+         requires std::derived_from<Resource, memory_resource>
+      struct resource_binding_of<Resource>
+      {
+         using type = static_resource<Resource>;
+      };
+   } // namespace detail
+
+   /**
+    * @brief Stateless allocator drawing from a resource known at compile time.
+    *
+    * @details Unlike memory_allocator, which calls the virtual functions of the resource through
+    * a pointer, the resource is called directly by its concrete type, so allocation functions
+    * defined in headers, such as the bump allocation of a monotonic_resource, are inlined into
+    * the container. The allocator holds nothing, making it take no space in a container, and
+    * all static_allocators of a given Resource compare equal.
+    *
+    * @tparam Any The type of the allocated objects.
+    * @tparam Resource Either a default constructible memory_resource type, used through
+    * static_resource<Resource>, or a resource_binding.
+    */
+   template <typename Any, typename Resource>
+   class static_allocator
+   {
+      using binding = typename detail::resource_binding_of<Resource>::type;
+
+      static_assert(resource_binding<binding>,
+                    "Resource must be a memory_resource type or a resource_binding");
+
+   public:
+      using pointer = Any*;
+      using const_pointer = const Any*;
+
+      using resource_type = std::remove_cvref_t<decltype(binding::resource())>;
+
+   public:
+      constexpr static_allocator() noexcept = default;
+      template <typename U>
+      constexpr static_allocator(const static_allocator<U, Resource>& /* other */) noexcept
+      {}
+
+      constexpr auto operator==(const static_allocator& /* alloc */) const noexcept -> bool
+      {
+         return true;
+      }
+
+      auto allocate(count_t count) -> pointer
+      {
+         return static_cast<pointer>(
+            binding::resource().resource_type::allocate(count_t{sizeof(Any)} * count,
+                                                        align_t{alignof(Any)}));
+      }
+      auto allocate(count_t count, align_t alignment) -> pointer
+      {
+         Expects(alignment.value() >= static_cast<i64_t>(alignof(Any)));
+
+         return static_cast<pointer>(
+            binding::resource().resource_type::allocate(count_t{sizeof(Any)} * count, alignment));
+      }
+      void deallocate(gsl::not_null<pointer> ptr, count_t count)
+      {
+         binding::resource().resource_type::deallocate(
+            gsl::make_not_null(static_cast<memory_resource::pointer>(ptr)),
+            count_t{sizeof(Any)} * count, align_t{alignof(Any)});
+      }
+      void deallocate(gsl::not_null<pointer> ptr, count_t count, align_t alignment)
+      {
+         binding::resource().resource_type::deallocate(
+            gsl::make_not_null(static_cast<memory_resource::pointer>(ptr)),
+            count_t{sizeof(Any)} * count, alignment);
+      }
+
+      /**
+       * @brief Access the resource the allocator draws from.
+       */
+      static auto resource() noexcept -> resource_type* { return &binding::resource(); }
+   };
+} // namespace caramel
@@ -0,0 +1,76 @@
+#include <libcaramel/serialization/binary.hpp>
+
+#include <system_error>
+
+namespace caramel::detail
+{
+   namespace
+   {
+      [[noreturn]] void throw_invalid(const char* what)
+      {
+         throw std::system_error(std::make_error_code(std::errc::invalid_argument), what);
+      }
+   } // namespace
+
+   auto read_header(std::span<const std::byte> block, u64_t type_hash, i64_t element_size)
+      -> binary_header
+   {
+      const auto available = static_cast<i64_t>(block.size()) - i64_t{sizeof(binary_header)};
+      if (available < 0)
+      {
+         throw_invalid("binary: buffer is too small to hold a header");
+      }
+
+      binary_header header{};
+      std::memcpy(&header, block.data(), sizeof(header));
+
+      if (header.magic != binary_magic)
+      {
+         throw_invalid("binary: buffer does not start with a header");
+      }
+      if (header.version != binary_format_version)
+      {
+         throw_invalid("binary: unsupported format version");
+      }
+      if (header.type_hash != type_hash || header.element_size != element_size)
+      {
+         throw_invalid("binary: buffer holds elements of a different type");
+      }
+
+      // Arrays of arrays need at least their offset table.
+      const i64_t min_element_size = element_size > 0 ? element_size : i64_t{sizeof(i64_t)};
+      const i64_t max_count = available / min_element_size - (element_size > 0 ? 0 : 1);
+      if (header.count < 0 || header.count > max_count)
+      {
+         throw_invalid("binary: buffer is truncated");
+      }
+
+      return header;
+   }
+   void check_offsets(std::span<const std::byte> block, i64_t count)
+   {
+      const i64_t table_end = sizeof(binary_header) + pad((count + 1) * i64_t{sizeof(i64_t)});
+
+      i64_t previous = table_end;
+      for (i64_t i = 0; i <= count; ++i)
+      {
+         const i64_t offset = read_offset(block, i);
+         if (offset < previous || offset > static_cast<i64_t>(block.size()) ||
+             offset % binary_alignment != 0)
+         {
+            throw_invalid("binary: corrupted offset table");
+         }
+
+         previous = offset;
+      }
+   }
+   auto read_offset(std::span<const std::byte> block, i64_t index) noexcept -> i64_t
+   {
+      i64_t offset{};
+      std::memcpy(&offset, block.data() + sizeof(binary_header) + index * sizeof(i64_t), // NOLINT
+                  sizeof(offset));
+
+      return offset;
+   }
+   void throw_misaligned() { throw_invalid("binary: elements are not aligned for their type"); }
+} // namespace caramel::detail
@@ -0,0 +1,459 @@
+/**
+ * @file serialization/binary.hpp
+ * @brief Contains the binary serialization API for arrays of trivially copyable types.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace caramel
+{
+   /**
+    * @brief Magic number starting every binary header, "CRMB" in little endian.
+    */
+   inline constexpr u32_t binary_magic = 0x424d5243;
+   /**
+    * @brief Version written in, and required from, every binary header.
+    */
+   inline constexpr u32_t binary_format_version = 1;
+   /**
+    * @brief Alignment of every block of the binary format. Element types may not require more.
+    */
+   inline constexpr i64_t binary_alignment = 16;
+
+   /**
+    * @brief Header preceding every serialized array.
+    *
+    * @details A block is a header, followed by the payload, padded with zeros to a multiple of
+    * binary_alignment. The payload of an array of trivially copyable elements is the raw bytes of
+    * its elements. The payload of an array of arrays is a table of `count + 1` byte offsets,
+    * relative to the start of the block, of each nested block and of the end of the block,
+    * followed by the nested blocks. Only the element types are recorded, so an array written from
+    * a small_dynamic_array can be read back as a dynamic_array.
+    */
+   struct binary_header
+   {
+      u32_t magic;
+      u32_t version;
+      u64_t type_hash;    ///< binary_type_hash of the element type.
+      i64_t element_size; ///< sizeof the element type, 0 for arrays of arrays.
+      i64_t count;        ///< Number of elements, or of nested arrays.
+   };
+
+   static_assert(sizeof(binary_header) % binary_alignment == 0);
+
+   namespace detail
+   {
+      constexpr auto fnv1a(std::string_view str, u64_t hash = 0xcbf29ce484222325ULL) noexcept
+         -> u64_t
+      {
+         for (const char c : str)
+         {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ULL; // NOLINT
+         }
+
+         return hash;
+      }
+
+      template <typename Any>
+      constexpr auto type_signature() noexcept -> std::string_view
+      {
+#if defined(_MSC_VER) && !defined(__clang__)
+         return __FUNCSIG__;
+#else
+         return __PRETTY_FUNCTION__;
+#endif
+      }
+   } // namespace detail
+
+   /**
+    * @brief Identify a type in the binary format.
+    *
+    * @details The default hashes the name of the type as spelled by the compiler, together with
+    * its size and alignment. Specialize it to keep files readable across compilers or after a
+    * type is renamed.
+    */
+   template <typename Any>
+   struct binary_type_hash
+   {
+      static constexpr u64_t value =
+         detail::fnv1a(detail::type_signature<Any>(), (sizeof(Any) << 8U) ^ alignof(Any));
+   };
+
+   namespace detail
+   {
+      template <typename Any>
+      concept binary_element =
+         std::is_trivially_copyable_v<Any> && alignof(Any) <= binary_alignment;
+
+      template <typename Container>
+      concept resizable_array = requires(Container& container, const Container& const_container,
+                                         typename Container::size_type count)
+      {
+         typename Container::value_type;
+         container.resize(count);
+         { container.data() } -> std::convertible_to<typename Container::value_type*>;
+         { const_container.size() } -> std::convertible_to<i64_t>;
+      };
+
+      template <typename Container>
+      constexpr auto is_binary_array() noexcept -> bool
+      {
+         if constexpr (resizable_array<Container>)
+         {
+            using value_type = typename Container::value_type;
+
+            if constexpr (binary_element<value_type>)
+            {
+               return true;
+            }
+            else
+            {
+               return is_binary_array<value_type>();
+            }
+         }
+         else
+         {
+            return false;
+         }
+      }
+   } // namespace detail
+
+   /**
+    * @brief Arrays the binary format can store: contiguous, resizable, and holding either
+    * trivially copyable elements or other such arrays.
+    */
+   template <typename Container>
+   concept binary_array = detail::is_binary_array<Container>();
+
+   namespace detail
+   {
+      constexpr auto pad(i64_t bytes) noexcept -> i64_t
+      {
+         return (bytes + binary_alignment - 1) & ~(binary_alignment - 1);
+      }
+
+      /**
+       * @brief Check the header at the start of block and return it.
+       *
+       * @throws std::system_error With std::errc::invalid_argument if the block is too small to
+       * hold its header and payload, or was written for a different type or version.
+       */
+      auto read_header(std::span<const std::byte> block, u64_t type_hash, i64_t element_size)
+         -> binary_header;
+      /**
+       * @brief Check that the offsets of an array of arrays are ordered, aligned and inside
+       * block.
+       *
+       * @throws std::system_error With std::errc::invalid_argument if they are not.
+       */
+      void check_offsets(std::span<const std::byte> block, i64_t count);
+      /**
+       * @brief Read an entry of the offset table of an array of arrays.
+       */
+      auto read_offset(std::span<const std::byte> block, i64_t index) noexcept -> i64_t;
+      /**
+       * @brief Throw the error reported for a payload not aligned for its elements.
+       */
+      [[noreturn]] void throw_misaligned();
+
+      template <typename Container>
+      struct binary_traits;
+
+      template <binary_array Container>
+         requires binary_element<typename Container::value_type>
+      struct binary_traits<Container>
+      {
+         using value_type = typename Container::value_type;
+
+         static constexpr u64_t type_hash = binary_type_hash<value_type>::value;
+         static constexpr i64_t element_size = sizeof(value_type);
+
+         static auto size(const Container& container) -> i64_t
+         {
+            return sizeof(binary_header) + pad(element_size * container.size());
+         }
+
+         static auto write(const Container& container, std::byte* p_block) -> std::byte*
+         {
+            const auto count = static_cast<i64_t>(container.size());
+            const binary_header header{
+               binary_magic, binary_format_version, type_hash, element_size, count};
+
+            std::memcpy(p_block, &header, sizeof(header));
+            if (count > 0)
+            {
+               std::memcpy(p_block + sizeof(header), container.data(), // NOLINT
+                           static_cast<std::size_t>(element_size * count));
+            }
+
+            return p_block + size(container); // NOLINT
+         }
+
+         static void read(std::span<const std::byte> block, Container& container)
+         {
+            const binary_header header = read_header(block, type_hash, element_size);
+
+            container.resize(static_cast<typename Container::size_type>(header.count));
+            if (header.count > 0)
+            {
+               std::memcpy(container.data(), block.data() + sizeof(header), // NOLINT
+                           static_cast<std::size_t>(element_size * header.count));
+            }
+         }
+      };
+
+      template <binary_array Container>
+         requires(!binary_element<typename Container::value_type>)
+      struct binary_traits<Container>
+      {
+         using value_type = typename Container::value_type;
+         using nested_traits = binary_traits<value_type>;
+
+         static constexpr u64_t type_hash = fnv1a("array", nested_traits::type_hash);
+         static constexpr i64_t element_size = 0;
+
+         static auto size(const Container& container) -> i64_t
+         {
+            const auto count = static_cast<i64_t>(container.size());
+
+            i64_t total = sizeof(binary_header) + table_size(count);
+            for (i64_t i = 0; i < count; ++i)
+            {
+               total += nested_traits::size(container.data()[i]); // NOLINT
+            }
+
+            return total;
+         }
+
+         static auto write(const Container& container, std::byte* p_block) -> std::byte*
+         {
+            const auto count = static_cast<i64_t>(container.size());
+            const binary_header header{
+               binary_magic, binary_format_version, type_hash, element_size, count};
+
+            std::memcpy(p_block, &header, sizeof(header));
+
+            std::byte* p_table = p_block + sizeof(header);     // NOLINT
+            std::byte* p_nested = p_table + table_size(count); // NOLINT
+            for (i64_t i = 0; i < count; ++i)
+            {
+               const i64_t offset = p_nested - p_block;
+               std::memcpy(p_table + i * sizeof(i64_t), &offset, sizeof(offset)); // NOLINT
+
+               p_nested = nested_traits::write(container.data()[i], p_nested); // NOLINT
+            }
+
+            const i64_t end = p_nested - p_block;
+            std::memcpy(p_table + count * sizeof(i64_t), &end, sizeof(end)); // NOLINT
+
+            return p_nested;
+         }
+
+         static void read(std::span<const std::byte> block, Container& container)
+         {
+            const binary_header header = read_header(block, type_hash, element_size);
+            check_offsets(block, header.count);
+
+            container.resize(static_cast<typename Container::size_type>(header.count));
+            for (i64_t i = 0; i < header.count; ++i)
+            {
+               nested_traits::read(nested_block(block, i), container.data()[i]); // NOLINT
+            }
+         }
+
+         static auto table_size(i64_t count) noexcept -> i64_t
+         {
+            return pad((count + 1) * static_cast<i64_t>(sizeof(i64_t)));
+         }
+
+         static auto nested_block(std::span<const std::byte> block, i64_t index) noexcept
+            -> std::span<const std::byte>
+         {
+            const i64_t first = read_offset(block, index);
+            const i64_t last = read_offset(block, index + 1);
+
+            return block.subspan(static_cast<std::size_t>(first),
+                                 static_cast<std::size_t>(last - first));
+         }
+      };
+   } // namespace detail
+
+   /**
+    * @brief Compute the number of bytes serialize() appends for a container.
+    */
+   template <binary_array Container>
+   auto serialized_size(const Container& container) -> i64_t
+   {
+      return detail::binary_traits<Container>::size(container);
+   }
+
+   /**
+    * @brief Append the binary representation of a container to a byte array.
+    *
+    * @details The output grows once, by serialized_size(container) bytes. Arrays of trivially
+    * copyable elements are written with a single memcpy. Blocks are padded to binary_alignment
+    * relative to the start of the output: an output allocated with at least that alignment can be
+    * read back in place with binary_view().
+    *
+    * @param[in] container The array to write.
+    * @param[in,out] output The byte array to append to.
+    */
+   template <binary_array Container, binary_array Output>
+      requires std::same_as<typename Output::value_type, std::byte>
+   void serialize(const Container& container, Output& output)
+   {
+      const auto previous_size = static_cast<i64_t>(output.size());
+      const i64_t size = serialized_size(container);
+
+      output.resize(static_cast<typename Output::size_type>(previous_size + size));
+      detail::binary_traits<Container>::write(container, output.data() + previous_size);
+   }
+   /**
+    * @brief Serialize a container into a new byte array.
+    */
+   template <binary_array Container>
+   auto serialize(const Container& container) -> dynamic_array<std::byte>
+   {
+      dynamic_array<std::byte> output;
+      serialize(container, output);
+
+      return output;
+   }
+
+   /**
+    * @brief Rebuild a container from its binary representation, copying the elements in bulk.
+    *
+    * @param[in] buffer Bytes starting with a block written by serialize(). No alignment is
+    * required.
+    *
+    * @throws std::system_error With std::errc::invalid_argument if the buffer does not hold an
+    * array of this type.
+    */
+   template <binary_array Container>
+   auto deserialize(std::span<const std::byte> buffer) -> Container
+   {
+      Container container;
+      detail::binary_traits<Container>::read(buffer, container);
+
+      return container;
+   }
+
+   /**
+    * @brief Read only view over an array of trivially copyable elements, without copying them.
+    *
+    * @param[in] buffer Bytes starting with a block written by serialize() for an array of Any,
+    * for instance a mapped file. The buffer must outlive the view.
+    *
+    * @throws std::system_error With std::errc::invalid_argument if the buffer does not hold an
+    * array of Any, or its elements are not aligned for Any.
+    */
+   template <detail::binary_element Any>
+   auto binary_view(std::span<const std::byte> buffer) -> std::span<const Any>
+   {
+      const binary_header header =
+         detail::read_header(buffer, binary_type_hash<Any>::value, sizeof(Any));
+      if (header.count == 0)
+      {
+         return {};
+      }
+
+      const std::byte* p_first = buffer.data() + sizeof(header); // NOLINT
+      if (reinterpret_cast<std::uintptr_t>(p_first) % alignof(Any) != 0) // NOLINT
+      {
+         detail::throw_misaligned();
+      }
+
+      return {reinterpret_cast<const Any*>(p_first), // NOLINT
+              static_cast<std::size_t>(header.count)};
+   }
+
+   /**
+    * @brief Read only view over an array of arrays of trivially copyable elements, without
+    * copying them.
+    *
+    * @details Every nested block is validated when the view is made, so lookups only read the
+    * offset table.
+    */
+   template <detail::binary_element Any>
+   class binary_nested_view
+   {
+      using traits = detail::binary_traits<dynamic_array<dynamic_array<Any>>>;
+
+   public:
+      using size_type = i64_t;
+
+   public:
+      /**
+       * @param[in] buffer Bytes starting with a block written by serialize() for an array of
+       * arrays of Any. The buffer must outlive the view.
+       *
+       * @throws std::system_error With std::errc::invalid_argument if the buffer does not hold an
+       * array of arrays of Any, or its elements are not aligned for Any.
+       */
+      explicit binary_nested_view(std::span<const std::byte> buffer) :
+         m_count{detail::read_header(buffer, traits::type_hash, traits::element_size).count}
+      {
+         detail::check_offsets(buffer, m_count);
+
+         const i64_t end = detail::read_offset(buffer, m_count);
+         m_block = buffer.first(static_cast<std::size_t>(end));
+
+         for (size_type i = 0; i < m_count; ++i)
+         {
+            binary_view<Any>(traits::nested_block(m_block, i));
+         }
+      }
+
+      /**
+       * @brief Access the nested array stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      [[nodiscard]] auto lookup(size_type index) const -> std::span<const Any>
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         const auto nested = traits::nested_block(m_block, index);
+
+         binary_header header{};
+         std::memcpy(&header, nested.data(), sizeof(header));
+         if (header.count == 0)
+         {
+            return {};
+         }
+
+         return {reinterpret_cast<const Any*>(nested.data() + sizeof(header)), // NOLINT
+                 static_cast<std::size_t>(header.count)};
+      }
+
+      /**
+       * @brief Check the number of nested arrays.
+       */
+      [[nodiscard]] auto size() const noexcept -> size_type { return m_count; }
+      /**
+       * @brief Check if there are no nested arrays.
+       */
+      [[nodiscard]] auto empty() const noexcept -> bool { return m_count == 0; }
+
+   private:
+      i64_t m_count;
+      std::span<const std::byte> m_block;
+   };
+} // namespace caramel
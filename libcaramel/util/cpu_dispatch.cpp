@@ -0,0 +1,173 @@
+#include <libcaramel/util/cpu_dispatch.hpp>
+
+#include <cstdlib>
+#include <mutex>
+
+namespace caramel
+{
+   namespace
+   {
+      auto detect_isa_level() noexcept -> isa_level
+      {
+#if defined(LIBCARAMEL_X86_KERNELS)
+         __builtin_cpu_init();
+
+         if (!__builtin_cpu_supports("sse2"))
+         {
+            return isa_level::scalar;
+         }
+
+         if (!__builtin_cpu_supports("sse4.2") || !__builtin_cpu_supports("popcnt"))
+         {
+            return isa_level::sse2;
+         }
+
+         if (!__builtin_cpu_supports("avx2"))
+         {
+            return isa_level::sse4_2;
+         }
+
+         return isa_level::avx2;
+#else
+         return isa_level::scalar;
+#endif
+      }
+
+      /**
+       * @brief The detected level, lowered to the one named by `CARAMEL_ISA` if any.
+       */
+      auto default_isa_level() noexcept -> isa_level
+      {
+         const isa_level detected = detected_isa_level();
+
+         const char* p_name = std::getenv("CARAMEL_ISA"); // NOLINT
+         if (p_name == nullptr)
+         {
+            return detected;
+         }
+
+         return std::min(parse_isa_level(p_name).value_or(detected), detected);
+      }
+   } // namespace
+
+   namespace detail
+   {
+      /**
+       * @brief Every live dispatched object, so that they can all be reselected at once.
+       */
+      struct dispatch_table
+      {
+         std::mutex mutex;
+         dispatch_entry* p_head{nullptr};
+         isa_level default_level{default_isa_level()};
+         std::atomic<isa_level> active_level{default_level};
+
+         static auto instance() noexcept -> dispatch_table&
+         {
+            static dispatch_table table;
+
+            return table;
+         }
+
+         void select_all(isa_level level) noexcept
+         {
+            const std::scoped_lock lock{mutex};
+
+            active_level.store(level, std::memory_order_relaxed);
+            for (dispatch_entry* p_entry = p_head; p_entry != nullptr; p_entry = p_entry->mp_next)
+            {
+               p_entry->select(level);
+            }
+         }
+      };
+
+      void dispatch_entry::enroll() noexcept
+      {
+         dispatch_table& table = dispatch_table::instance();
+
+         const std::scoped_lock lock{table.mutex};
+
+         mp_next = table.p_head;
+         table.p_head = this;
+
+         select(table.active_level.load(std::memory_order_relaxed));
+      }
+
+      void dispatch_entry::withdraw() noexcept
+      {
+         dispatch_table& table = dispatch_table::instance();
+
+         const std::scoped_lock lock{table.mutex};
+
+         dispatch_entry** pp_link = &table.p_head;
+         while (*pp_link != nullptr && *pp_link != this)
+         {
+            pp_link = &(*pp_link)->mp_next;
+         }
+
+         if (*pp_link == this)
+         {
+            *pp_link = mp_next;
+         }
+      }
+   } // namespace detail
+
+   auto to_string(isa_level level) noexcept -> std::string_view
+   {
+      switch (level)
+      {
+         case isa_level::scalar:
+            return "scalar";
+         case isa_level::sse2:
+            return "sse2";
+         case isa_level::sse4_2:
+            return "sse4.2";
+         case isa_level::avx2:
+            return "avx2";
+      }
+
+      return "unknown";
+   }
+
+   auto parse_isa_level(std::string_view str) noexcept -> std::optional<isa_level>
+   {
+      for (std::size_t i = 0; i < isa_level_count; ++i)
+      {
+         const auto level = static_cast<isa_level>(i);
+         if (to_string(level) == str)
+         {
+            return level;
+         }
+      }
+
+      return std::nullopt;
+   }
+
+   auto detected_isa_level() noexcept -> isa_level
+   {
+      static const isa_level level = detect_isa_level();
+
+      return level;
+   }
+
+   auto active_isa_level() noexcept -> isa_level
+   {
+      return detail::dispatch_table::instance().active_level.load(std::memory_order_relaxed);
+   }
+
+   auto force_isa_level(isa_level level) noexcept -> isa_level
+   {
+      const isa_level active = std::min(level, detected_isa_level());
+
+      detail::dispatch_table::instance().select_all(active);
+
+      return active;
+   }
+
+   void reset_isa_level() noexcept
+   {
+      detail::dispatch_table& table = detail::dispatch_table::instance();
+
+      table.select_all(table.default_level);
+   }
+} // namespace caramel
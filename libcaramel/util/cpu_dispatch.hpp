@@ -0,0 +1,229 @@
+/**
+ * @file util/cpu_dispatch.hpp
+ * @brief Contains the runtime CPU feature detection and kernel dispatch API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+/**
+ * @brief Defined when x86 kernels, built with `__attribute__((target(...)))`, can be compiled.
+ */
+#   define LIBCARAMEL_X86_KERNELS
+#endif
+
+namespace caramel
+{
+   /**
+    * @brief Instruction set levels a kernel can be written for. Every level implies the ones
+    * before it.
+    */
+   enum struct isa_level : u32_t
+   {
+      scalar, ///< Portable C++ only.
+      sse2,   ///< The x86-64 baseline.
+      sse4_2, ///< SSE4.2 and popcnt.
+      avx2    ///< AVX2, along with everything above.
+   };
+
+   inline constexpr std::size_t isa_level_count = 4;
+
+   /**
+    * @brief Get a short, stable, name for a level: "scalar", "sse2", "sse4.2" or "avx2".
+    */
+   auto to_string(isa_level level) noexcept -> std::string_view;
+   /**
+    * @brief Get the level named by str, as written by to_string().
+    */
+   auto parse_isa_level(std::string_view str) noexcept -> std::optional<isa_level>;
+
+   /**
+    * @brief Get the highest level supported by the CPU, queried once through cpuid.
+    */
+   auto detected_isa_level() noexcept -> isa_level;
+   /**
+    * @brief Get the level the dispatched kernels are currently selected for.
+    *
+    * @details It is the detected level, lowered by the `CARAMEL_ISA` environment variable when
+    * it names a lower level, or by force_isa_level().
+    */
+   auto active_isa_level() noexcept -> isa_level;
+   /**
+    * @brief Select every dispatched kernel for at most level, for testing and benchmarking.
+    *
+    * @details Levels above the detected one are clamped, as their kernels would not run.
+    *
+    * @param[in] level The highest level kernels may be selected for.
+    *
+    * @return The level now active.
+    */
+   auto force_isa_level(isa_level level) noexcept -> isa_level;
+   /**
+    * @brief Undo force_isa_level().
+    */
+   void reset_isa_level() noexcept;
+
+   /**
+    * @brief An implementation of a kernel along with the level it requires.
+    */
+   template <typename Kernel>
+   struct isa_kernel
+   {
+      isa_level level;
+      Kernel kernel;
+   };
+
+   namespace detail
+   {
+      /**
+       * @brief Entry of the table of dispatched kernels that force_isa_level() reselects.
+       */
+      class dispatch_entry
+      {
+      public:
+         dispatch_entry() noexcept = default;
+         dispatch_entry(const dispatch_entry&) = delete;
+         dispatch_entry(dispatch_entry&&) = delete;
+         virtual ~dispatch_entry() = default;
+
+         auto operator=(const dispatch_entry&) -> dispatch_entry& = delete;
+         auto operator=(dispatch_entry&&) -> dispatch_entry& = delete;
+
+         /**
+          * @brief Select the implementation to use when running at level.
+          */
+         virtual void select(isa_level level) noexcept = 0;
+
+      protected:
+         /**
+          * @brief Add the entry to the table and select its implementation.
+          */
+         void enroll() noexcept;
+         /**
+          * @brief Remove the entry from the table.
+          */
+         void withdraw() noexcept;
+
+      private:
+         dispatch_entry* mp_next{nullptr};
+
+         friend struct dispatch_table;
+      };
+   } // namespace detail
+
+   /**
+    * @brief Function pointer resolved, among implementations written for different instruction
+    * set levels, to the best one the CPU supports.
+    *
+    * @details The selection is made once, when the object is constructed, and again only when
+    * force_isa_level() or reset_isa_level() is called, so a call costs a relaxed load and an
+    * indirect call. Objects are meant to be function local statics of the translation unit
+    * holding the kernels:
+    *
+    * @code{.cpp}
+    * static const dispatched<count_kernel> kernel{
+    *    {isa_level::scalar, count_scalar},
+    * #if defined(LIBCARAMEL_X86_KERNELS)
+    *    {isa_level::avx2, count_avx2},
+    * #endif
+    * };
+    * return kernel(p_words, count);
+    * @endcode
+    *
+    * @tparam Kernel A function pointer type.
+    */
+   template <typename Kernel>
+      requires std::is_pointer_v<Kernel> && std::is_function_v<std::remove_pointer_t<Kernel>>
+   class dispatched final : private detail::dispatch_entry
+   {
+   public:
+      using kernel_type = Kernel;
+
+   public:
+      /**
+       * @brief Register the implementations of a kernel and select one.
+       *
+       * @pre `kernels.size() <= isa_level_count`
+       * @pre one of the kernels is for isa_level::scalar.
+       */
+      dispatched(std::initializer_list<isa_kernel<Kernel>> kernels) noexcept
+      {
+         Expects(kernels.size() <= isa_level_count);
+
+         for (const isa_kernel<Kernel>& kernel : kernels)
+         {
+            m_kernels[m_count++] = kernel; // NOLINT
+         }
+
+         Expects(std::ranges::any_of(kernels, [](const isa_kernel<Kernel>& kernel) {
+            return kernel.level == isa_level::scalar;
+         }));
+
+         enroll();
+      }
+      ~dispatched() override { withdraw(); }
+
+      /**
+       * @brief Call the selected implementation.
+       */
+      template <typename... Args>
+      auto operator()(Args&&... args) const -> decltype(auto)
+      {
+         return get()(std::forward<Args>(args)...);
+      }
+
+      /**
+       * @brief Get the selected implementation.
+       */
+      [[nodiscard]] auto get() const noexcept -> kernel_type
+      {
+         return m_selected.load(std::memory_order_relaxed);
+      }
+      /**
+       * @brief Get the level of the selected implementation.
+       */
+      [[nodiscard]] auto level() const noexcept -> isa_level
+      {
+         return m_level.load(std::memory_order_relaxed);
+      }
+
+   private:
+      void select(isa_level level) noexcept override
+      {
+         isa_kernel<Kernel> best{isa_level::scalar, nullptr};
+         for (std::size_t i = 0; i < m_count; ++i)
+         {
+            const isa_kernel<Kernel>& kernel = m_kernels[i]; // NOLINT
+            if (kernel.level <= level && (best.kernel == nullptr || kernel.level >= best.level))
+            {
+               best = kernel;
+            }
+         }
+
+         m_level.store(best.level, std::memory_order_relaxed);
+         m_selected.store(best.kernel, std::memory_order_relaxed);
+      }
+
+   private:
+      std::array<isa_kernel<Kernel>, isa_level_count> m_kernels{};
+      std::size_t m_count{0};
+
+      std::atomic<kernel_type> m_selected{nullptr};
+      std::atomic<isa_level> m_level{isa_level::scalar};
+   };
+} // namespace caramel
@@ -0,0 +1,261 @@
+#include <libcaramel/util/perf_counters.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <utility>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+
+#   define LIBCARAMEL_PERF_EVENTS 1
+#endif
+
+namespace caramel
+{
+   namespace
+   {
+      constexpr int closed_descriptor = -1;
+
+#if defined(LIBCARAMEL_PERF_EVENTS)
+      struct event_config
+      {
+         u32_t type;
+         u64_t config;
+      };
+
+      constexpr std::array<event_config, perf_event_count> event_configs{
+         {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+          {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)}, // NOLINT
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+          {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}};
+
+      auto open_event(event_config config) noexcept -> int
+      {
+         perf_event_attr attributes{};
+         attributes.size = sizeof(perf_event_attr);
+         attributes.type = config.type;
+         attributes.config = config.config;
+         attributes.disabled = 1;
+         attributes.exclude_kernel = 1;
+         attributes.exclude_hv = 1;
+         attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+         const auto descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+
+         return descriptor < 0 ? closed_descriptor : static_cast<int>(descriptor);
+      }
+
+      auto read_event(int descriptor) noexcept -> std::optional<u64_t>
+      {
+         struct
+         {
+            u64_t value;
+            u64_t time_enabled;
+            u64_t time_running;
+         } sample{};
+
+         if (::read(descriptor, &sample, sizeof(sample)) != static_cast<ssize_t>(sizeof(sample)))
+         {
+            return std::nullopt;
+         }
+
+         if (sample.time_running == 0)
+         {
+            return sample.time_enabled == 0 ? std::optional<u64_t>{0} : std::nullopt;
+         }
+
+         if (sample.time_running == sample.time_enabled)
+         {
+            return sample.value;
+         }
+
+         // The counter was multiplexed with others, extrapolate to the whole enabled time.
+         const double scale =
+            static_cast<double>(sample.time_enabled) / static_cast<double>(sample.time_running);
+
+         return static_cast<u64_t>(static_cast<double>(sample.value) * scale);
+      }
+#endif
+   } // namespace
+
+   auto to_string(perf_event event) noexcept -> std::string_view
+   {
+      switch (event)
+      {
+         case perf_event::cycles:
+            return "cycles";
+         case perf_event::instructions:
+            return "instructions";
+         case perf_event::l1d_read_misses:
+            return "l1d_read_misses";
+         case perf_event::llc_misses:
+            return "llc_misses";
+         case perf_event::branch_misses:
+            return "branch_misses";
+      }
+
+      return "unknown";
+   }
+
+   perf_counters::perf_counters() noexcept
+   {
+      m_descriptors.fill(closed_descriptor);
+
+#if defined(LIBCARAMEL_PERF_EVENTS)
+      for (std::size_t i = 0; i < perf_event_count; ++i)
+      {
+         m_descriptors[i] = open_event(event_configs[i]); // NOLINT
+      }
+#endif
+   }
+   perf_counters::perf_counters(perf_counters&& other) noexcept :
+      m_descriptors{other.m_descriptors}
+   {
+      other.m_descriptors.fill(closed_descriptor);
+   }
+   perf_counters::~perf_counters() noexcept { close(); }
+
+   auto perf_counters::operator=(perf_counters&& rhs) noexcept -> perf_counters&
+   {
+      if (this != &rhs)
+      {
+         close();
+
+         m_descriptors = rhs.m_descriptors;
+         rhs.m_descriptors.fill(closed_descriptor);
+      }
+
+      return *this;
+   }
+
+   auto perf_counters::is_available(perf_event event) const noexcept -> bool
+   {
+      return m_descriptors[static_cast<std::size_t>(event)] != closed_descriptor; // NOLINT
+   }
+   auto perf_counters::any_available() const noexcept -> bool
+   {
+      for (const int descriptor : m_descriptors)
+      {
+         if (descriptor != closed_descriptor)
+         {
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   void perf_counters::start() noexcept
+   {
+#if defined(LIBCARAMEL_PERF_EVENTS)
+      for (const int descriptor : m_descriptors)
+      {
+         if (descriptor != closed_descriptor)
+         {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);   // NOLINT
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);  // NOLINT
+         }
+      }
+#endif
+   }
+   auto perf_counters::stop() noexcept -> perf_counts
+   {
+      perf_counts counts{};
+
+#if defined(LIBCARAMEL_PERF_EVENTS)
+      for (const int descriptor : m_descriptors)
+      {
+         if (descriptor != closed_descriptor)
+         {
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0); // NOLINT
+         }
+      }
+
+      for (std::size_t i = 0; i < perf_event_count; ++i)
+      {
+         if (m_descriptors[i] != closed_descriptor) // NOLINT
+         {
+            counts.values[i] = read_event(m_descriptors[i]); // NOLINT
+         }
+      }
+#endif
+
+      return counts;
+   }
+
+   void perf_counters::close() noexcept
+   {
+#if defined(LIBCARAMEL_PERF_EVENTS)
+      for (int& descriptor : m_descriptors)
+      {
+         if (descriptor != closed_descriptor)
+         {
+            ::close(descriptor);
+            descriptor = closed_descriptor;
+         }
+      }
+#endif
+   }
+
+   void perf_report::add(const perf_counts& counts, i64_t operations) noexcept
+   {
+      Expects(operations >= 0);
+
+      for (std::size_t i = 0; i < perf_event_count; ++i)
+      {
+         const auto& value = counts.values[i]; // NOLINT
+         auto& total = m_totals.values[i];     // NOLINT
+
+         // An event missing from any region makes the whole total meaningless.
+         if (m_regions == 0)
+         {
+            total = value;
+         }
+         else if (total && value)
+         {
+            *total += *value;
+         }
+         else
+         {
+            total = std::nullopt;
+         }
+      }
+
+      m_operations += operations;
+      ++m_regions;
+   }
+
+   auto perf_report::total(perf_event event) const noexcept -> std::optional<u64_t>
+   {
+      return m_totals[event];
+   }
+   auto perf_report::per_operation(perf_event event) const noexcept -> std::optional<double>
+   {
+      const auto value = m_totals[event];
+      if (!value || m_operations == 0)
+      {
+         return std::nullopt;
+      }
+
+      return static_cast<double>(*value) / static_cast<double>(m_operations);
+   }
+
+   perf_counter_scope::perf_counter_scope(perf_counters& counters, perf_report& report,
+                                          i64_t operations) noexcept :
+      m_counters{counters},
+      m_report{report}, m_operations{operations}
+   {
+      Expects(operations >= 0);
+
+      m_counters.start();
+   }
+   perf_counter_scope::~perf_counter_scope() noexcept
+   {
+      m_report.add(m_counters.stop(), m_operations);
+   }
+} // namespace caramel
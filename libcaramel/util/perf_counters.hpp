@@ -0,0 +1,167 @@
+/**
+ * @file util/perf_counters.hpp
+ * @brief Contains the hardware performance counter API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/util/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace caramel
+{
+   /**
+    * @brief The hardware events a perf_counters can measure.
+    */
+   enum struct perf_event : u32_t
+   {
+      cycles,
+      instructions,
+      l1d_read_misses,
+      llc_misses,
+      branch_misses
+   };
+
+   inline constexpr std::size_t perf_event_count = 5;
+
+   /**
+    * @brief Get a short, stable, name for an event, suitable for reports.
+    */
+   auto to_string(perf_event event) noexcept -> std::string_view;
+
+   /**
+    * @brief Value of every event over one measured region, empty for unavailable events.
+    */
+   struct perf_counts
+   {
+      std::array<std::optional<u64_t>, perf_event_count> values{};
+
+      [[nodiscard]] constexpr auto operator[](perf_event event) const noexcept
+         -> std::optional<u64_t>
+      {
+         return values[static_cast<std::size_t>(event)]; // NOLINT
+      }
+   };
+
+   /**
+    * @brief Set of hardware counters for the calling thread, backed by perf_event_open.
+    *
+    * @details Every event is opened independently so that a missing event, a restrictive
+    * `perf_event_paranoid` setting, a container without the syscall or a non Linux target simply
+    * make the affected events unavailable instead of failing. Kernel and hypervisor activity is
+    * excluded and counts are scaled when the kernel multiplexes counters.
+    */
+   class perf_counters
+   {
+   public:
+      perf_counters() noexcept;
+      perf_counters(const perf_counters&) = delete;
+      perf_counters(perf_counters&& other) noexcept;
+      ~perf_counters() noexcept;
+
+      auto operator=(const perf_counters&) -> perf_counters& = delete;
+      auto operator=(perf_counters&& rhs) noexcept -> perf_counters&;
+
+      /**
+       * @brief Check if an event could be opened.
+       */
+      [[nodiscard]] auto is_available(perf_event event) const noexcept -> bool;
+      /**
+       * @brief Check if at least one event could be opened.
+       */
+      [[nodiscard]] auto any_available() const noexcept -> bool;
+
+      /**
+       * @brief Reset and enable every available counter.
+       */
+      void start() noexcept;
+      /**
+       * @brief Disable every available counter and read their values since start().
+       */
+      auto stop() noexcept -> perf_counts;
+
+   private:
+      void close() noexcept;
+
+   private:
+      std::array<int, perf_event_count> m_descriptors{};
+   };
+
+   /**
+    * @brief Accumulates the counts of many measured regions and the operations they performed.
+    */
+   class perf_report
+   {
+   public:
+      /**
+       * @brief Add the counts of a region that performed `operations` operations.
+       *
+       * @pre `operations >= 0`, otherwise UB
+       */
+      void add(const perf_counts& counts, i64_t operations) noexcept;
+
+      /**
+       * @brief Get the sum of an event over every region, empty if the event was unavailable.
+       */
+      [[nodiscard]] auto total(perf_event event) const noexcept -> std::optional<u64_t>;
+      /**
+       * @brief Get the average of an event per operation, empty if the event was unavailable or
+       * no operation was recorded.
+       */
+      [[nodiscard]] auto per_operation(perf_event event) const noexcept -> std::optional<double>;
+      /**
+       * @brief Get the number of operations recorded.
+       */
+      [[nodiscard]] auto operations() const noexcept -> i64_t { return m_operations; }
+
+   private:
+      perf_counts m_totals{};
+      i64_t m_operations{0};
+      i64_t m_regions{0};
+   };
+
+   /**
+    * @brief Measures the lifetime of the scope and adds the result to a perf_report.
+    *
+    * @code{.cpp}
+    * perf_counters counters;
+    * perf_report report;
+    * {
+    *    perf_counter_scope scope{counters, report, array.size()};
+    *    std::sort(array.begin(), array.end());
+    * }
+    * auto misses = report.per_operation(perf_event::llc_misses);
+    * @endcode
+    */
+   class perf_counter_scope
+   {
+   public:
+      /**
+       * @brief Start the counters.
+       *
+       * @pre `operations >= 0`, otherwise UB
+       *
+       * @param[in] counters The counters to measure with, they may not be shared by nested scopes.
+       * @param[in] report The report to add the counts to.
+       * @param[in] operations The number of operations performed within the scope.
+       */
+      perf_counter_scope(perf_counters& counters, perf_report& report,
+                         i64_t operations = 1) noexcept;
+      perf_counter_scope(const perf_counter_scope&) = delete;
+      perf_counter_scope(perf_counter_scope&&) = delete;
+      ~perf_counter_scope() noexcept;
+
+      auto operator=(const perf_counter_scope&) -> perf_counter_scope& = delete;
+      auto operator=(perf_counter_scope&&) -> perf_counter_scope& = delete;
+
+   private:
+      perf_counters& m_counters;
+      perf_report& m_report;
+      i64_t m_operations;
+   };
+} // namespace caramel
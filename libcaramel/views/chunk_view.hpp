@@ -0,0 +1,168 @@
+/**
+ * @file views/chunk_view.hpp
+ * @brief Contains the chunk_view API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/iterators/iterator_facade.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace caramel
+{
+   /**
+    * @brief Random access iterator over consecutive blocks of an array, each given as a
+    * std::span.
+    */
+   template <typename Any>
+   class chunk_iterator : public iterator_facade<chunk_iterator<Any>>
+   {
+   public:
+      constexpr chunk_iterator() = default;
+      constexpr chunk_iterator(std::span<Any> elements, std::ptrdiff_t chunk_size,
+                               std::ptrdiff_t index) :
+         m_elements(elements),
+         m_chunk_size(chunk_size), m_index(index)
+      {}
+
+      [[nodiscard]] constexpr auto dereference() const noexcept -> std::span<Any>
+      {
+         const auto first = static_cast<std::size_t>(m_index * m_chunk_size);
+         const auto count = std::min(static_cast<std::size_t>(m_chunk_size),
+                                     m_elements.size() - first);
+
+         return m_elements.subspan(first, count);
+      }
+
+      constexpr void advance(std::ptrdiff_t off) noexcept { m_index += off; }
+      [[nodiscard]] constexpr auto distance_to(chunk_iterator other) const noexcept
+         -> std::ptrdiff_t
+      {
+         return other.m_index - m_index;
+      }
+      constexpr auto operator==(chunk_iterator other) const noexcept -> bool
+      {
+         return other.m_index == m_index;
+      }
+
+   private:
+      std::span<Any> m_elements;
+      std::ptrdiff_t m_chunk_size{1};
+      std::ptrdiff_t m_index{0};
+   };
+
+   /**
+    * @brief Non-owning view splitting an array into consecutive chunks of chunk_size elements.
+    * Only the last chunk may be shorter.
+    *
+    * @details Chunks are std::span, so each one is a contiguous range that can be handed to a
+    * vectorized kernel as is. full_chunks() and remainder() split the array into the part made of
+    * whole chunks, processed with a fixed trip count, and the tail.
+    *
+    * @tparam Any The type of the elements, const qualified for a read only view.
+    */
+   template <typename Any>
+   class chunk_view
+   {
+   public:
+      using value_type = std::span<Any>;
+      using size_type = i64_t;
+      using difference_type = std::ptrdiff_t;
+      using iterator = chunk_iterator<Any>;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+
+   public:
+      constexpr chunk_view() noexcept = default;
+      /**
+       * @brief Split elements into chunks of chunk_size elements.
+       *
+       * @pre `chunk_size > 0`
+       */
+      constexpr chunk_view(std::span<Any> elements, size_type chunk_size) noexcept :
+         m_elements{elements}, m_chunk_size{chunk_size}
+      {
+         Expects(chunk_size > 0);
+      }
+
+      /**
+       * @brief Access the chunk stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      [[nodiscard]] constexpr auto lookup(size_type index) const -> std::span<Any>
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return *(begin() + index);
+      }
+
+      [[nodiscard]] constexpr auto begin() const noexcept -> iterator
+      {
+         return iterator{m_elements, m_chunk_size, 0};
+      }
+      [[nodiscard]] constexpr auto end() const noexcept -> iterator
+      {
+         return iterator{m_elements, m_chunk_size, size()};
+      }
+      [[nodiscard]] constexpr auto rbegin() const noexcept -> reverse_iterator
+      {
+         return reverse_iterator{end()};
+      }
+      [[nodiscard]] constexpr auto rend() const noexcept -> reverse_iterator
+      {
+         return reverse_iterator{begin()};
+      }
+
+      /**
+       * @brief Get the elements made of whole chunks, a multiple of chunk_size() long.
+       */
+      [[nodiscard]] constexpr auto full_chunks() const noexcept -> std::span<Any>
+      {
+         return m_elements.first(m_elements.size() - m_elements.size() % chunk_size_unsigned());
+      }
+      /**
+       * @brief Get the elements of the last chunk when it is shorter than chunk_size(), or an
+       * empty span.
+       */
+      [[nodiscard]] constexpr auto remainder() const noexcept -> std::span<Any>
+      {
+         return m_elements.last(m_elements.size() % chunk_size_unsigned());
+      }
+
+      /**
+       * @brief Check the number of chunks.
+       */
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type
+      {
+         return (static_cast<size_type>(m_elements.size()) + m_chunk_size - 1) / m_chunk_size;
+      }
+      /**
+       * @brief Check if there are no chunks.
+       */
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_elements.empty(); }
+      /**
+       * @brief Check the number of elements of every chunk but the last.
+       */
+      [[nodiscard]] constexpr auto chunk_size() const noexcept -> size_type { return m_chunk_size; }
+
+   private:
+      [[nodiscard]] constexpr auto chunk_size_unsigned() const noexcept -> std::size_t
+      {
+         return static_cast<std::size_t>(m_chunk_size);
+      }
+
+   private:
+      std::span<Any> m_elements;
+      size_type m_chunk_size{1};
+   };
+} // namespace caramel
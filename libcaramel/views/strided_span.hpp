@@ -0,0 +1,144 @@
+/**
+ * @file views/strided_span.hpp
+ * @brief Contains the strided_span API.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/iterators/strided_iterator.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/gsl_assert>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace caramel
+{
+   /**
+    * @brief Non-owning view over every stride-th element of an array.
+    *
+    * @details Walking the column `c` of a row-major matrix of `columns` columns is
+    * `strided_span{elements, columns, c}`. A stride of one views contiguous elements, but only
+    * as a random access range: use std::span when the stride is known to be one.
+    *
+    * @tparam Any The type of the elements, const qualified for a read only view.
+    */
+   template <typename Any>
+   class strided_span
+   {
+   public:
+      using value_type = std::remove_cv_t<Any>;
+      using size_type = i64_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = Any&;
+      using pointer = Any*;
+      using iterator = strided_iterator<Any>;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+
+   public:
+      constexpr strided_span() noexcept = default;
+      /**
+       * @brief View count elements, stride elements apart, starting at p_first.
+       *
+       * @pre `count >= 0`
+       * @pre `stride > 0`
+       *
+       * @param[in] p_first The first element viewed.
+       * @param[in] count The number of elements viewed.
+       * @param[in] stride The distance, in elements, between two viewed elements.
+       */
+      constexpr strided_span(pointer p_first, size_type count, size_type stride) noexcept :
+         mp_first{p_first}, m_count{count}, m_stride{stride}
+      {
+         Expects(count >= 0);
+         Expects(stride > 0);
+      }
+      /**
+       * @brief View the elements at offset, offset + stride, ... of elements.
+       *
+       * @pre `stride > 0`
+       * @pre `offset >= 0`
+       *
+       * @param[in] elements The array to view.
+       * @param[in] stride The distance, in elements, between two viewed elements.
+       * @param[in] offset The index of the first element viewed.
+       */
+      constexpr strided_span(std::span<Any> elements, size_type stride, size_type offset = 0) :
+         strided_span{elements.data() + std::min(offset, static_cast<size_type>(elements.size())),
+                      count_in(elements, stride, offset), stride}
+      {}
+
+      /**
+       * @brief Access the element stored at a specific index.
+       *
+       * @pre 'index < size()'.
+       * @pre 'index >= 0'.
+       */
+      [[nodiscard]] constexpr auto lookup(size_type index) const -> reference
+      {
+         Expects(index < size());
+         Expects(index >= 0);
+
+         return mp_first[index * m_stride]; // NOLINT
+      }
+
+      [[nodiscard]] constexpr auto begin() const noexcept -> iterator
+      {
+         return iterator{mp_first, 0, m_stride};
+      }
+      [[nodiscard]] constexpr auto end() const noexcept -> iterator
+      {
+         return iterator{mp_first, m_count, m_stride};
+      }
+      [[nodiscard]] constexpr auto rbegin() const noexcept -> reverse_iterator
+      {
+         return reverse_iterator{end()};
+      }
+      [[nodiscard]] constexpr auto rend() const noexcept -> reverse_iterator
+      {
+         return reverse_iterator{begin()};
+      }
+
+      /**
+       * @brief Access the first element viewed.
+       */
+      [[nodiscard]] constexpr auto data() const noexcept -> pointer { return mp_first; }
+      /**
+       * @brief Check the number of elements viewed.
+       */
+      [[nodiscard]] constexpr auto size() const noexcept -> size_type { return m_count; }
+      /**
+       * @brief Check if the view is empty.
+       */
+      [[nodiscard]] constexpr auto empty() const noexcept -> bool { return m_count == 0; }
+      /**
+       * @brief Check the distance, in elements, between two viewed elements.
+       */
+      [[nodiscard]] constexpr auto stride() const noexcept -> size_type { return m_stride; }
+
+   private:
+      static constexpr auto count_in(std::span<Any> elements, size_type stride, size_type offset)
+         -> size_type
+      {
+         Expects(stride > 0);
+         Expects(offset >= 0);
+
+         const auto size = static_cast<size_type>(elements.size());
+         if (offset >= size)
+         {
+            return 0;
+         }
+
+         return (size - offset + stride - 1) / stride;
+      }
+
+   private:
+      pointer mp_first{nullptr};
+      size_type m_count{0};
+      size_type m_stride{1};
+   };
+} // namespace caramel
@@ -0,0 +1,108 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/algorithms/simd.hpp>
+#include <libcaramel/containers/dynamic_array.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace caramel;
+
+namespace
+{
+   // Sizes around the 16 and 32 byte vectors of every element width.
+   constexpr i64_t max_size = 80;
+
+   template <typename Any>
+   void check_search()
+   {
+      for (i64_t size = 0; size <= max_size; ++size)
+      {
+         std::vector<Any> values(static_cast<std::size_t>(size), Any{1});
+         CHECK(simd::find(values, Any{2}) == size);
+         CHECK(simd::count(values, Any{1}) == size);
+         CHECK_FALSE(simd::contains(values, Any{2}));
+
+         for (i64_t position = 0; position < size; ++position)
+         {
+            values[static_cast<std::size_t>(position)] = Any{2};
+            CHECK(simd::find(values, Any{2}) == position);
+            CHECK(simd::count(values, Any{2}) == 1);
+            values[static_cast<std::size_t>(position)] = Any{1};
+         }
+      }
+   }
+
+   template <typename Any>
+   void check_compare()
+   {
+      for (i64_t size = 0; size <= max_size; ++size)
+      {
+         std::vector<Any> lhs(static_cast<std::size_t>(size), Any{3});
+         std::vector<Any> rhs = lhs;
+         CHECK(simd::equal(lhs, rhs));
+         CHECK(simd::compare(lhs, rhs) == std::strong_ordering::equal);
+
+         for (i64_t position = 0; position < size; ++position)
+         {
+            rhs[static_cast<std::size_t>(position)] = Any{4};
+            CHECK_FALSE(simd::equal(lhs, rhs));
+            CHECK(simd::compare(lhs, rhs) == std::strong_ordering::less);
+            CHECK(simd::compare(rhs, lhs) == std::strong_ordering::greater);
+            rhs[static_cast<std::size_t>(position)] = Any{3};
+         }
+
+         rhs.push_back(Any{0});
+         CHECK_FALSE(simd::equal(lhs, rhs));
+         CHECK(simd::compare(lhs, rhs) == std::strong_ordering::less);
+      }
+   }
+} // namespace
+
+TEST_SUITE("simd algorithms test suite") // NOLINT
+{
+   TEST_CASE("find and count match the scalar algorithms") // NOLINT
+   {
+      check_search<std::int8_t>();
+      check_search<std::uint16_t>();
+      check_search<std::int32_t>();
+      check_search<std::uint64_t>();
+      check_search<std::byte>();
+      check_search<double>();
+   }
+   TEST_CASE("equal and compare find the first difference") // NOLINT
+   {
+      check_compare<std::uint8_t>();
+      check_compare<std::int16_t>();
+      check_compare<std::uint32_t>();
+      check_compare<std::int64_t>();
+      check_compare<std::byte>();
+   }
+   TEST_CASE("compare orders elements by value, not by bytes") // NOLINT
+   {
+      const std::vector<int> lhs{-1, 5};
+      const std::vector<int> rhs{1, 0};
+      CHECK(simd::compare(lhs, rhs) == std::strong_ordering::less);
+
+      const std::vector<std::uint32_t> little{0x100, 0};
+      const std::vector<std::uint32_t> big{0x001, 0};
+      CHECK(simd::compare(little, big) == std::strong_ordering::greater);
+
+      const std::vector<double> nan{0.0, std::numeric_limits<double>::quiet_NaN()};
+      CHECK_FALSE(simd::equal(nan, nan));
+      CHECK(simd::equal(std::vector<double>{-0.0}, std::vector<double>{0.0}));
+   }
+   TEST_CASE("dynamic_array comparisons use the kernels") // NOLINT
+   {
+      const dynamic_array<int> lhs{1, 2, 3};
+      const dynamic_array<int> rhs{1, 2, 4};
+
+      CHECK(lhs != rhs);
+      CHECK((lhs <=> rhs) == std::strong_ordering::less);
+      CHECK(simd::contains(lhs, 3));
+      CHECK(dynamic_array<int>{} == dynamic_array<int>{});
+   }
+}
@@ -1,8 +1,25 @@
 #include <doctest/doctest.h>
 
 #include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/containers/small_string.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/static_allocator.hpp>
 
+#include <algorithm>
+#include <array>
 #include <compare>
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 using namespace caramel;
 
@@ -22,6 +39,38 @@ private:
    int m_b = 0;
 };
 
+struct arena_node
+{
+   static inline int destroyed = 0; // NOLINT
+
+   arena_node() = default;
+   arena_node(const arena_node&) = default;
+   arena_node(arena_node&&) = default;
+   ~arena_node() { ++destroyed; }
+
+   auto operator=(const arena_node&) -> arena_node& = default;
+   auto operator=(arena_node&&) -> arena_node& = default;
+};
+
+template <>
+inline constexpr bool caramel::enable_wink_out<arena_node> = true;
+
+struct throwing_move
+{
+   int value = 0;
+
+   throwing_move(int new_value) : value{new_value} {}
+   throwing_move(const throwing_move&) = default;
+   throwing_move(throwing_move&& /* other */) { throw std::runtime_error{"moved"}; } // NOLINT
+   ~throwing_move() = default;
+
+   auto operator=(const throwing_move&) -> throwing_move& = default;
+   auto operator=(throwing_move&& /* other */) -> throwing_move& // NOLINT
+   {
+      throw std::runtime_error{"moved"};
+   }
+};
+
 TEST_SUITE("dynamic_array test suite") // NOLINT
 {
    TEST_CASE("default ctor") // NOLINT
@@ -75,4 +124,681 @@ TEST_SUITE("dynamic_array test suite") // NOLINT
       CHECK(test.lookup(0).a() == 10);
       CHECK(test.lookup(0).b() == 20);
    }
+
+   TEST_CASE("iterators are contiguous") // NOLINT
+   {
+      static_assert(std::contiguous_iterator<dynamic_array<int>::iterator>);
+      static_assert(std::contiguous_iterator<dynamic_array<int>::const_iterator>);
+      static_assert(std::contiguous_iterator<small_dynamic_array<int, 4>::iterator>);
+
+      dynamic_array<int> values{1, 2, 3, 4};
+      const std::span<int> view{values};
+
+      CHECK(view.data() == values.data());
+      CHECK(view.size() == 4);
+      CHECK(std::to_address(values.end()) == values.data() + 4); // NOLINT
+
+      dynamic_array<int> copy{values.begin() + 1, values.end()};
+      copy.insert(copy.begin(), values.begin(), values.begin() + 2);
+      CHECK(copy == dynamic_array<int>{1, 2, 2, 3, 4});
+   }
+
+   TEST_CASE("append_range") // NOLINT
+   {
+      SUBCASE("contiguous trivially copyable range")
+      {
+         const std::array<int, 5> source{1, 2, 3, 4, 5};
+
+         dynamic_array<int> values{0};
+         values.append_range(source);
+
+         CHECK(values == dynamic_array<int>{0, 1, 2, 3, 4, 5});
+         CHECK(values.capacity() == 8);
+      }
+      SUBCASE("forward range without size")
+      {
+         const std::forward_list<std::string> source{"a", "b", "c"};
+
+         small_dynamic_array<std::string, 2> values;
+         values.append_range(source);
+
+         CHECK(values == small_dynamic_array<std::string, 2>{"a", "b", "c"});
+      }
+      SUBCASE("single pass input range")
+      {
+         std::istringstream stream{"1 2 3 4 5 6 7 8 9"};
+
+         dynamic_array<int> values;
+         values.append_range(std::views::istream<int>(stream));
+
+         CHECK(values == dynamic_array<int>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+      }
+      SUBCASE("converting and moving ranges")
+      {
+         dynamic_array<std::unique_ptr<int>> pointers;
+         pointers.append(std::make_unique<int>(1));
+         pointers.append(std::make_unique<int>(2));
+
+         dynamic_array<std::unique_ptr<int>> values;
+         values.append_range(std::ranges::subrange{std::make_move_iterator(pointers.begin()),
+                                                   std::make_move_iterator(pointers.end())});
+
+         REQUIRE(values.size() == 2);
+         CHECK(*values.lookup(1) == 2);
+         CHECK(pointers.lookup(0) == nullptr);
+
+         dynamic_array<double> doubles;
+         doubles.append_range(std::views::iota(0, 3));
+         CHECK(doubles == dynamic_array<double>{0.0, 1.0, 2.0});
+      }
+   }
+
+   TEST_CASE("insert_range") // NOLINT
+   {
+      const std::list<int> source{7, 8, 9};
+
+      SUBCASE("fewer elements after pos than inserted")
+      {
+         dynamic_array<int> values{1, 2, 3, 4};
+
+         const auto it = values.insert_range(values.end() - 1, source);
+
+         CHECK(it == values.begin() + 3);
+         CHECK(values == dynamic_array<int>{1, 2, 3, 7, 8, 9, 4});
+      }
+      SUBCASE("more elements after pos than inserted")
+      {
+         small_dynamic_array<std::string, 8> values{"a", "b", "c", "d", "e"};
+
+         const std::array<std::string, 2> strings{"x", "y"};
+         const auto it = values.insert_range(values.begin() + 1, strings);
+
+         CHECK(*it == "x");
+         CHECK(values == small_dynamic_array<std::string, 8>{"a", "x", "y", "b", "c", "d", "e"});
+      }
+      SUBCASE("contiguous trivially copyable range")
+      {
+         dynamic_array<int> values{1, 2};
+         const std::array<int, 3> numbers{7, 8, 9};
+
+         values.insert_range(values.begin(), numbers);
+         values.insert_range(values.end(), numbers);
+
+         CHECK(values == dynamic_array<int>{7, 8, 9, 1, 2, 7, 8, 9});
+      }
+      SUBCASE("single pass input range")
+      {
+         std::istringstream stream{"7 8 9"};
+
+         dynamic_array<int> values{1, 2, 3};
+         const auto it = values.insert_range(values.begin() + 1, std::views::istream<int>(stream));
+
+         CHECK(it == values.begin() + 1);
+         CHECK(values == dynamic_array<int>{1, 7, 8, 9, 2, 3});
+      }
+      SUBCASE("sized single pass input range")
+      {
+         std::istringstream stream{"10 20 30 40 50"};
+
+         dynamic_array<int> values{1, 2};
+         const auto it = values.insert_range(
+            values.begin() + 1, std::views::counted(std::istream_iterator<int>{stream}, 5));
+
+         CHECK(it == values.begin() + 1);
+         CHECK(values == dynamic_array<int>{1, 10, 20, 30, 40, 50, 2});
+      }
+      SUBCASE("input iterators")
+      {
+         std::istringstream stream{"7 8"};
+
+         dynamic_array<int> values{1, 2};
+         values.insert(values.begin(), std::istream_iterator<int>{stream},
+                       std::istream_iterator<int>{});
+
+         CHECK(values == dynamic_array<int>{7, 8, 1, 2});
+      }
+      SUBCASE("initializer list")
+      {
+         dynamic_array<int> values{1, 2};
+         values.insert(values.begin() + 1, {5, 6});
+
+         CHECK(values == dynamic_array<int>{1, 5, 6, 2});
+      }
+   }
+
+   TEST_CASE("erase range") // NOLINT
+   {
+      dynamic_array<int> values{1, 2, 3, 4, 5};
+
+      const auto it = values.erase(values.begin() + 1, values.begin() + 3);
+
+      CHECK(*it == 4);
+      CHECK(values == dynamic_array<int>{1, 4, 5});
+   }
+
+   TEST_CASE("erase_unordered") // NOLINT
+   {
+      small_dynamic_array<std::string, 4> values{"a", "b", "c", "d"};
+
+      auto it = values.erase_unordered(values.begin() + 1);
+      CHECK(*it == "d");
+      CHECK(values == small_dynamic_array<std::string, 4>{"a", "d", "c"});
+
+      it = values.erase_unordered(values.end() - 1);
+      CHECK(it == values.end());
+      CHECK(values == small_dynamic_array<std::string, 4>{"a", "d"});
+   }
+
+   TEST_CASE("erase_if") // NOLINT
+   {
+      dynamic_array<std::unique_ptr<int>> values;
+      for (int i = 0; i < 10; ++i)
+      {
+         values.append(std::make_unique<int>(i));
+      }
+
+      const auto removed = values.erase_if([](const std::unique_ptr<int>& value) {
+         return *value % 3 == 0;
+      });
+
+      CHECK(removed == 4);
+      REQUIRE(values.size() == 6);
+      for (std::size_t i = 0; const int expected : {1, 2, 4, 5, 7, 8})
+      {
+         CHECK(*values.lookup(static_cast<i64_t>(i++)) == expected);
+      }
+
+      CHECK(values.erase_if([](const auto&) { return false; }) == 0);
+   }
+
+   TEST_CASE("erase_indices") // NOLINT
+   {
+      const dynamic_array<std::string> letters{"a", "b", "c", "d", "e", "f", "g"};
+
+      SUBCASE("scattered indices")
+      {
+         dynamic_array<std::string> values{letters};
+
+         const std::array<i64_t, 3> indices{0, 3, 4};
+         values.erase_indices(indices);
+
+         CHECK(values == dynamic_array<std::string>{"b", "c", "f", "g"});
+      }
+      SUBCASE("trailing index")
+      {
+         dynamic_array<std::string> values{letters};
+
+         const std::array<i64_t, 2> indices{5, 6};
+         values.erase_indices(indices);
+
+         CHECK(values == dynamic_array<std::string>{"a", "b", "c", "d", "e"});
+      }
+      SUBCASE("no index")
+      {
+         dynamic_array<std::string> values{letters};
+
+         values.erase_indices({});
+
+         CHECK(values == letters);
+      }
+   }
+   TEST_CASE("small buffer lives within the array") // NOLINT
+   {
+      const auto is_inline = [](const auto& values) {
+         const auto* p_object = reinterpret_cast<const std::byte*>(&values);   // NOLINT
+         const auto* p_data = reinterpret_cast<const std::byte*>(values.data()); // NOLINT
+
+         return p_data >= p_object && p_data < p_object + sizeof(values); // NOLINT
+      };
+
+      basic_dynamic_array<char, 3> chars{'a', 'b', 'c'};
+      basic_dynamic_array<i64_t, 4> words{1, 2, 3, 4};
+      basic_dynamic_array<std::string, 2> strings{"a", "b"};
+
+      CHECK(is_inline(chars));
+      CHECK(is_inline(words));
+      CHECK(is_inline(strings));
+      CHECK(reinterpret_cast<std::uintptr_t>(words.data()) % alignof(i64_t) == 0); // NOLINT
+
+      chars.append('d');
+      words.append(5);
+      strings.append("c");
+
+      CHECK_FALSE(is_inline(chars));
+      CHECK_FALSE(is_inline(words));
+      CHECK_FALSE(is_inline(strings));
+      CHECK(words == basic_dynamic_array<i64_t, 0>{1, 2, 3, 4, 5});
+      CHECK(strings == basic_dynamic_array<std::string, 0>{"a", "b", "c"});
+   }
+   TEST_CASE("arrays of any size share a base") // NOLINT
+   {
+      const auto fill = [](dynamic_array_base<int>& values, int count) {
+         for (int i = 0; i < count; ++i)
+         {
+            values.append(i);
+         }
+
+         values.erase_if([](int value) {
+            return value % 2 == 1;
+         });
+      };
+
+      basic_dynamic_array<int, 0> none;
+      basic_dynamic_array<int, 4> few;
+      basic_dynamic_array<int, 64> many;
+
+      fill(none, 10);
+      fill(few, 10);
+      fill(many, 10);
+
+      CHECK(none == basic_dynamic_array<int, 0>{0, 2, 4, 6, 8});
+      CHECK(few == none);
+      CHECK(many == none);
+      CHECK(many.capacity() == 64);
+   }
+   TEST_CASE("growth keeps trivially copyable elements") // NOLINT
+   {
+      struct alignas(32) wide
+      {
+         i64_t value;
+      };
+
+      basic_dynamic_array<wide, 2> values;
+      for (i64_t i = 0; i < 100; ++i)
+      {
+         values.append(wide{i});
+
+         CHECK(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(wide) == 0); // NOLINT
+      }
+
+      REQUIRE(values.size() == 100);
+      for (i64_t i = 0; i < 100; ++i)
+      {
+         CHECK(values.lookup(i).value == i);
+      }
+   }
+   TEST_CASE("copy assignment reuses storage") // NOLINT
+   {
+      const dynamic_array<std::string> source{"a", "b", "c"};
+
+      SUBCASE("into a larger array")
+      {
+         dynamic_array<std::string> values{"d", "e", "f", "g", "h", "i", "j", "k"};
+         const auto* p_data = values.data();
+
+         values = source;
+
+         CHECK(values == source);
+         CHECK(values.data() == p_data);
+         CHECK(values.capacity() >= 8);
+      }
+      SUBCASE("into a smaller array")
+      {
+         dynamic_array<std::string> values{"d"};
+         values.reserve(16);
+         const auto* p_data = values.data();
+
+         values = source;
+
+         CHECK(values == source);
+         CHECK(values.data() == p_data);
+      }
+      SUBCASE("into an array too small")
+      {
+         small_dynamic_array<std::string, 1> values{"d"};
+
+         values = small_dynamic_array<std::string, 1>{"a", "b", "c"};
+
+         CHECK(values == small_dynamic_array<std::string, 1>{"a", "b", "c"});
+      }
+   }
+   TEST_CASE("move never allocates nor leaks") // NOLINT
+   {
+      checked_resource checked;
+      const memory_allocator<std::string> allocator{&checked};
+
+      using array = basic_dynamic_array<std::string, 2, memory_allocator<std::string>>;
+
+      {
+         const std::array<std::string, 4> letters{"a", "b", "c", "d"};
+
+         array in_place{letters.begin(), letters.begin() + 2, allocator};
+         array on_heap{letters.begin(), letters.end(), allocator};
+         array other_in_place{{"x"}, allocator};
+         array other_on_heap{letters.begin(), letters.end(), allocator};
+
+         const i64_t live = checked.live_allocations();
+
+         other_in_place = std::move(on_heap);
+         CHECK(other_in_place == array{letters.begin(), letters.end()});
+         CHECK(on_heap.empty()); // NOLINT
+
+         other_on_heap = std::move(in_place);
+         CHECK(other_on_heap == array{"a", "b"});
+         CHECK(other_on_heap.capacity() >= 4);
+         CHECK(in_place.empty()); // NOLINT
+         CHECK(checked.live_allocations() == live);
+
+         array moved{std::move(other_in_place)};
+         CHECK(moved.size() == 4);
+         CHECK(moved.allocator() == allocator);
+         CHECK(checked.live_allocations() == live);
+
+         array moved_with_allocator{std::move(moved), memory_allocator<std::string>{}};
+         CHECK(moved_with_allocator.size() == 4);
+         CHECK(moved.empty()); // NOLINT
+      }
+
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("move assignment keeps the allocator") // NOLINT
+   {
+      checked_resource lhs_resource;
+      checked_resource rhs_resource;
+
+      using array = basic_dynamic_array<std::string, 2, memory_allocator<std::string>>;
+
+      {
+         const std::array<std::string, 4> letters{"a", "b", "c", "d"};
+
+         array on_heap{letters.begin(), letters.end(), &lhs_resource};
+         array in_place{{"x"}, &lhs_resource};
+
+         array other_on_heap{letters.begin(), letters.end(), &rhs_resource};
+         array other_in_place{{"y"}, &rhs_resource};
+
+         in_place = std::move(other_on_heap);
+         CHECK(in_place == array{letters.begin(), letters.end()});
+         CHECK(in_place.allocator().resource() == &lhs_resource);
+         CHECK(other_on_heap.empty()); // NOLINT
+         CHECK(rhs_resource.live_allocations() == 0);
+
+         on_heap = std::move(other_in_place);
+         CHECK(on_heap == array{"y"});
+         CHECK(on_heap.allocator().resource() == &lhs_resource);
+      }
+
+      CHECK(lhs_resource.live_allocations() == 0);
+      CHECK(rhs_resource.live_allocations() == 0);
+   }
+   TEST_CASE("swap") // NOLINT
+   {
+      const dynamic_array<std::string> few{"a", "b"};
+      const dynamic_array<std::string> more{"c", "d", "e"};
+      const dynamic_array<std::string> many{"f", "g", "h", "i", "j", "k"};
+
+      using array = basic_dynamic_array<std::string, 4>;
+
+      const auto check_swap = [](const auto& lhs_values, const auto& rhs_values) {
+         array lhs{lhs_values.begin(), lhs_values.end()};
+         array rhs{rhs_values.begin(), rhs_values.end()};
+         const auto* p_lhs_heap = lhs.size() > 4 ? lhs.data() : nullptr;
+
+         swap(lhs, rhs);
+
+         CHECK(std::ranges::equal(lhs, rhs_values));
+         CHECK(std::ranges::equal(rhs, lhs_values));
+         CHECK(lhs.capacity() >= lhs.size());
+         CHECK(rhs.capacity() >= rhs.size());
+         if (p_lhs_heap)
+         {
+            CHECK(rhs.data() == p_lhs_heap);
+         }
+      };
+
+      check_swap(few, more);
+      check_swap(more, few);
+      check_swap(few, many);
+      check_swap(many, more);
+      check_swap(many, many);
+
+      dynamic_array<std::string> lhs{few};
+      dynamic_array<std::string> rhs{many};
+      lhs.swap(rhs);
+      CHECK(lhs == many);
+      CHECK(rhs == few);
+   }
+   TEST_CASE("move is noexcept when it cannot allocate nor throw") // NOLINT
+   {
+      using static_array =
+         basic_dynamic_array<std::string, 4, static_allocator<std::string, monotonic_resource>>;
+
+      static_assert(std::is_nothrow_move_constructible_v<dynamic_array<std::string>>);
+      static_assert(std::is_nothrow_move_constructible_v<small_dynamic_array<std::string, 4>>);
+      static_assert(std::is_nothrow_move_assignable_v<static_array>);
+      static_assert(std::is_nothrow_swappable_v<static_array>);
+
+      // Unequal memory_allocators make move assignment and swap allocate.
+      static_assert(!std::is_nothrow_move_assignable_v<dynamic_array<std::string>>);
+      static_assert(!std::is_nothrow_swappable_v<dynamic_array<std::string>>);
+      static_assert(!std::is_nothrow_move_assignable_v<small_string<8>>);
+
+      static_assert(std::is_nothrow_move_constructible_v<dynamic_array<throwing_move>>);
+      static_assert(!std::is_nothrow_move_constructible_v<small_dynamic_array<throwing_move, 4>>);
+      static_assert(!std::is_nothrow_swappable_v<small_dynamic_array<throwing_move, 4>>);
+
+      std::vector<small_dynamic_array<int, 2>> arrays(1, small_dynamic_array<int, 2>{1, 2, 3});
+      const auto* p_data = arrays.front().data();
+
+      arrays.resize(64);
+
+      CHECK(arrays.front().data() == p_data);
+   }
+   TEST_CASE("moves between unequal allocators report failures") // NOLINT
+   {
+      checked_resource checked;
+
+      basic_dynamic_array<throwing_move, 0> values{{1, 2},
+                                                   memory_allocator<throwing_move>{&checked}};
+      basic_dynamic_array<throwing_move, 0> other{3, 4, 5};
+
+      CHECK_THROWS_AS(values = std::move(other), std::runtime_error);
+      CHECK_THROWS_AS(values.swap(other), std::runtime_error);
+
+      CHECK(values.allocator().resource() == &checked);
+      CHECK(other.size() == 3);
+   }
+   TEST_CASE("nested arrays allocate from the resource of the outer array") // NOLINT
+   {
+      checked_resource checked;
+
+      const auto in_checked = [&](const auto& values) {
+         return std::ranges::all_of(values, [&](const auto& value) {
+            return value.allocator().resource() == &checked;
+         });
+      };
+
+      {
+         using inner = dynamic_array<int>;
+
+         dynamic_array<inner> outer(memory_allocator<inner>{&checked});
+         outer.append(in_place, 3, 1);
+         outer.append(inner{1, 2, 3, 4});
+         outer.resize(4);
+         outer.insert(outer.begin(), inner{5, 6});
+         outer.insert(outer.begin() + 1, i64_t{2}, inner{7});
+
+         const std::array<inner, 2> more{inner{8}, inner{9, 10}};
+         outer.insert_range(outer.begin() + 2, more);
+         outer.append_range(more);
+
+         REQUIRE(outer.size() == 11);
+         CHECK(outer.lookup(0) == inner{5, 6});
+         CHECK(outer.lookup(1) == inner{7});
+         CHECK(outer.lookup(3) == inner{9, 10});
+         CHECK(outer.lookup(5) == inner{1, 1, 1});
+         CHECK(in_checked(outer));
+
+         const dynamic_array<inner> copy{outer};
+         CHECK(copy == outer);
+         CHECK(in_checked(copy));
+
+         dynamic_array<inner> moved{std::move(outer)};
+         CHECK(in_checked(moved));
+
+         dynamic_array<small_dynamic_array<std::string, 1>> strings(
+            memory_allocator<small_dynamic_array<std::string, 1>>{&checked});
+         strings.append(in_place, 4, "a long string that does not fit inline");
+         strings.resize(3);
+         CHECK(in_checked(strings));
+      }
+
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("assigned elements stay in the resource of the outer array") // NOLINT
+   {
+      checked_resource checked;
+
+      const auto in_checked = [&](const auto& values) {
+         return std::ranges::all_of(values, [&](const auto& value) {
+            return value.allocator().resource() == &checked;
+         });
+      };
+
+      using inner = dynamic_array<int>;
+
+      const auto make_outer = [&] {
+         dynamic_array<inner> outer(memory_allocator<inner>{&checked});
+         outer.append(in_place, 2, 1);
+         outer.append(in_place, 20, 2);
+
+         return outer;
+      };
+
+      {
+         SUBCASE("move assignment")
+         {
+            auto outer = make_outer();
+            inner small{3, 4};
+            inner large(50, 5);
+            outer.lookup(0) = std::move(small);
+            outer.lookup(1) = std::move(large);
+
+            CHECK(outer.lookup(0) == inner{3, 4});
+            CHECK(outer.lookup(1) == inner(50, 5));
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("copy assignment")
+         {
+            auto outer = make_outer();
+            const inner large(50, 6);
+            outer.lookup(0) = large;
+
+            CHECK(outer.lookup(0) == large);
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("swap")
+         {
+            auto outer = make_outer();
+            inner other(30, 7);
+            swap(outer.lookup(0), other);
+            outer.lookup(0).swap(outer.lookup(1));
+
+            CHECK(outer.lookup(0) == inner(20, 2));
+            CHECK(outer.lookup(1) == inner(30, 7));
+            CHECK(other == inner(2, 1));
+            CHECK(other.allocator().resource() == get_default_memory_resource());
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("assignment of the outer array")
+         {
+            auto outer = make_outer();
+            const dynamic_array<inner> source{inner(40, 8), inner{9}, inner(10, 10)};
+            outer = source;
+
+            CHECK(outer == source);
+            CHECK(outer.allocator().resource() == &checked);
+            CHECK(in_checked(outer));
+
+            dynamic_array<inner> temporary{inner(60, 11)};
+            outer = std::move(temporary);
+
+            CHECK(outer == dynamic_array<inner>{inner(60, 11)});
+            CHECK(in_checked(outer));
+         }
+      }
+
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("wink_out abandons the elements to the arena") // NOLINT
+   {
+      static_assert(winkable<int>);
+      static_assert(winkable<dynamic_array<dynamic_array<int>>>);
+      static_assert(winkable<small_dynamic_array<arena_node, 4>>);
+      static_assert(!winkable<std::string>);
+      static_assert(!winkable<dynamic_array<std::string>>);
+
+      checked_resource checked;
+      monotonic_resource arena{&checked};
+
+      {
+         using inner = dynamic_array<int>;
+
+         dynamic_array<inner> outer(memory_allocator<inner>{&arena});
+         for (int i = 0; i < 100; ++i)
+         {
+            outer.append(in_place, 100, i);
+         }
+
+         outer.wink_out();
+
+         CHECK(outer.empty());
+         CHECK(outer.capacity() == 0);
+
+         small_dynamic_array<arena_node, 2> nodes(memory_allocator<arena_node>{&arena});
+         nodes.resize(16);
+
+         arena_node::destroyed = 0;
+         nodes.wink_out();
+
+         CHECK(nodes.empty());
+         CHECK(nodes.capacity() == 2);
+
+         nodes.resize(1);
+      }
+
+      CHECK(arena_node::destroyed == 1);
+
+      arena.release();
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("wink_out after assigning nested elements leaks nothing") // NOLINT
+   {
+      checked_resource outside;
+      monotonic_resource arena{&outside};
+
+      using inner = dynamic_array<int>;
+
+      {
+         dynamic_array<inner> outer(memory_allocator<inner>{&arena});
+         outer.resize(3);
+
+         inner moved(100, 1, memory_allocator<int>{&outside});
+         const inner copied(100, 2, memory_allocator<int>{&outside});
+         inner swapped(100, 3, memory_allocator<int>{&outside});
+
+         outer.lookup(0) = std::move(moved);
+         outer.lookup(1) = copied;
+         outer.lookup(2).swap(swapped);
+
+         CHECK(std::ranges::all_of(outer, [&](const inner& value) {
+            return value.allocator().resource() == &arena;
+         }));
+
+         const i64_t live = outside.live_allocations();
+
+         outer.wink_out();
+
+         CHECK(outside.live_allocations() == live);
+
+         dynamic_array<small_string<4>> strings(memory_allocator<small_string<4>>{&arena});
+         strings.resize(1);
+         strings.lookup(0) = small_string<4>{"a string too large for the buffer"};
+
+         strings.wink_out();
+      }
+
+      arena.release();
+      CHECK(outside.live_allocations() == 0);
+   }
 }
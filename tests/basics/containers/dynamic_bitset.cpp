@@ -0,0 +1,138 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_bitset.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace caramel;
+
+TEST_SUITE("dynamic_bitset test suite") // NOLINT
+{
+   TEST_CASE("set, reset and test") // NOLINT
+   {
+      dynamic_bitset bits{130}; // NOLINT
+
+      REQUIRE(std::size(bits) == 130);
+      REQUIRE(bits.word_count() == 3);
+      REQUIRE(bits.none());
+
+      bits.set(0).set(64).set(129); // NOLINT
+      CHECK(bits.test(0));
+      CHECK(bits.test(64));
+      CHECK(bits.test(129));
+      CHECK_FALSE(bits.test(1));
+      CHECK(bits.count() == 3);
+
+      bits.reset(64).flip(1); // NOLINT
+      CHECK_FALSE(bits.test(64));
+      CHECK(bits.test(1));
+      CHECK(bits.count() == 3);
+   }
+
+   TEST_CASE("whole set operations keep the unused bits cleared") // NOLINT
+   {
+      dynamic_bitset bits{70}; // NOLINT
+
+      bits.set();
+      CHECK(bits.all());
+      CHECK(bits.count() == 70);
+
+      bits.flip();
+      CHECK(bits.none());
+
+      bits.resize(200, true); // NOLINT
+      CHECK(bits.count() == 130);
+      CHECK_FALSE(bits.test(69));
+      CHECK(bits.test(70));
+
+      bits.resize(65); // NOLINT
+      CHECK(bits.count() == 0);
+   }
+
+   TEST_CASE("bulk operations") // NOLINT
+   {
+      dynamic_bitset lhs{300}; // NOLINT
+      dynamic_bitset rhs{300}; // NOLINT
+
+      for (std::int64_t i = 0; i < 300; i += 2) // NOLINT
+      {
+         lhs.set(i);
+      }
+      for (std::int64_t i = 0; i < 300; i += 3) // NOLINT
+      {
+         rhs.set(i);
+      }
+
+      CHECK((lhs & rhs).count() == 50);
+      CHECK((lhs | rhs).count() == 200);
+      CHECK((lhs ^ rhs).count() == 150);
+      CHECK((~lhs).count() == 150);
+
+      auto diff = lhs;
+      diff.difference(rhs);
+      CHECK(diff.count() == 100);
+   }
+
+   TEST_CASE("find_first and find_next") // NOLINT
+   {
+      dynamic_bitset bits{1000}; // NOLINT
+      CHECK(bits.find_first() == 1000);
+
+      const std::vector<std::int64_t> positions{3, 63, 64, 500, 999};
+      for (auto pos : positions)
+      {
+         bits.set(pos);
+      }
+
+      std::vector<std::int64_t> found;
+      for (auto pos = bits.find_first(); pos != std::size(bits); pos = bits.find_next(pos))
+      {
+         found.push_back(pos);
+      }
+
+      CHECK(found == positions);
+   }
+
+   TEST_CASE("append") // NOLINT
+   {
+      dynamic_bitset bits;
+      for (int i = 0; i < 100; ++i) // NOLINT
+      {
+         bits.append(i % 5 == 0);
+      }
+
+      CHECK(std::size(bits) == 100);
+      CHECK(bits.count() == 20);
+      CHECK(bits.test(95));
+   }
+
+   TEST_CASE("rank and select") // NOLINT
+   {
+      std::mt19937_64 engine{42}; // NOLINT
+      std::bernoulli_distribution distribution{0.3};
+
+      dynamic_bitset bits{5000}; // NOLINT
+      std::vector<std::int64_t> ones;
+      for (std::int64_t i = 0; i < std::size(bits); ++i)
+      {
+         if (distribution(engine))
+         {
+            bits.set(i);
+            ones.push_back(i);
+         }
+      }
+
+      REQUIRE(bits.count() == std::ssize(ones));
+
+      rank_select_index index{bits};
+      for (std::int64_t i = 0; i < std::ssize(ones); ++i)
+      {
+         CHECK(index.select(i) == ones[i]);
+         CHECK(index.rank(ones[i]) == i);
+      }
+
+      CHECK(index.rank(std::size(bits)) == std::ssize(ones));
+      CHECK(index.select(std::ssize(ones)) == std::size(bits));
+   }
+}
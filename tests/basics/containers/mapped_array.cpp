@@ -0,0 +1,124 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/mapped_array.hpp>
+
+#include <filesystem>
+#include <numeric>
+#include <system_error>
+#include <vector>
+
+using namespace caramel;
+
+namespace
+{
+   struct point
+   {
+      float x;
+      float y;
+   };
+
+   auto temporary_path(const char* name) -> std::filesystem::path
+   {
+      return std::filesystem::temp_directory_path() / name;
+   }
+} // namespace
+
+TEST_SUITE("mapped_array test suite") // NOLINT
+{
+   TEST_CASE("create starts empty") // NOLINT
+   {
+      const auto path = temporary_path("caramel_mapped_array_empty.bin");
+      {
+         auto array = mapped_array<int>::create(path, 16);
+
+         CHECK(array.empty());
+         CHECK(array.size() == 0);
+         CHECK(array.capacity() == 16);
+         CHECK(array.is_writable());
+      }
+
+      std::filesystem::remove(path);
+   }
+   TEST_CASE("append grows past a page and persists") // NOLINT
+   {
+      const auto path = temporary_path("caramel_mapped_array_append.bin");
+      constexpr int count = 10'000;
+      {
+         auto array = mapped_array<int>::create(path);
+         for (int i = 0; i < count; ++i)
+         {
+            array.append(i);
+         }
+
+         CHECK(array.size() == count);
+         CHECK(array.capacity() >= count);
+         CHECK(array.lookup(count - 1) == count - 1);
+
+         array.flush();
+      }
+      {
+         const auto array = mapped_array<int>::open(path);
+
+         REQUIRE(array.size() == count);
+         CHECK_FALSE(array.is_writable());
+         CHECK(std::accumulate(array.begin(), array.end(), 0LL) ==
+               static_cast<long long>(count) * (count - 1) / 2);
+         CHECK(*array.rbegin() == count - 1);
+      }
+
+      std::filesystem::remove(path);
+   }
+   TEST_CASE("read_write reopen appends to the existing elements") // NOLINT
+   {
+      const auto path = temporary_path("caramel_mapped_array_reopen.bin");
+      {
+         auto array = mapped_array<point>::create(path);
+         array.append(point{1.0F, 2.0F});
+      }
+      {
+         auto array = mapped_array<point>::open(path, map_mode::read_write);
+         const std::vector<point> more{{3.0F, 4.0F}, {5.0F, 6.0F}};
+         array.append(more.begin(), more.end());
+         array.lookup(0).x = 7.0F; // NOLINT
+      }
+      {
+         const auto array = mapped_array<point>::open(path);
+
+         REQUIRE(array.size() == 3);
+         CHECK(array.lookup(0).x == 7.0F);
+         CHECK(array.lookup(2).y == 6.0F);
+      }
+
+      std::filesystem::remove(path);
+   }
+   TEST_CASE("resize and pop_back update the stored size") // NOLINT
+   {
+      const auto path = temporary_path("caramel_mapped_array_resize.bin");
+      {
+         auto array = mapped_array<int>::create(path);
+         array.resize(100);
+         array.pop_back();
+
+         CHECK(array.size() == 99);
+         CHECK(array.lookup(98) == 0);
+      }
+
+      CHECK(mapped_array<int>::open(path).size() == 99);
+
+      std::filesystem::remove(path);
+   }
+   TEST_CASE("open rejects files of another element type") // NOLINT
+   {
+      const auto path = temporary_path("caramel_mapped_array_type.bin");
+      {
+         auto array = mapped_array<int>::create(path);
+         array.append(1);
+      }
+
+      CHECK_THROWS_AS(mapped_array<double>::open(path), std::system_error);
+      CHECK_THROWS_AS(mapped_array<int>::open(temporary_path("caramel_mapped_array_missing.bin")),
+                      std::system_error);
+
+      std::filesystem::remove(path);
+   }
+}
@@ -0,0 +1,140 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/containers/small_string.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+using namespace caramel;
+
+TEST_SUITE("small_string test suite") // NOLINT
+{
+   TEST_CASE("default ctor") // NOLINT
+   {
+      small_string<16> str;
+
+      REQUIRE(std::empty(str));
+      REQUIRE(std::size(str) == 0);
+      REQUIRE(str.capacity() == 16);
+      REQUIRE(std::strlen(str.c_str()) == 0);
+      REQUIRE(str.allocator().resource() == get_default_memory_resource());
+   }
+
+   TEST_CASE("inline and heap storage") // NOLINT
+   {
+      small_string<8> str{"tag"};
+      const auto* p_inline = str.data();
+
+      CHECK(str == "tag");
+      CHECK(str.capacity() == 8);
+
+      str.append("-1234");
+      CHECK(str.data() == p_inline);
+      CHECK(str == "tag-1234");
+
+      str += std::string_view{"-and-some-more"};
+      CHECK(str.capacity() > 8);
+      CHECK(str == "tag-1234-and-some-more");
+      CHECK(std::ssize(std::string_view{str.c_str()}) == std::size(str));
+   }
+
+   TEST_CASE("append") // NOLINT
+   {
+      small_string<4> str;
+
+      str.append('a');
+      str.append(3, 'b');
+      str += "cd";
+      CHECK(str.view() == "abbbcd");
+
+      str.append(str.view());
+      CHECK(str.view() == "abbbcdabbbcd");
+
+      std::string_view suffix{"xyz"};
+      std::copy(std::begin(suffix), std::end(suffix), str.back_appender());
+      CHECK(str.view() == "abbbcdabbbcdxyz");
+   }
+
+   TEST_CASE("resize, pop_back and clear") // NOLINT
+   {
+      small_string<8> str{"hello"};
+
+      str.pop_back();
+      CHECK(str == "hell");
+
+      str.resize(6, '!'); // NOLINT
+      CHECK(str == "hell!!");
+
+      str.resize(2);
+      CHECK(str == "he");
+      CHECK(std::strlen(str.c_str()) == 2);
+
+      str.clear();
+      CHECK(std::empty(str));
+      CHECK(*str.c_str() == '\0');
+   }
+
+   TEST_CASE("copy and move") // NOLINT
+   {
+      small_string<4> small{"abc"};
+      small_string<4> large{"a string too large for the buffer"};
+
+      auto small_copy = small;
+      auto large_copy = large;
+      CHECK(small_copy == small);
+      CHECK(large_copy == large);
+
+      auto moved = std::move(large_copy);
+      CHECK(moved == large);
+      CHECK(std::empty(large_copy)); // NOLINT
+      CHECK(*large_copy.c_str() == '\0');
+
+      moved = std::move(small_copy);
+      CHECK(moved == small);
+      CHECK(std::empty(small_copy)); // NOLINT
+   }
+
+   TEST_CASE("strings in an array use its allocator") // NOLINT
+   {
+      checked_resource checked;
+
+      {
+         dynamic_array<small_string<4>> strings(memory_allocator<small_string<4>>{&checked});
+         strings.append("a string too large for the buffer");
+         strings.append(in_place, 8, 'a');
+         strings.insert(strings.begin(), small_string<4>{"another string too large"});
+
+         const i64_t live = checked.live_allocations();
+         CHECK(live == 4);
+
+         auto copy = strings;
+         CHECK(copy == strings);
+         CHECK(checked.live_allocations() == 2 * live);
+
+         strings.lookup(0) = small_string<4>{"assigned from the default resource"};
+         CHECK(strings.lookup(0).allocator().resource() == &checked);
+         CHECK(checked.live_allocations() == 2 * live);
+      }
+
+      CHECK(checked.live_allocations() == 0);
+   }
+
+   TEST_CASE("comparison and hashing") // NOLINT
+   {
+      small_string<8> apple{"apple"};
+      small_string<16> banana{"banana"};
+
+      CHECK(apple < banana);
+      CHECK(apple != banana);
+      CHECK(apple == std::string_view{"apple"});
+
+      std::unordered_set<small_string<8>> set;
+      set.insert(apple);
+      CHECK(set.contains(small_string<8>{"apple"}));
+   }
+}
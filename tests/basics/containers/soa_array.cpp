@@ -0,0 +1,280 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/containers/soa_array.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace caramel;
+using test::limited_resource;
+
+namespace
+{
+   /**
+    * Counts its live instances and throws once a budget of constructions is spent.
+    */
+   struct fragile
+   {
+      static inline int live = 0;                // NOLINT
+      static inline int constructions_left = -1; // NOLINT
+
+      int value;
+
+      fragile(int new_value) : value{new_value} { count(); }
+      fragile(const fragile& other) : value{other.value} { count(); }
+      fragile(fragile&& other) : value{other.value} { count(); } // NOLINT
+      ~fragile() { --live; }
+
+      auto operator=(const fragile&) -> fragile& = default;
+      auto operator=(fragile&&) -> fragile& = default; // NOLINT
+
+   private:
+      static void count()
+      {
+         if (constructions_left == 0)
+         {
+            throw std::runtime_error{"out of constructions"};
+         }
+
+         if (constructions_left > 0)
+         {
+            --constructions_left;
+         }
+
+         ++live;
+      }
+   };
+} // namespace
+
+using soa_iterator_traits = std::iterator_traits<soa_array<int, float>::iterator>;
+static_assert(
+   std::is_same_v<soa_iterator_traits::iterator_category, std::random_access_iterator_tag>);
+
+TEST_SUITE("soa_array test suite") // NOLINT
+{
+   TEST_CASE("default ctor") // NOLINT
+   {
+      soa_array<int, std::string> arr;
+
+      REQUIRE(std::empty(arr));
+      REQUIRE(std::size(arr) == 0);
+      REQUIRE(std::begin(arr) == std::end(arr));
+      REQUIRE(arr.allocator().resource() == get_default_memory_resource());
+   }
+
+   TEST_CASE("append and lookup") // NOLINT
+   {
+      soa_array<int, std::string, double> arr;
+
+      for (int i = 0; i < 100; ++i) // NOLINT
+      {
+         arr.append(in_place, i, std::to_string(i), i * 0.5); // NOLINT
+      }
+
+      arr.append({100, "100", 50.0}); // NOLINT
+
+      REQUIRE(std::size(arr) == 101);
+      CHECK(std::get<0>(arr.lookup(42)) == 42);
+      CHECK(std::get<1>(arr.lookup(42)) == "42");
+      CHECK(std::get<2>(arr.lookup(100)) == 50.0);
+
+      std::get<0>(arr.lookup(0)) = -1;
+      CHECK(arr.column<0>()[0] == -1);
+   }
+
+   TEST_CASE("columns are aligned and contiguous") // NOLINT
+   {
+      soa_array<std::uint8_t, double, int> arr;
+      arr.resize(37); // NOLINT
+
+      CHECK(reinterpret_cast<std::uintptr_t>(arr.data<0>()) % arr.column_alignment == 0); // NOLINT
+      CHECK(reinterpret_cast<std::uintptr_t>(arr.data<1>()) % arr.column_alignment == 0); // NOLINT
+      CHECK(reinterpret_cast<std::uintptr_t>(arr.data<2>()) % arr.column_alignment == 0); // NOLINT
+
+      auto ints = arr.column<2>();
+      REQUIRE(std::size(ints) == 37);
+      std::iota(std::begin(ints), std::end(ints), 0);
+
+      CHECK(std::accumulate(std::begin(ints), std::end(ints), 0) == 666);
+   }
+
+   TEST_CASE("iteration") // NOLINT
+   {
+      soa_array<int, int> arr;
+      for (int i = 0; i < 10; ++i) // NOLINT
+      {
+         arr.append(in_place, i, i * i);
+      }
+
+      int count = 0;
+      for (auto [value, square] : arr)
+      {
+         CHECK(square == value * value);
+         ++count;
+      }
+
+      CHECK(count == 10);
+      CHECK(std::get<0>(*std::rbegin(arr)) == 9);
+   }
+
+   TEST_CASE("erase, copy and move") // NOLINT
+   {
+      soa_array<int, std::string> arr;
+      arr.append(in_place, 1, "one");
+      arr.append(in_place, 2, "two");
+      arr.append(in_place, 3, "three");
+
+      arr.erase(arr.cbegin() + 1);
+      REQUIRE(std::size(arr) == 2);
+      CHECK(std::get<1>(arr.lookup(1)) == "three");
+
+      auto copy = arr;
+      CHECK(std::size(copy) == 2);
+      CHECK(std::get<1>(copy.lookup(0)) == "one");
+
+      auto moved = std::move(copy);
+      CHECK(std::size(moved) == 2);
+      CHECK(std::empty(copy)); // NOLINT
+
+      moved.pop_back();
+      moved.clear();
+      CHECK(std::empty(moved));
+   }
+   TEST_CASE("a failed growth throws and leaves the array unchanged") // NOLINT
+   {
+      limited_resource upstream{1024};
+      soa_array<int, double> arr{soa_array<int, double>::allocator_type{&upstream}};
+      for (int i = 0; i < 8; ++i)
+      {
+         arr.append({i, i * 0.5});
+      }
+
+      CHECK_THROWS_AS(arr.reserve(1000), std::bad_alloc);
+      CHECK(arr.size() == 8);
+      CHECK(arr.capacity() == 8);
+      CHECK(arr.lookup(7) == std::tuple{7, 3.5});
+   }
+   TEST_CASE("a throwing element leaves the columns consistent") // NOLINT
+   {
+      using array = soa_array<fragile, fragile>;
+
+      checked_resource checked;
+
+      {
+         array arr{array::allocator_type{&checked}};
+         arr.reserve(8);
+         for (int i = 0; i < 4; ++i)
+         {
+            arr.append(in_place, i, -i);
+         }
+
+         const int live = fragile::live;
+         const auto capacity = arr.capacity();
+
+         // Every time, the first column is built and the second one throws.
+         fragile::constructions_left = static_cast<int>(arr.size()) + 1;
+         CHECK_THROWS_AS(arr.reserve(capacity + 1), std::runtime_error);
+         CHECK(fragile::live == live);
+         CHECK(arr.capacity() == capacity);
+         CHECK(checked.live_allocations() == 1);
+
+         fragile::constructions_left = static_cast<int>(arr.size()) + 1;
+         CHECK_THROWS_AS(array{arr}, std::runtime_error);
+         CHECK(fragile::live == live);
+         CHECK(checked.live_allocations() == 1);
+
+         fragile::constructions_left = 1;
+         CHECK_THROWS_AS(arr.append(in_place, 4, -4), std::runtime_error);
+         CHECK(fragile::live == live);
+         CHECK(arr.size() == 4);
+
+         fragile::constructions_left = -1;
+         CHECK(std::get<0>(arr.lookup(3)).value == 3);
+         CHECK(std::get<1>(arr.lookup(3)).value == -3);
+      }
+
+      CHECK(fragile::live == 0);
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("assigned elements stay in the resource of the outer array") // NOLINT
+   {
+      using inner = soa_array<int, std::string>;
+
+      checked_resource checked;
+
+      const auto in_checked = [&](const auto& values) {
+         return std::ranges::all_of(values, [&](const auto& value) {
+            return value.allocator().resource() == &checked;
+         });
+      };
+      const auto make_inner = [](int number, const char* p_name) {
+         inner values;
+         values.append(in_place, number, p_name);
+
+         return values;
+      };
+      const auto make_outer = [&] {
+         dynamic_array<inner> outer(memory_allocator<inner>{&checked});
+         outer.append(in_place);
+         outer.append(in_place);
+         outer.lookup(0).append(in_place, 1, "one");
+
+         return outer;
+      };
+
+      {
+         SUBCASE("move assignment")
+         {
+            auto outer = make_outer();
+            inner other = make_inner(2, "two");
+            outer.lookup(0) = std::move(other);
+            outer.lookup(1) = make_inner(3, "three");
+
+            CHECK(outer.lookup(0).lookup(0) == std::tuple{2, "two"});
+            CHECK(outer.lookup(1).lookup(0) == std::tuple{3, "three"});
+            CHECK(std::empty(other)); // NOLINT
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("copy assignment")
+         {
+            auto outer = make_outer();
+            const inner other = make_inner(4, "four");
+            outer.lookup(1) = other;
+
+            CHECK(outer.lookup(1).lookup(0) == std::tuple{4, "four"});
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("swap")
+         {
+            auto outer = make_outer();
+            inner other = make_inner(5, "five");
+            std::swap(outer.lookup(0), other);
+
+            CHECK(outer.lookup(0).lookup(0) == std::tuple{5, "five"});
+            CHECK(other.lookup(0) == std::tuple{1, "one"});
+            CHECK(other.allocator().resource() == get_default_memory_resource());
+            CHECK(in_checked(outer));
+         }
+         SUBCASE("move construction with another allocator")
+         {
+            inner other = make_inner(6, "six");
+            const inner moved{std::move(other), inner::allocator_type{&checked}};
+
+            CHECK(moved.lookup(0) == std::tuple{6, "six"});
+            CHECK(moved.allocator().resource() == &checked);
+            CHECK(std::empty(other)); // NOLINT
+         }
+      }
+
+      CHECK(checked.live_allocations() == 0);
+   }
+}
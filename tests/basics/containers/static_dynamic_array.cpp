@@ -0,0 +1,121 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/static_dynamic_array.hpp>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using namespace caramel;
+
+static_assert(sizeof(static_dynamic_array<std::uint8_t, 15>) == 16);
+static_assert(std::is_same_v<detail::smallest_size_t<255>, std::uint8_t>);
+static_assert(std::is_same_v<detail::smallest_size_t<256>, std::uint16_t>);
+static_assert(std::is_same_v<detail::smallest_size_t<65536>, std::uint32_t>);
+static_assert(std::is_trivially_copyable_v<static_dynamic_array<int, 8>>);
+static_assert(std::is_trivially_destructible_v<static_dynamic_array<int, 8>>);
+static_assert(not std::is_trivially_copyable_v<static_dynamic_array<std::string, 8>>);
+
+constexpr auto make_constant_array() -> static_dynamic_array<int, 8>
+{
+   static_dynamic_array<int, 8> arr{1, 2, 4};
+   arr.insert(arr.cbegin() + 2, 3);
+   arr.append(5);
+   arr.erase(arr.cbegin());
+
+   return arr;
+}
+
+constexpr auto constant_array = make_constant_array();
+static_assert(constant_array.size() == 4);
+static_assert(constant_array.lookup(0) == 2);
+static_assert(constant_array.lookup(3) == 5);
+
+TEST_SUITE("static_dynamic_array test suite") // NOLINT
+{
+   TEST_CASE("default ctor") // NOLINT
+   {
+      static_dynamic_array<std::string, 4> arr;
+
+      REQUIRE(std::empty(arr));
+      REQUIRE(std::size(arr) == 0);
+      REQUIRE(arr.capacity() == 4);
+      REQUIRE(std::begin(arr) == std::end(arr));
+   }
+
+   TEST_CASE("append and pop_back") // NOLINT
+   {
+      static_dynamic_array<std::unique_ptr<int>, 3> arr;
+
+      arr.append(std::make_unique<int>(1));
+      arr.append(in_place, new int{2}); // NOLINT
+      arr.append(std::make_unique<int>(3));
+
+      REQUIRE(arr.full());
+      CHECK(*arr.lookup(0) == 1);
+      CHECK(*arr.lookup(1) == 2);
+      CHECK(*arr.lookup(2) == 3);
+
+      arr.pop_back();
+      CHECK(std::size(arr) == 2);
+      CHECK_FALSE(arr.full());
+   }
+
+   TEST_CASE("insert") // NOLINT
+   {
+      static_dynamic_array<std::string, 8> arr{"a", "d"};
+
+      arr.insert(arr.cbegin() + 1, {"b", "c"});
+      arr.insert(arr.cend(), 2, "e");
+      arr.insert(arr.cbegin(), arr.lookup(3));
+
+      REQUIRE(std::size(arr) == 7);
+      CHECK(arr == static_dynamic_array<std::string, 7>{"d", "a", "b", "c", "d", "e", "e"});
+   }
+
+   TEST_CASE("erase") // NOLINT
+   {
+      static_dynamic_array<std::string, 8> arr{"a", "b", "c", "d", "e"};
+
+      arr.erase(arr.cbegin() + 1, arr.cbegin() + 3);
+      CHECK(arr == static_dynamic_array<std::string, 3>{"a", "d", "e"});
+
+      arr.erase(arr.cbegin());
+      CHECK(arr == static_dynamic_array<std::string, 2>{"d", "e"});
+   }
+
+   TEST_CASE("copy and move") // NOLINT
+   {
+      static_dynamic_array<std::string, 4> arr{"hello", "world"};
+
+      auto copy = arr;
+      CHECK(copy == arr);
+
+      auto moved = std::move(copy);
+      CHECK(moved == arr);
+
+      static_dynamic_array<std::string, 4> other{"a", "b", "c"};
+      other = arr;
+      CHECK(other == arr);
+
+      other = static_dynamic_array<std::string, 4>{"z"};
+      CHECK(std::size(other) == 1);
+      CHECK(arr < other);
+   }
+
+   TEST_CASE("resize") // NOLINT
+   {
+      static_dynamic_array<int, 16> arr;
+
+      arr.resize(4, 7); // NOLINT
+      CHECK(std::size(arr) == 4);
+      CHECK(arr.lookup(3) == 7);
+
+      arr.resize(2);
+      CHECK(std::size(arr) == 2);
+
+      arr.resize(16); // NOLINT
+      CHECK(arr.full());
+      CHECK(arr.lookup(15) == 0);
+   }
+}
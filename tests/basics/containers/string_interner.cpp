@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/containers/string_interner.hpp>
+
+#include <new>
+#include <string>
+
+using namespace caramel;
+using test::limited_resource;
+
+TEST_SUITE("string_interner test suite") // NOLINT
+{
+   TEST_CASE("interning the same string returns the same symbol") // NOLINT
+   {
+      string_interner interner;
+
+      const symbol_t hello = interner.intern("hello");
+      const symbol_t world = interner.intern("world");
+
+      CHECK(hello != world);
+      CHECK(interner.intern("hello") == hello);
+      CHECK(interner.intern(std::string{"world"}) == world);
+      CHECK(interner.size() == 2);
+   }
+   TEST_CASE("lookup returns the stored characters") // NOLINT
+   {
+      string_interner interner;
+
+      const symbol_t empty = interner.intern("");
+      const symbol_t longer = interner.intern("a string longer than a single word");
+
+      CHECK(interner.lookup(empty).empty());
+      CHECK(interner.lookup(longer) == "a string longer than a single word");
+      CHECK(interner.lookup(longer).data()[interner.lookup(longer).size()] == '\0'); // NOLINT
+   }
+   TEST_CASE("find does not insert") // NOLINT
+   {
+      string_interner interner;
+      interner.intern("present");
+
+      CHECK(interner.contains("present"));
+      CHECK_FALSE(interner.find("absent").has_value());
+      CHECK(interner.size() == 1);
+   }
+   TEST_CASE("symbols stay valid while the table grows") // NOLINT
+   {
+      string_interner interner;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+         REQUIRE(interner.intern(std::to_string(i)).value() == static_cast<u32_t>(i));
+      }
+
+      CHECK(interner.size() == 1000);
+      for (int i = 0; i < 1000; ++i)
+      {
+         const auto symbol = interner.find(std::to_string(i));
+
+         REQUIRE(symbol.has_value());
+         CHECK(interner.lookup(*symbol) == std::to_string(i));
+      }
+   }
+   TEST_CASE("a failed allocation throws and leaves the interner usable") // NOLINT
+   {
+      limited_resource upstream{2048};
+      string_interner interner{&upstream};
+
+      const symbol_t first = interner.intern("first");
+
+      CHECK_THROWS_AS(interner.intern(std::string(4096, 'a')), std::bad_alloc);
+      CHECK(interner.size() == 1);
+      CHECK_FALSE(interner.find(std::string(4096, 'a')).has_value());
+
+      CHECK(interner.intern("first") == first);
+      CHECK(interner.lookup(interner.intern("second")) == "second");
+   }
+   TEST_CASE("a failed table growth keeps the current table") // NOLINT
+   {
+      limited_resource upstream{2048};
+      string_interner interner{&upstream};
+
+      for (int i = 0; i < 64; ++i)
+      {
+         interner.intern(std::to_string(i));
+      }
+
+      // The next symbol grows the table from 128 to 256 slots of 8 bytes.
+      upstream.limit = 1024;
+      CHECK_THROWS_AS(interner.intern("64"), std::bad_alloc);
+      CHECK(interner.size() == 64);
+
+      for (int i = 0; i < 64; ++i)
+      {
+         const auto symbol = interner.find(std::to_string(i));
+
+         REQUIRE(symbol.has_value());
+         CHECK(symbol->value() == static_cast<u32_t>(i));
+      }
+      CHECK_FALSE(interner.find("64").has_value());
+
+      upstream.limit = 4096;
+      CHECK(interner.lookup(interner.intern("64")) == "64");
+   }
+}
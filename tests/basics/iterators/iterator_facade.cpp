@@ -178,4 +178,23 @@ TEST_SUITE("iterator_facade test suite") // NOLINT
       CHECK_FALSE(it == stop);
       CHECK_FALSE(stop == it);
    }
+
+   TEST_CASE("Contiguous iterator") // NOLINT
+   {
+      static_assert(std::contiguous_iterator<random_access_iterator<int>>);
+      static_assert(std::contiguous_iterator<random_access_iterator<const int>>);
+      static_assert(std::random_access_iterator<iota_iterator>);
+      static_assert(not std::contiguous_iterator<iota_iterator>);
+      static_assert(
+         std::is_same_v<std::iterator_traits<random_access_iterator<int>>::iterator_category,
+                        std::random_access_iterator_tag>);
+
+      std::vector<int> values{1, 2, 3};
+      random_access_iterator<int> first{values.data()};
+      random_access_iterator<int> last{values.data() + values.size()};
+
+      CHECK(std::to_address(first) == values.data());
+      CHECK(std::to_address(last) == values.data() + values.size());
+      CHECK(std::to_address(random_access_iterator<int>{}) == nullptr);
+   }
 }
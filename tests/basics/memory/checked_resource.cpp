@@ -0,0 +1,158 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+#include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace caramel;
+
+namespace
+{
+   struct error_log
+   {
+      std::vector<memory_error> errors;
+
+      auto handler() -> memory_error_handler
+      {
+         return [this](const memory_error_info& info) {
+            errors.push_back(info.error);
+         };
+      }
+   };
+} // namespace
+
+TEST_SUITE("checked_resource test suite") // NOLINT
+{
+   TEST_CASE("matching deallocations report nothing") // NOLINT
+   {
+      error_log log;
+      global_resource upstream;
+
+      {
+         checked_resource checked{gsl::make_not_null(&upstream), {}, log.handler()};
+
+         void* ptr = checked.allocate(count_t{100}, align_t{64});
+         REQUIRE(ptr != nullptr);
+         CHECK(reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0); // NOLINT
+         CHECK(checked.live_allocations() == 1);
+         CHECK(checked.live_bytes() == 100);
+
+         checked.deallocate(gsl::make_not_null(ptr), count_t{100}, align_t{64});
+         CHECK(checked.live_allocations() == 0);
+      }
+
+      CHECK(log.errors.empty());
+   }
+   TEST_CASE("size and alignment mismatches are reported") // NOLINT
+   {
+      error_log log;
+      global_resource upstream;
+      checked_resource checked{gsl::make_not_null(&upstream), {}, log.handler()};
+
+      void* ptr = checked.allocate(count_t{32}, align_t{16});
+      checked.deallocate(gsl::make_not_null(ptr), count_t{16}, align_t{8});
+
+      REQUIRE(log.errors.size() == 2);
+      CHECK(log.errors[0] == memory_error::size_mismatch);
+      CHECK(log.errors[1] == memory_error::alignment_mismatch);
+      CHECK(checked.live_allocations() == 0);
+   }
+   TEST_CASE("overflows are caught by the canary") // NOLINT
+   {
+      error_log log;
+      global_resource upstream;
+      checked_resource checked{gsl::make_not_null(&upstream), {}, log.handler()};
+
+      auto* p_bytes = static_cast<char*>(checked.allocate(count_t{10}, align_t{1}));
+      p_bytes[10] = 'x'; // NOLINT
+      checked.deallocate(gsl::make_not_null(static_cast<void*>(p_bytes)), count_t{10},
+                         align_t{1});
+
+      REQUIRE(log.errors.size() == 1);
+      CHECK(log.errors[0] == memory_error::buffer_overflow);
+   }
+   TEST_CASE("double frees and writes after free are caught in quarantine") // NOLINT
+   {
+      error_log log;
+      global_resource upstream;
+
+      {
+         checked_resource checked{gsl::make_not_null(&upstream),
+                                  {.poison_freed = true, .quarantine_bytes = 1024},
+                                  log.handler()};
+
+         auto* p_bytes = static_cast<char*>(checked.allocate(count_t{16}, align_t{8}));
+         checked.deallocate(gsl::make_not_null(static_cast<void*>(p_bytes)), count_t{16},
+                            align_t{8});
+         checked.deallocate(gsl::make_not_null(static_cast<void*>(p_bytes)), count_t{16},
+                            align_t{8});
+
+         REQUIRE(log.errors.size() == 1);
+         CHECK(log.errors[0] == memory_error::double_free);
+
+         p_bytes[3] = 'x'; // NOLINT
+      }
+
+      REQUIRE(log.errors.size() == 2);
+      CHECK(log.errors[1] == memory_error::use_after_free);
+   }
+   TEST_CASE("empty blocks count towards the quarantine size") // NOLINT
+   {
+      checked_resource upstream;
+
+      {
+         checked_resource checked{gsl::make_not_null(&upstream),
+                                  {.poison_freed = true, .quarantine_bytes = 64}};
+
+         for (int i = 0; i < 1000; ++i)
+         {
+            void* p_empty = checked.allocate(count_t{0}, align_t{8});
+            checked.deallocate(gsl::make_not_null(p_empty), count_t{0}, align_t{8});
+         }
+
+         // A header and a canary already take more than half of the quarantine.
+         CHECK(upstream.live_allocations() == 1);
+      }
+
+      CHECK(upstream.live_allocations() == 0);
+   }
+   TEST_CASE("invalid pointers are not returned upstream") // NOLINT
+   {
+      error_log log;
+      global_resource upstream;
+      checked_resource checked{gsl::make_not_null(&upstream), {}, log.handler()};
+
+      alignas(16) std::array<std::byte, 128> buffer{};
+      checked.deallocate(gsl::make_not_null(static_cast<void*>(buffer.data() + 64)), count_t{8},
+                         align_t{8});
+
+      REQUIRE(log.errors.size() == 1);
+      CHECK(log.errors[0] == memory_error::invalid_pointer);
+   }
+   TEST_CASE("leaks are reported on destruction") // NOLINT
+   {
+      error_log log;
+      monotonic_resource upstream;
+      void* p_leaked = nullptr;
+
+      {
+         checked_resource checked{gsl::make_not_null(&upstream), {}, log.handler()};
+         p_leaked = checked.allocate(count_t{8}, align_t{8});
+         checked.allocate(count_t{0}, align_t{8});
+
+         basic_dynamic_array<int, 0> values{memory_allocator<int>{&checked}};
+         values.append(1);
+      }
+
+      CHECK(log.errors.size() == 2);
+      CHECK(log.errors[0] == memory_error::leak);
+
+      CHECK(p_leaked != nullptr);
+   }
+}
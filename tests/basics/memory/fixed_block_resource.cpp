@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/fixed_block_resource.hpp>
+
+#include <cstdint>
+
+using namespace caramel;
+using test::counting_resource;
+
+TEST_SUITE("fixed_block_resource test suite") // NOLINT
+{
+   TEST_CASE("blocks hold a free list link and stay aligned") // NOLINT
+   {
+      const fixed_block_resource tiny{count_t{1}, align_t{1}};
+      const fixed_block_resource odd{count_t{20}, align_t{16}};
+
+      CHECK(tiny.block_size() == static_cast<i64_t>(sizeof(void*)));
+      CHECK(tiny.block_alignment() == static_cast<i64_t>(alignof(void*)));
+      CHECK(odd.block_size() == 32);
+      CHECK(odd.block_alignment() == 16);
+   }
+   TEST_CASE("blocks are carved from slabs") // NOLINT
+   {
+      counting_resource upstream;
+
+      {
+         fixed_block_resource pool{count_t{32}, align_t{16}, &upstream, count_t{4}};
+
+         dynamic_array<void*> blocks;
+         for (i32_t i = 0; i < 12; ++i)
+         {
+            void* p_block = pool.allocate(count_t{32}, align_t{16});
+
+            REQUIRE(p_block != nullptr);
+            CHECK(reinterpret_cast<std::uintptr_t>(p_block) % 16 == 0); // NOLINT
+
+            blocks.append(p_block);
+         }
+
+         // slabs of 4 then 8 blocks
+         CHECK(upstream.allocations == 2);
+
+         for (void* p_block : blocks)
+         {
+            pool.deallocate(gsl::make_not_null(p_block), count_t{32}, align_t{16});
+         }
+
+         CHECK(upstream.deallocations == 0);
+      }
+
+      CHECK(upstream.deallocations == 2);
+   }
+   TEST_CASE("freed blocks are handed out again first") // NOLINT
+   {
+      counting_resource upstream;
+      fixed_block_resource pool{count_t{24}, align_t{8}, &upstream};
+
+      void* p_first = pool.allocate(count_t{24}, align_t{8});
+      void* p_second = pool.allocate(count_t{24}, align_t{8});
+
+      pool.deallocate(gsl::make_not_null(p_first), count_t{24}, align_t{8});
+      pool.deallocate(gsl::make_not_null(p_second), count_t{24}, align_t{8});
+
+      CHECK(pool.allocate(count_t{24}, align_t{8}) == p_second);
+      CHECK(pool.allocate(count_t{24}, align_t{8}) == p_first);
+      CHECK(upstream.allocations == 1);
+   }
+   TEST_CASE("requests that do not fit a block go upstream") // NOLINT
+   {
+      counting_resource upstream;
+      fixed_block_resource pool{count_t{16}, align_t{8}, &upstream};
+
+      void* p_large = pool.allocate(count_t{64}, align_t{8});
+      void* p_aligned = pool.allocate(count_t{8}, align_t{64});
+
+      CHECK(upstream.allocations == 2);
+      CHECK(reinterpret_cast<std::uintptr_t>(p_aligned) % 64 == 0); // NOLINT
+
+      pool.deallocate(gsl::make_not_null(p_large), count_t{64}, align_t{8});
+      pool.deallocate(gsl::make_not_null(p_aligned), count_t{8}, align_t{64});
+
+      CHECK(upstream.deallocations == 2);
+   }
+   TEST_CASE("release returns every slab") // NOLINT
+   {
+      counting_resource upstream;
+      fixed_block_resource pool{count_t{8}, align_t{8}, &upstream, count_t{1}};
+
+      for (i32_t i = 0; i < 7; ++i)
+      {
+         CHECK(pool.allocate(count_t{8}, align_t{8}) != nullptr);
+      }
+
+      CHECK(upstream.allocations == 3);
+
+      pool.release();
+      CHECK(upstream.deallocations == 3);
+
+      CHECK(pool.allocate(count_t{8}, align_t{8}) != nullptr);
+      CHECK(upstream.allocations == 4);
+   }
+}
@@ -0,0 +1,114 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/checked_resource.hpp>
+#include <libcaramel/memory/inline_resource.hpp>
+
+#include <cstdint>
+
+using namespace caramel;
+using test::counting_resource;
+
+TEST_SUITE("inline_resource test suite") // NOLINT
+{
+   TEST_CASE("allocations fitting in the buffer never reach upstream") // NOLINT
+   {
+      counting_resource upstream;
+      inline_resource<256> resource{&upstream};
+
+      void* p_first = resource.allocate(count_t{3}, align_t{1});
+      void* p_second = resource.allocate(count_t{16}, align_t{16});
+
+      CHECK(reinterpret_cast<std::uintptr_t>(p_second) % 16 == 0); // NOLINT
+      CHECK(p_first != p_second);
+      CHECK(resource.used() == 32);
+      CHECK(upstream.allocations == 0);
+
+      resource.deallocate(gsl::make_not_null(p_first), count_t{3}, align_t{1});
+      resource.deallocate(gsl::make_not_null(p_second), count_t{16}, align_t{16});
+
+      CHECK(upstream.deallocations == 0);
+   }
+   TEST_CASE("the latest allocation gives its bytes back") // NOLINT
+   {
+      counting_resource upstream;
+      inline_resource<256> resource{&upstream};
+
+      void* p_first = resource.allocate(count_t{64}, align_t{8});
+      void* p_second = resource.allocate(count_t{64}, align_t{8});
+
+      resource.deallocate(gsl::make_not_null(p_second), count_t{64}, align_t{8});
+      CHECK(resource.used() == 64);
+
+      CHECK(resource.allocate(count_t{64}, align_t{8}) == p_second);
+
+      resource.deallocate(gsl::make_not_null(p_first), count_t{64}, align_t{8});
+      CHECK(resource.used() == 128);
+   }
+   TEST_CASE("an exhausted buffer falls back to upstream") // NOLINT
+   {
+      counting_resource upstream;
+      inline_resource<64> resource{&upstream};
+
+      void* p_inline = resource.allocate(count_t{48}, align_t{8});
+      void* p_upstream = resource.allocate(count_t{32}, align_t{8});
+
+      CHECK(upstream.allocations == 1);
+
+      resource.deallocate(gsl::make_not_null(p_upstream), count_t{32}, align_t{8});
+      CHECK(upstream.deallocations == 1);
+
+      resource.deallocate(gsl::make_not_null(p_inline), count_t{48}, align_t{8});
+      CHECK(resource.used() == 0);
+      CHECK(upstream.deallocations == 1);
+   }
+   TEST_CASE("empty allocations from a full buffer go upstream") // NOLINT
+   {
+      checked_resource upstream;
+
+      {
+         inline_resource<64> resource{&upstream};
+
+         void* p_full = resource.allocate(count_t{64}, align_t{8});
+         void* p_empty = resource.allocate(count_t{0}, align_t{8});
+         void* p_padded = resource.allocate(count_t{0}, align_t{64});
+
+         CHECK(resource.used() == 64);
+         CHECK(upstream.live_allocations() == 2);
+
+         resource.deallocate(gsl::make_not_null(p_padded), count_t{0}, align_t{64});
+         resource.deallocate(gsl::make_not_null(p_empty), count_t{0}, align_t{8});
+         resource.deallocate(gsl::make_not_null(p_full), count_t{64}, align_t{8});
+
+         CHECK(resource.used() == 0);
+      }
+
+      CHECK(upstream.live_allocations() == 0);
+   }
+   TEST_CASE("temporary arrays share the buffer") // NOLINT
+   {
+      counting_resource upstream;
+      inline_resource<4096> resource{&upstream};
+
+      dynamic_array<i32_t> evens{memory_allocator<i32_t>{&resource}};
+      dynamic_array<i32_t> odds{memory_allocator<i32_t>{&resource}};
+      for (i32_t i = 0; i < 100; ++i)
+      {
+         (i % 2 == 0 ? evens : odds).append(i);
+      }
+
+      CHECK(evens.size() == 50);
+      CHECK(odds.lookup(49) == 99);
+      CHECK(upstream.allocations == 0);
+
+      for (i32_t i = 0; i < 10'000; ++i)
+      {
+         evens.append(i);
+      }
+
+      CHECK(upstream.allocations > 0);
+      CHECK(odds.lookup(0) == 1);
+   }
+}
@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/memory/monotonic_resource.hpp>
+
+#include <cstdint>
+
+using namespace caramel;
+using test::counting_resource;
+
+TEST_SUITE("monotonic_resource test suite") // NOLINT
+{
+   TEST_CASE("small allocations share a chunk") // NOLINT
+   {
+      counting_resource upstream;
+      monotonic_resource arena{gsl::make_not_null(&upstream), count_t{256}};
+
+      for (int i = 0; i < 16; ++i)
+      {
+         void* ptr = arena.allocate(count_t{8}, align_t{8});
+         REQUIRE(ptr != nullptr);
+         CHECK(reinterpret_cast<std::uintptr_t>(ptr) % 8 == 0); // NOLINT
+      }
+
+      CHECK(upstream.allocations == 1);
+   }
+   TEST_CASE("alignment is respected") // NOLINT
+   {
+      monotonic_resource arena;
+
+      [[maybe_unused]] void* p_byte = arena.allocate(count_t{1}, align_t{1});
+      void* p_aligned = arena.allocate(count_t{64}, align_t{64});
+
+      CHECK(reinterpret_cast<std::uintptr_t>(p_aligned) % 64 == 0); // NOLINT
+   }
+   TEST_CASE("large allocations acquire a dedicated chunk") // NOLINT
+   {
+      counting_resource upstream;
+      monotonic_resource arena{gsl::make_not_null(&upstream), count_t{64}};
+
+      REQUIRE(arena.allocate(count_t{4096}, align_t{16}) != nullptr);
+      REQUIRE(arena.allocate(count_t{16}, align_t{16}) != nullptr);
+
+      CHECK(upstream.allocations == 2);
+   }
+   TEST_CASE("release returns every chunk upstream") // NOLINT
+   {
+      counting_resource upstream;
+
+      {
+         monotonic_resource arena{gsl::make_not_null(&upstream), count_t{32}};
+         for (int i = 0; i < 64; ++i)
+         {
+            arena.allocate(count_t{16}, align_t{8});
+         }
+
+         arena.release();
+         CHECK(upstream.allocations == upstream.deallocations);
+
+         arena.allocate(count_t{16}, align_t{8});
+      }
+
+      CHECK(upstream.allocations == upstream.deallocations);
+   }
+}
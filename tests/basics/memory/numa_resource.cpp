@@ -0,0 +1,82 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/numa_resource.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+using namespace caramel;
+
+TEST_SUITE("numa_resource test suite") // NOLINT
+{
+   TEST_CASE("the topology is consistent") // NOLINT
+   {
+      CHECK(numa_node_count() >= 1);
+      CHECK(current_numa_node() >= 0);
+      CHECK(current_numa_node() < numa_node_count());
+   }
+   TEST_CASE("every policy hands out usable memory") // NOLINT
+   {
+      for (const numa_policy policy :
+           {numa_policy::local, numa_policy::bind, numa_policy::interleave})
+      {
+         numa_resource resource{policy, numa_node_count() - 1};
+
+         CHECK(resource.policy() == policy);
+         CHECK(resource.node() == numa_node_count() - 1);
+
+         for (const i64_t bytes : {i64_t{0}, i64_t{1}, i64_t{4096}, i64_t{1 << 20}})
+         {
+            auto* p_bytes =
+               static_cast<std::byte*>(resource.allocate(count_t{bytes}, align_t{64}));
+
+            REQUIRE(p_bytes != nullptr);
+            CHECK(reinterpret_cast<std::uintptr_t>(p_bytes) % 64 == 0); // NOLINT
+
+            std::memset(p_bytes, 0xAB, static_cast<std::size_t>(bytes)); // NOLINT
+
+            resource.deallocate(gsl::make_not_null(static_cast<void*>(p_bytes)), count_t{bytes},
+                                align_t{64});
+         }
+      }
+   }
+   TEST_CASE("the default policy is local") // NOLINT
+   {
+      const numa_resource resource;
+
+      CHECK(resource.policy() == numa_policy::local);
+      CHECK(resource.node() == 0);
+   }
+   TEST_CASE("all numa_resources compare equal") // NOLINT
+   {
+      const numa_resource local;
+      const numa_resource interleaved{numa_policy::interleave};
+      const global_resource global;
+
+      CHECK(local.is_equal(interleaved));
+      CHECK(interleaved.is_equal(local));
+      CHECK_FALSE(local.is_equal(global));
+   }
+   TEST_CASE("arrays can live in an arena over a numa_resource") // NOLINT
+   {
+      numa_resource upstream{numa_policy::interleave};
+      monotonic_resource arena{&upstream};
+
+      dynamic_array<i64_t> values{memory_allocator<i64_t>{&arena}};
+      for (i64_t i = 0; i < 10'000; ++i)
+      {
+         values.append(i);
+      }
+
+      i64_t sum = 0;
+      for (const i64_t value : values)
+      {
+         sum += value;
+      }
+
+      CHECK(sum == 49'995'000);
+   }
+}
@@ -0,0 +1,93 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/object_pool.hpp>
+
+#include <stdexcept>
+
+using namespace caramel;
+
+namespace
+{
+   struct node
+   {
+      node(i32_t value, node* p_next) : value{value}, p_next{p_next} { ++live; }
+      node(const node&) = delete;
+      node(node&&) = delete;
+      ~node() { --live; }
+
+      auto operator=(const node&) -> node& = delete;
+      auto operator=(node&&) -> node& = delete;
+
+      static inline i32_t live = 0; // NOLINT
+
+      i32_t value;  // NOLINT
+      node* p_next; // NOLINT
+   };
+
+   struct throwing
+   {
+      throwing() { throw std::runtime_error{"construction failed"}; }
+   };
+} // namespace
+
+TEST_SUITE("object_pool test suite") // NOLINT
+{
+   TEST_CASE("objects are constructed and destroyed in place") // NOLINT
+   {
+      object_pool<node> pool;
+
+      node* p_head = nullptr;
+      for (i32_t i = 0; i < 100; ++i)
+      {
+         p_head = pool.construct(i, p_head);
+      }
+
+      CHECK(node::live == 100);
+
+      i32_t sum = 0;
+      for (node* p_node = p_head; p_node != nullptr; p_node = p_node->p_next)
+      {
+         sum += p_node->value;
+      }
+
+      CHECK(sum == 4950);
+
+      while (p_head)
+      {
+         node* p_next = p_head->p_next;
+         pool.destroy(gsl::make_not_null(p_head));
+         p_head = p_next;
+      }
+
+      CHECK(node::live == 0);
+   }
+   TEST_CASE("destroyed objects leave their block to the next one") // NOLINT
+   {
+      object_pool<node> pool;
+
+      node* p_first = pool.construct(1, nullptr);
+      pool.destroy(gsl::make_not_null(p_first));
+
+      node* p_second = pool.construct(2, nullptr);
+      CHECK(p_second == p_first);
+      CHECK(p_second->value == 2);
+
+      pool.destroy(gsl::make_not_null(p_second));
+   }
+   TEST_CASE("a throwing constructor gives its block back") // NOLINT
+   {
+      global_resource upstream;
+      object_pool<throwing> pool{&upstream, count_t{1}};
+
+      void* p_block = pool.resource().allocate(count_t{sizeof(throwing)},
+                                               align_t{alignof(throwing)});
+      pool.resource().deallocate(gsl::make_not_null(p_block), count_t{sizeof(throwing)},
+                                 align_t{alignof(throwing)});
+
+      CHECK_THROWS_AS(pool.construct(), std::runtime_error);
+
+      CHECK(pool.resource().allocate(count_t{sizeof(throwing)}, align_t{alignof(throwing)}) ==
+            p_block);
+   }
+}
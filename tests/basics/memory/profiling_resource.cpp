@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/profiling_resource.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace caramel;
+
+namespace
+{
+   auto allocate_blocks(memory_resource& resource, int count) -> dynamic_array<void*>
+   {
+      dynamic_array<void*> blocks;
+      for (int i = 0; i < count; ++i)
+      {
+         blocks.append(resource.allocate(count_t{64}, align_t{8}));
+      }
+
+      return blocks;
+   }
+} // namespace
+
+TEST_SUITE("profiling_resource test suite") // NOLINT
+{
+   TEST_CASE("an interval of one samples every allocation") // NOLINT
+   {
+      global_resource upstream;
+      profiling_resource profiler{gsl::make_not_null(&upstream), count_t{1}};
+
+      auto blocks = allocate_blocks(profiler, 10);
+
+      CHECK(profiler.sample_count() == 10);
+      CHECK(profiler.estimated_total(profile_metric::allocated_objects) == 10.0);
+      CHECK(profiler.estimated_total(profile_metric::in_use_bytes) == 640.0);
+
+      for (void* p_block : blocks)
+      {
+         profiler.deallocate(gsl::make_not_null(p_block), count_t{64}, align_t{8});
+      }
+
+      CHECK(profiler.estimated_total(profile_metric::in_use_objects) == 0.0);
+      CHECK(profiler.estimated_total(profile_metric::allocated_bytes) == 640.0);
+   }
+   TEST_CASE("sampling estimates the allocated bytes") // NOLINT
+   {
+      global_resource upstream;
+      profiling_resource profiler{gsl::make_not_null(&upstream), count_t{1024}};
+
+      const int count = 4096;
+      auto blocks = allocate_blocks(profiler, count);
+
+      CHECK(profiler.sample_count() > 0);
+      CHECK(profiler.sample_count() < count);
+
+      const double estimate = profiler.estimated_total(profile_metric::allocated_bytes);
+      CHECK(estimate > 64.0 * count * 0.5);
+      CHECK(estimate < 64.0 * count * 1.5);
+
+      for (void* p_block : blocks)
+      {
+         profiler.deallocate(gsl::make_not_null(p_block), count_t{64}, align_t{8});
+      }
+   }
+   TEST_CASE("profiles can wrap the default resource") // NOLINT
+   {
+      memory_resource* p_previous = get_default_memory_resource();
+      profiling_resource profiler{gsl::make_not_null(p_previous), count_t{1}};
+      set_default_memory_resource(gsl::make_not_null(&profiler));
+
+      {
+         dynamic_array<int> values;
+         for (int i = 0; i < 100; ++i)
+         {
+            values.append(i);
+         }
+
+         CHECK(profiler.sample_count() > 0);
+         CHECK(profiler.estimated_total(profile_metric::in_use_bytes) >= 400.0);
+      }
+
+      set_default_memory_resource(gsl::make_not_null(p_previous));
+
+      CHECK(profiler.estimated_total(profile_metric::in_use_bytes) == 0.0);
+
+      std::ostringstream folded;
+      profiler.write_folded(folded, profile_metric::allocated_objects);
+      CHECK_FALSE(folded.str().empty());
+
+      std::ostringstream pprof;
+      profiler.write_pprof(pprof);
+      CHECK(pprof.str().starts_with("heap profile: 0: 0 ["));
+      CHECK(pprof.str().find("@ heap_v2/1") != std::string::npos);
+   }
+}
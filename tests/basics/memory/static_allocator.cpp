@@ -0,0 +1,112 @@
+#include <doctest/doctest.h>
+
+#include <test_resources.hpp>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/memory/monotonic_resource.hpp>
+#include <libcaramel/memory/static_allocator.hpp>
+
+#include <type_traits>
+
+using namespace caramel;
+using test::counting_resource;
+
+namespace
+{
+   struct counting_tag
+   {
+   };
+   struct nested_tag
+   {
+   };
+
+   using counting_binding = static_resource<counting_resource, counting_tag>;
+
+   template <typename Any>
+   using counting_allocator = static_allocator<Any, counting_binding>;
+} // namespace
+
+TEST_SUITE("static_allocator test suite") // NOLINT
+{
+   TEST_CASE("the allocator is stateless") // NOLINT
+   {
+      CHECK(std::is_empty_v<static_allocator<i32_t, monotonic_resource>>);
+      CHECK(sizeof(basic_dynamic_array<i32_t, 0, static_allocator<i32_t, monotonic_resource>>) <
+            sizeof(basic_dynamic_array<i32_t, 0>));
+
+      const static_allocator<i32_t, monotonic_resource> ints;
+      const static_allocator<double, monotonic_resource> doubles{ints};
+
+      CHECK(ints == static_allocator<i32_t, monotonic_resource>{doubles});
+      CHECK(ints.resource() == doubles.resource());
+      CHECK(ints.resource() == &static_resource<monotonic_resource>::resource());
+   }
+   TEST_CASE("tags give distinct instances") // NOLINT
+   {
+      CHECK(&static_resource<counting_resource, counting_tag>::resource() !=
+            &static_resource<counting_resource, nested_tag>::resource());
+      CHECK(&static_resource<counting_resource>::resource() ==
+            static_allocator<i32_t, counting_resource>::resource());
+   }
+   TEST_CASE("arrays draw from the bound resource") // NOLINT
+   {
+      counting_resource& resource = counting_binding::resource();
+      const int allocations = resource.allocations;
+
+      {
+         basic_dynamic_array<i32_t, 0, counting_allocator<i32_t>> values;
+         for (i32_t i = 0; i < 100; ++i)
+         {
+            values.append(i);
+         }
+
+         CHECK(values.size() == 100);
+         CHECK(values.lookup(99) == 99);
+         CHECK(resource.allocations > allocations);
+
+         auto copy = values;
+         CHECK(copy == values);
+
+         decltype(values) moved{std::move(copy)};
+         CHECK(moved == values);
+      }
+
+      CHECK(resource.allocations == resource.deallocations);
+   }
+   TEST_CASE("nested arrays share the bound resource") // NOLINT
+   {
+      using inner = basic_dynamic_array<i32_t, 0, counting_allocator<i32_t>>;
+
+      counting_resource& resource = counting_binding::resource();
+
+      {
+         basic_dynamic_array<inner, 0, counting_allocator<inner>> outer;
+         for (i32_t i = 0; i < 10; ++i)
+         {
+            outer.append(in_place, i64_t{4}, i);
+         }
+
+         CHECK(outer.size() == 10);
+         CHECK(outer.lookup(9).size() == 4);
+         CHECK(outer.lookup(9).lookup(3) == 9);
+      }
+
+      CHECK(resource.allocations == resource.deallocations);
+   }
+   TEST_CASE("arrays bump allocate from a static monotonic_resource") // NOLINT
+   {
+      using allocator = static_allocator<i64_t, static_resource<monotonic_resource, nested_tag>>;
+
+      {
+         basic_dynamic_array<i64_t, 0, allocator> values;
+         for (i64_t i = 0; i < 1000; ++i)
+         {
+            values.append(i);
+         }
+
+         CHECK(values.lookup(999) == 999);
+      }
+
+      allocator::resource()->release();
+   }
+}
@@ -0,0 +1,104 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/serialization/binary.hpp>
+
+#include <system_error>
+
+using namespace caramel;
+
+namespace
+{
+   struct particle
+   {
+      float position[3]; // NOLINT
+      i32_t id;
+   };
+
+   auto bytes_of(const dynamic_array<std::byte>& buffer) -> std::span<const std::byte>
+   {
+      return {buffer.data(), static_cast<std::size_t>(buffer.size())};
+   }
+} // namespace
+
+TEST_SUITE("binary serialization test suite") // NOLINT
+{
+   TEST_CASE("arrays of trivially copyable elements round trip") // NOLINT
+   {
+      const dynamic_array<particle> particles{{{1.0F, 2.0F, 3.0F}, 1}, {{4.0F, 5.0F, 6.0F}, 2}};
+
+      const auto buffer = serialize(particles);
+      CHECK(static_cast<i64_t>(buffer.size()) == serialized_size(particles));
+      CHECK(buffer.size() % binary_alignment == 0);
+
+      const auto copy = deserialize<dynamic_array<particle>>(bytes_of(buffer));
+      REQUIRE(copy.size() == 2);
+      CHECK(copy.lookup(1).id == 2);
+      CHECK(copy.lookup(1).position[2] == 6.0F);
+   }
+   TEST_CASE("only element types are recorded") // NOLINT
+   {
+      const small_dynamic_array<int, 4> small{1, 2, 3};
+
+      const auto copy = deserialize<dynamic_array<int>>(bytes_of(serialize(small)));
+      CHECK(copy == dynamic_array<int>{1, 2, 3});
+      CHECK(deserialize<dynamic_array<int>>(bytes_of(serialize(dynamic_array<int>{}))).empty());
+   }
+   TEST_CASE("nested arrays round trip") // NOLINT
+   {
+      dynamic_array<dynamic_array<int>> rows;
+      rows.append(dynamic_array<int>{1, 2, 3});
+      rows.append(dynamic_array<int>{});
+      rows.append(dynamic_array<int>{4});
+
+      const auto buffer = serialize(rows);
+      const auto copy = deserialize<dynamic_array<dynamic_array<int>>>(bytes_of(buffer));
+
+      REQUIRE(copy.size() == 3);
+      CHECK(copy.lookup(0) == dynamic_array<int>{1, 2, 3});
+      CHECK(copy.lookup(1).empty());
+      CHECK(copy.lookup(2) == dynamic_array<int>{4});
+   }
+   TEST_CASE("views read the elements in place") // NOLINT
+   {
+      const auto buffer = serialize(dynamic_array<double>{0.5, 1.5, 2.5});
+
+      const auto view = binary_view<double>(bytes_of(buffer));
+      REQUIRE(view.size() == 3);
+      CHECK(static_cast<const void*>(view.data()) ==
+            static_cast<const void*>(buffer.data() + sizeof(binary_header))); // NOLINT
+      CHECK(view[2] == 2.5);
+
+      dynamic_array<dynamic_array<int>> rows;
+      rows.append(dynamic_array<int>{7, 8});
+      rows.append(dynamic_array<int>{9});
+
+      const auto nested_buffer = serialize(rows);
+      const binary_nested_view<int> nested{bytes_of(nested_buffer)};
+      REQUIRE(nested.size() == 2);
+      CHECK(nested.lookup(0).size() == 2);
+      CHECK(nested.lookup(0)[1] == 8);
+      CHECK(nested.lookup(1)[0] == 9);
+   }
+   TEST_CASE("serialize appends to an existing buffer") // NOLINT
+   {
+      dynamic_array<std::byte> buffer;
+      serialize(dynamic_array<int>{1, 2}, buffer);
+      const auto first_size = static_cast<std::size_t>(buffer.size());
+      serialize(dynamic_array<short>{3}, buffer);
+
+      const auto bytes = bytes_of(buffer);
+      CHECK(deserialize<dynamic_array<int>>(bytes) == dynamic_array<int>{1, 2});
+      CHECK(deserialize<dynamic_array<short>>(bytes.subspan(first_size)).lookup(0) == 3);
+   }
+   TEST_CASE("malformed buffers are rejected") // NOLINT
+   {
+      const auto buffer = serialize(dynamic_array<int>{1, 2, 3});
+      const auto bytes = bytes_of(buffer);
+
+      CHECK_THROWS_AS(deserialize<dynamic_array<float>>(bytes), std::system_error);
+      CHECK_THROWS_AS(deserialize<dynamic_array<int>>(bytes.first(sizeof(binary_header) + 4)),
+                      std::system_error);
+      CHECK_THROWS_AS(deserialize<dynamic_array<int>>(bytes.first(8)), std::system_error);
+      CHECK_THROWS_AS(binary_view<int>(bytes.subspan(1)), std::system_error);
+   }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file test_resources.hpp
+ * @brief Contains the memory resources shared by the tests.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#pragma once
+
+#include <libcaramel/memory/global_resource.hpp>
+#include <libcaramel/memory/memory_resource.hpp>
+#include <libcaramel/util/types.hpp>
+
+#include <gsl/pointers>
+
+namespace caramel::test
+{
+   /**
+    * @brief memory_resource forwarding to a global_resource while counting every call.
+    */
+   class counting_resource : public memory_resource
+   {
+   public:
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override
+      {
+         ++allocations;
+         return m_upstream.allocate(bytes, alignment);
+      }
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override
+      {
+         ++deallocations;
+         m_upstream.deallocate(ptr, bytes, alignment);
+      }
+      auto is_equal(const memory_resource& other) const noexcept -> bool override
+      {
+         return this == &other;
+      }
+
+      int allocations = 0;   // NOLINT
+      int deallocations = 0; // NOLINT
+
+   private:
+      global_resource m_upstream;
+   };
+
+   /**
+    * @brief memory_resource forwarding to a global_resource, failing every allocation larger
+    * than a limit that may be changed at any time.
+    */
+   class limited_resource : public memory_resource
+   {
+   public:
+      limited_resource(i64_t new_limit) noexcept : limit{new_limit} {}
+
+      auto allocate(count_t bytes, align_t alignment) noexcept -> pointer override
+      {
+         return bytes.value() > limit ? nullptr : m_upstream.allocate(bytes, alignment);
+      }
+      void deallocate(gsl::not_null<pointer> ptr, count_t bytes,
+                      align_t alignment) noexcept override
+      {
+         m_upstream.deallocate(ptr, bytes, alignment);
+      }
+      auto is_equal(const memory_resource& other) const noexcept -> bool override
+      {
+         return this == &other;
+      }
+
+      i64_t limit; // NOLINT
+
+   private:
+      global_resource m_upstream;
+   };
+} // namespace caramel::test
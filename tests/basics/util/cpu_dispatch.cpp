@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/algorithms/simd.hpp>
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/containers/dynamic_bitset.hpp>
+#include <libcaramel/util/cpu_dispatch.hpp>
+
+using namespace caramel;
+
+namespace
+{
+   auto kernel_scalar() noexcept -> int { return 0; }
+   auto kernel_sse2() noexcept -> int { return 1; }
+   auto kernel_avx2() noexcept -> int { return 3; }
+
+   using test_kernel = auto (*)() noexcept -> int;
+} // namespace
+
+TEST_SUITE("cpu_dispatch test suite") // NOLINT
+{
+   TEST_CASE("level names") // NOLINT
+   {
+      for (std::size_t i = 0; i < isa_level_count; ++i)
+      {
+         const auto level = static_cast<isa_level>(i);
+
+         CHECK(parse_isa_level(to_string(level)) == level);
+      }
+
+      CHECK(to_string(isa_level::sse4_2) == "sse4.2");
+      CHECK_FALSE(parse_isa_level("avx512").has_value());
+   }
+   TEST_CASE("active level never exceeds the detected one") // NOLINT
+   {
+      CHECK(active_isa_level() <= detected_isa_level());
+
+      CHECK(force_isa_level(isa_level::avx2) == detected_isa_level());
+      CHECK(active_isa_level() == detected_isa_level());
+
+      reset_isa_level();
+   }
+   TEST_CASE("the best kernel for the active level is selected") // NOLINT
+   {
+      const dispatched<test_kernel> kernel{{isa_level::scalar, kernel_scalar},
+                                           {isa_level::avx2, kernel_avx2},
+                                           {isa_level::sse2, kernel_sse2}};
+
+      SUBCASE("forced to scalar")
+      {
+         force_isa_level(isa_level::scalar);
+
+         CHECK(kernel.level() == isa_level::scalar);
+         CHECK(kernel() == 0);
+      }
+      SUBCASE("forced to sse4.2 falls back to the sse2 kernel")
+      {
+         if (force_isa_level(isa_level::sse4_2) == isa_level::sse4_2)
+         {
+            CHECK(kernel.level() == isa_level::sse2);
+            CHECK(kernel() == 1);
+         }
+      }
+      SUBCASE("reset selects the default level again")
+      {
+         force_isa_level(isa_level::scalar);
+         reset_isa_level();
+
+         CHECK(kernel.level() <= active_isa_level());
+         if (active_isa_level() == isa_level::avx2)
+         {
+            CHECK(kernel() == 3);
+         }
+      }
+
+      reset_isa_level();
+   }
+   TEST_CASE("destroyed kernels leave the table") // NOLINT
+   {
+      {
+         const dispatched<test_kernel> kernel{{isa_level::scalar, kernel_scalar}};
+
+         CHECK(kernel() == 0);
+      }
+
+      force_isa_level(isa_level::scalar);
+      reset_isa_level();
+   }
+   TEST_CASE("library kernels agree at every level") // NOLINT
+   {
+      dynamic_array<i32_t> values;
+      dynamic_bitset bits{1000};
+      for (i32_t i = 0; i < 1000; ++i)
+      {
+         values.append(i % 7);
+         bits.set(i, i % 3 == 0);
+      }
+
+      dynamic_array<i32_t> other = values;
+      other.lookup(500) = -1;
+
+      for (std::size_t i = 0; i < isa_level_count; ++i)
+      {
+         const auto level = static_cast<isa_level>(i);
+         if (level > detected_isa_level())
+         {
+            break;
+         }
+
+         CAPTURE(to_string(level));
+         force_isa_level(level);
+
+         CHECK(simd::find(values, 6) == 6);
+         CHECK(simd::count(values, 0) == 143);
+         CHECK(simd::compare(values, other) == std::strong_ordering::greater);
+         CHECK(bits.count() == 334);
+      }
+
+      reset_isa_level();
+   }
+}
@@ -0,0 +1,82 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/util/perf_counters.hpp>
+
+using namespace caramel;
+
+TEST_SUITE("perf_counters test suite") // NOLINT
+{
+   TEST_CASE("unavailable events are reported as empty") // NOLINT
+   {
+      perf_counters counters;
+
+      counters.start();
+      const perf_counts counts = counters.stop();
+
+      for (std::size_t i = 0; i < perf_event_count; ++i)
+      {
+         const auto event = static_cast<perf_event>(i);
+
+         CHECK(counts[event].has_value() == counters.is_available(event));
+      }
+   }
+   TEST_CASE("scope records the work done within it") // NOLINT
+   {
+      perf_counters counters;
+      perf_report report;
+
+      dynamic_array<i64_t> values;
+      {
+         perf_counter_scope scope{counters, report, 1000};
+         for (i64_t i = 0; i < 1000; ++i)
+         {
+            values.append(i);
+         }
+      }
+
+      CHECK(report.operations() == 1000);
+      if (counters.is_available(perf_event::instructions))
+      {
+         REQUIRE(report.per_operation(perf_event::instructions).has_value());
+         CHECK(*report.per_operation(perf_event::instructions) > 0.0);
+      }
+      else
+      {
+         CHECK_FALSE(report.per_operation(perf_event::instructions).has_value());
+      }
+   }
+   TEST_CASE("report averages over operations") // NOLINT
+   {
+      perf_report report;
+
+      perf_counts first{};
+      first.values[static_cast<std::size_t>(perf_event::cycles)] = 300;
+      perf_counts second{};
+      second.values[static_cast<std::size_t>(perf_event::cycles)] = 100;
+
+      report.add(first, 3);
+      report.add(second, 1);
+
+      CHECK(report.total(perf_event::cycles) == 400U);
+      CHECK(report.per_operation(perf_event::cycles) == 100.0);
+      CHECK_FALSE(report.total(perf_event::instructions).has_value());
+   }
+   TEST_CASE("an event missing from one region is missing from the report") // NOLINT
+   {
+      perf_report report;
+
+      perf_counts present{};
+      present.values[static_cast<std::size_t>(perf_event::branch_misses)] = 5;
+
+      report.add(present, 1);
+      report.add(perf_counts{}, 1);
+
+      CHECK_FALSE(report.per_operation(perf_event::branch_misses).has_value());
+   }
+   TEST_CASE("event names") // NOLINT
+   {
+      CHECK(to_string(perf_event::cycles) == "cycles");
+      CHECK(to_string(perf_event::llc_misses) == "llc_misses");
+   }
+}
@@ -0,0 +1,58 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/views/chunk_view.hpp>
+
+#include <iterator>
+#include <numeric>
+#include <span>
+
+using namespace caramel;
+
+static_assert(std::random_access_iterator<chunk_iterator<int>>);
+static_assert(std::contiguous_iterator<std::span<int>::iterator>);
+
+TEST_SUITE("chunk_view test suite") // NOLINT
+{
+   TEST_CASE("splits an array into fixed size chunks") // NOLINT
+   {
+      dynamic_array<int> values(10, 1);
+      const std::span<int> elements{values.data(), static_cast<std::size_t>(values.size())};
+
+      const chunk_view chunks{elements, 4};
+      REQUIRE(chunks.size() == 3);
+      CHECK(chunks.lookup(0).size() == 4);
+      CHECK(chunks.lookup(2).size() == 2);
+      CHECK(chunks.lookup(1).data() == values.data() + 4); // NOLINT
+
+      int total = 0;
+      for (const std::span<int> chunk : chunks)
+      {
+         total += std::accumulate(chunk.begin(), chunk.end(), 0);
+      }
+      CHECK(total == 10);
+      CHECK((*chunks.rbegin()).size() == 2);
+   }
+   TEST_CASE("full chunks and remainder cover the array") // NOLINT
+   {
+      dynamic_array<int> values(10, 1);
+      const std::span<int> elements{values.data(), static_cast<std::size_t>(values.size())};
+
+      const chunk_view chunks{elements, 4};
+      CHECK(chunks.full_chunks().size() == 8);
+      CHECK(chunks.remainder().size() == 2);
+      CHECK(chunks.remainder().data() == values.data() + 8); // NOLINT
+
+      const chunk_view exact{elements, 5};
+      CHECK(exact.size() == 2);
+      CHECK(exact.remainder().empty());
+   }
+   TEST_CASE("empty arrays have no chunks") // NOLINT
+   {
+      const chunk_view<int> chunks{std::span<int>{}, 8};
+
+      CHECK(chunks.empty());
+      CHECK(chunks.size() == 0);
+      CHECK(chunks.begin() == chunks.end());
+   }
+}
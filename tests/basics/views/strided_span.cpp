@@ -0,0 +1,55 @@
+#include <doctest/doctest.h>
+
+#include <libcaramel/containers/dynamic_array.hpp>
+#include <libcaramel/views/strided_span.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <span>
+
+using namespace caramel;
+
+static_assert(std::random_access_iterator<strided_iterator<int>>);
+static_assert(std::random_access_iterator<strided_iterator<const int>>);
+
+TEST_SUITE("strided_span test suite") // NOLINT
+{
+   TEST_CASE("walks a column of a row-major matrix") // NOLINT
+   {
+      // 3 rows of 4 columns.
+      dynamic_array<int> matrix{0, 1, 2, 3, 10, 11, 12, 13, 20, 21, 22, 23};
+      const std::span<int> elements{matrix.data(), static_cast<std::size_t>(matrix.size())};
+
+      const strided_span column{elements, 4, 2};
+      REQUIRE(column.size() == 3);
+      CHECK(column.lookup(0) == 2);
+      CHECK(column.lookup(2) == 22);
+      CHECK(std::accumulate(column.begin(), column.end(), 0) == 36);
+
+      std::fill(column.begin(), column.end(), -1);
+      CHECK(matrix.lookup(6) == -1);
+      CHECK(matrix.lookup(7) == 13);
+   }
+   TEST_CASE("iterators are random access") // NOLINT
+   {
+      const dynamic_array<int> values{5, 4, 3, 2, 1, 0};
+      const std::span<const int> elements{values.data(), static_cast<std::size_t>(values.size())};
+
+      const strided_span<const int> even{elements, 2};
+      REQUIRE(even.size() == 3);
+      CHECK(even.end() - even.begin() == 3);
+      CHECK(even.begin()[1] == 3);
+      CHECK(*even.rbegin() == 1);
+      CHECK(std::is_sorted(even.rbegin(), even.rend()));
+   }
+   TEST_CASE("offsets past the last element give an empty view") // NOLINT
+   {
+      dynamic_array<int> values{1, 2, 3};
+      const std::span<int> elements{values.data(), static_cast<std::size_t>(values.size())};
+
+      CHECK(strided_span{elements, 2, 3}.empty());
+      CHECK(strided_span{elements, 5, 2}.size() == 1);
+      CHECK(strided_span<int>{}.empty());
+   }
+}